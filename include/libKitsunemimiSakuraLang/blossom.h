@@ -36,6 +36,9 @@ class SakuraThread;
 class InitialValidator;
 class SakuraLangInterface;
 class ValueItemMap;
+struct ConcurrencyLimit;
+class ResultCache;
+struct CacheTicket;
 
 class Blossom
 {
@@ -53,8 +56,33 @@ protected:
                          const DataMap &context,
                          BlossomStatus &status,
                          ErrorContainer &error) = 0;
+    virtual bool runTaskAsync(BlossomIO &blossomIO,
+                              const DataMap &context,
+                              BlossomStatus &status,
+                              ErrorContainer &error,
+                              BlossomCompletion &completion);
+    virtual bool runTaskBatch(std::vector<BlossomIO> &blossomIOs,
+                              const DataMap &context,
+                              BlossomStatus &status,
+                              ErrorContainer &error);
+    virtual void onWorkerStart();
+    virtual void onWorkerStop();
     bool allowUnmatched = false;
 
+    // maximum number of loop-iterations, which are given together to runTaskBatch, if the loop
+    // contains only this blossom. 0 disables the batch-processing.
+    uint32_t maxBatchSize = 0;
+
+    // the blossom always returns the same output for the same input, has no side-effects and
+    // doesn't read the parent-values. Only the results of pure blossoms are cached and reused by
+    // incremental runs of a tree.
+    bool isPure = false;
+
+    // maximum number of cached results of a pure blossom. 0 uses the default size. The
+    // time-to-live is given in seconds and 0 means unlimited.
+    uint64_t cacheSize = 0;
+    uint32_t cacheTimeToLive = 0;
+
     bool registerInputField(const std::string &name,
                             const FieldType fieldType,
                             const bool required,
@@ -80,10 +108,33 @@ private:
     std::map<std::string, FieldDef> m_inputValidationMap;
     std::map<std::string, FieldDef> m_outputValidationMap;
 
+    // limit of tasks, which can run at the same time, which is shared by all instances of the
+    // blossom and owned by the interface, or nullptr, if unlimited
+    ConcurrencyLimit* m_concurrencyLimit = nullptr;
+
+    // cache for the results, which is shared by all instances of the blossom and owned by the
+    // interface, or nullptr, if the blossom is not pure
+    ResultCache* m_resultCache = nullptr;
+
     bool growBlossom(BlossomIO &blossomIO,
                      const DataMap* context,
                      BlossomStatus &status,
-                     ErrorContainer &error);
+                     ErrorContainer &error,
+                     SakuraThread* worker = nullptr);
+    bool finishBlossom(BlossomIO &blossomIO,
+                       BlossomStatus &status,
+                       ErrorContainer &error,
+                       CacheTicket &ticket,
+                       const bool result);
+    bool waitForTask(BlossomCompletion &completion,
+                     SakuraThread* worker);
+    bool growBlossomBatch(std::vector<BlossomIO> &blossomIOs,
+                          const DataMap* context,
+                          BlossomStatus &status,
+                          ErrorContainer &error,
+                          SakuraThread* worker = nullptr);
+    void acquireSlot(SakuraThread* worker);
+    void releaseSlot();
     bool validateFieldsCompleteness(const DataMap &input,
                                     const std::map<std::string, FieldDef> &validationMap,
                                     const FieldDef::IO_ValueType valueType,
@@ -24,6 +24,7 @@
 #define KITSUNEMIMI_SAKURA_LANG_INTERFACE_H
 
 #include <string>
+#include <vector>
 #include <map>
 #include <mutex>
 #include <unistd.h>
@@ -51,10 +52,14 @@ class Blossom;
 class BlossomGroupItem;
 class BlossomItem;
 class InitialValidator;
+class TreeOptimizer;
 class SakuraParserInterface;
 class SakuraFileCollector;
 struct GrowthPlan;
 struct BlossomStatus;
+struct ConcurrencyLimit;
+class ResultCache;
+class IncrementalRecord;
 
 class SakuraLangInterface
 {
@@ -69,6 +74,13 @@ public:
                      const DataMap &initialValues,
                      BlossomStatus &status,
                      ErrorContainer &error);
+    bool triggerTreeIncremental(DataMap& result,
+                                const std::string &id,
+                                const DataMap &context,
+                                const DataMap &changedValues,
+                                BlossomStatus &status,
+                                ErrorContainer &error,
+                                const std::vector<std::string> &removedKeys = {});
     bool triggerBlossom(DataMap& result,
                         const std::string &blossomName,
                         const std::string &blossomGroupName,
@@ -85,26 +97,55 @@ public:
                           const std::string &itemName);
     bool addBlossom(const std::string &groupName,
                     const std::string &itemName,
-                    Blossom *newBlossom);
+                    Blossom *newBlossom,
+                    const uint32_t maxConcurrency = 0);
+    bool addBlossomFactory(const std::string &groupName,
+                           const std::string &itemName,
+                           BlossomFactory factory,
+                           const uint32_t maxConcurrency = 0);
     Blossom* getBlossom(const std::string &groupName,
                         const std::string &itemName);
+    bool getBlossomCacheStatistics(CacheStatistics &statistics,
+                                   const std::string &groupName,
+                                   const std::string &itemName);
+
+    // value-functions
+    bool addValueFunction(const std::string &name,
+                          ValueFunction function,
+                          const FieldType inputType = SAKURA_UNDEFINED_TYPE,
+                          const std::vector<FieldType> &argumentTypes = {});
     bool getTreeComment(std::string &comment,
                         const std::string &id) const;
     bool getTreeValidMap(std::map<std::string, FieldDef> &validationMap,
                          const std::string &id) const;
+    bool getTreeCacheStatistics(CacheStatistics &statistics,
+                                const std::string &id);
+    bool getIncrementalStatistics(IncrementalStatistics &statistics,
+                                  const std::string &id);
 
 
     // add
     bool addTree(std::string id,
                  const std::string &treeContent,
-                 ErrorContainer &error);
+                 ErrorContainer &error,
+                 const bool replace = false);
     bool addTemplate(const std::string &id,
                      const std::string &templateContent);
     bool addFile(const std::string &id,
                  Kitsunemimi::DataBuffer* data);
     bool addResource(std::string id,
                      const std::string &content,
-                     ErrorContainer &error);
+                     ErrorContainer &error,
+                     const bool replace = false);
+
+    bool specializeTree(const std::string &newId,
+                        const std::string &id,
+                        const DataMap &fixedValues,
+                        ErrorContainer &error);
+
+    // linking
+    bool linkTrees(ErrorContainer &error);
+    void getCallGraph(std::map<std::string, std::vector<std::string>> &callGraph);
 
     // getter
     const std::string getTemplate(const std::string &id);
@@ -126,14 +167,39 @@ private:
     SubtreeQueue* m_queue = nullptr;
     ThreadPool* m_threadPoos = nullptr;
     InitialValidator* m_validator = nullptr;
+    TreeOptimizer* m_optimizer = nullptr;
     SakuraFileCollector* m_fileCollector = nullptr;
     std::mutex m_lock;
+    bool m_deferLinking = false;
 
     std::map<std::string, std::map<std::string, Blossom*>> m_registeredBlossoms;
-
+    std::map<std::string, std::map<std::string, BlossomFactory>> m_blossomFactories;
+    std::mutex m_factoryLock;
+    std::vector<ConcurrencyLimit*> m_concurrencyLimits;
+    std::vector<ResultCache*> m_resultCaches;
+    std::map<std::string, ResultCache*> m_treeCaches;
+    std::map<std::string, ResultCache*> m_subtreeCaches;
+    std::mutex m_subtreeCacheLock;
+    std::map<std::string, IncrementalRecord*> m_incrementalRecords;
+
+    bool runTree(DataMap &result,
+                 const std::string &id,
+                 const DataMap &context,
+                 const DataMap &initialValues,
+                 BlossomStatus &status,
+                 ErrorContainer &error,
+                 IncrementalRecord* record = nullptr);
     bool runProcess(DataMap &result,
                     GrowthPlan* plan,
                     TreeItem* tree);
+    void relink();
+    void setDeferLinking(const bool defer);
+    ResultCache* getTreeCache(const std::string &id);
+    ResultCache* getSubtreeCache(const std::string &id,
+                                 const uint32_t timeToLive);
+    void clearTreeCaches();
+    Blossom* createWorkerBlossom(const std::string &groupName,
+                                 const std::string &itemName);
 
     // output
     void printOutput(const BlossomGroupItem &blossomGroupItem);
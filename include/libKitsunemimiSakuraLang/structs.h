@@ -23,12 +23,18 @@
 #ifndef KITSUNEMIMI_SAKURA_LANG_STRUCTS_H
 #define KITSUNEMIMI_SAKURA_LANG_STRUCTS_H
 
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
 #include <libKitsunemimiJson/json_item.h>
+#include <libKitsunemimiCommon/logger.h>
 
 namespace Kitsunemimi
 {
 namespace Sakura
 {
+class Blossom;
 
 //--------------------------------------------------------------------------------------------------
 
@@ -65,6 +71,105 @@ struct BlossomStatus
 
 //--------------------------------------------------------------------------------------------------
 
+struct CacheStatistics
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    // calls, which waited for the result of an identical call, which was already running
+    uint64_t coalesced = 0;
+
+    // entries, which were removed, because the cache was full
+    uint64_t evictions = 0;
+    uint64_t numberOfEntries = 0;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+struct IncrementalStatistics
+{
+    // blossoms of the last run, which reused the output of the run before
+    uint64_t reusedBlossoms = 0;
+    uint64_t executedBlossoms = 0;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Handle of an asynchronous blossom-task. The blossom has to call finish exactly once,
+ *        when its task is done. Until then, the io-object, status and error of the task stay
+ *        valid and the waiting plan is parked, so its worker-thread processes other plans.
+ */
+struct BlossomCompletion
+{
+    /**
+     * @brief mark the task as finished and continue the waiting plan
+     *
+     * @param success true, if the task was successful, else false
+     */
+    void finish(const bool success)
+    {
+        std::function<void()> onFinish;
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_success = success;
+            m_finished = true;
+            onFinish.swap(m_onFinish);
+            m_cond.notify_all();
+        }
+
+        // the handle can already be deleted, when the parked plan was continued, so only the
+        // local copy of the callback is used here
+        if(onFinish) {
+            onFinish();
+        }
+    }
+
+    /**
+     * @brief block the calling thread until finish was called
+     */
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_cond.wait(lock, [this]() { return m_finished; });
+    }
+
+    /**
+     * @brief check if the task is finished
+     *
+     * @return true, if finish was called, else false
+     */
+    bool isFinished()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_finished;
+    }
+
+    /**
+     * @brief get result of the task
+     *
+     * @return value given to the finish-call
+     */
+    bool wasSuccessful()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_success;
+    }
+
+private:
+    friend Blossom;
+
+    std::mutex m_lock;
+    std::condition_variable m_cond;
+    bool m_finished = false;
+    bool m_success = false;
+
+    // callback to resume the parked plan, which waits for the task
+    std::function<void()> m_onFinish;
+};
+
+//--------------------------------------------------------------------------------------------------
+
 enum FieldType
 {
     SAKURA_UNDEFINED_TYPE = 0,
@@ -109,6 +214,36 @@ struct FieldDef
 
 //--------------------------------------------------------------------------------------------------
 
+/**
+ * native function, which can be called on a value within a sakura-file, like value.name(arg).
+ * The function gets the value and the already filled arguments and returns a new data-item
+ * with the result or nullptr, if it failed. The value is owned by the caller and not used
+ * anywhere else, so the function is allowed to modify it and return it again.
+ */
+typedef DataItem* (*ValueFunction)(DataItem* item,
+                                   const std::vector<DataItem*> &arguments,
+                                   ErrorContainer &error);
+
+struct ValueFunctionDef
+{
+    ValueFunction function = nullptr;
+
+    // expected types of the value and the arguments. SAKURA_UNDEFINED_TYPE accepts all types.
+    FieldType inputType = SAKURA_UNDEFINED_TYPE;
+    std::vector<FieldType> argumentTypes;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/**
+ * function to create a new blossom-instance. If a blossom is registered with a factory, each
+ * worker-thread creates its own instance with it, so the instance is never called by multiple
+ * threads at the same time.
+ */
+typedef std::function<Blossom*()> BlossomFactory;
+
+//--------------------------------------------------------------------------------------------------
+
 } // namespace Sakura
 } // namespace Kitsunemimi
 
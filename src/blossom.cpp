@@ -23,6 +23,9 @@
 #include <libKitsunemimiSakuraLang/blossom.h>
 
 #include <items/item_methods.h>
+#include <processing/sakura_thread.h>
+#include <processing/concurrency_limit.h>
+#include <processing/result_cache.h>
 #include <libKitsunemimiCommon/logger.h>
 #include <runtime_validation.h>
 
@@ -261,12 +264,16 @@ Blossom::fillDefaultValues(DataMap &values)
 }
 
 /**
- * @brief execute blossom
+ * @brief execute blossom. This is the start-phase, which starts the task of the blossom. The
+ *        plan of a worker-thread is parked until the task is finished, so the worker-thread
+ *        processes other plans in the meantime, and then continues with the finish-phase.
  *
  * @param blossomIO leaf-object for values-handling while processing
  * @param context const-map with global accasible values
  * @param status reference for status-output
  * @param error reference for error-output
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr to block
+ *               the calling thread
  *
  * @return true, if successful, else false
  */
@@ -274,7 +281,8 @@ bool
 Blossom::growBlossom(BlossomIO &blossomIO,
                      const DataMap* context,
                      BlossomStatus &status,
-                     ErrorContainer &error)
+                     ErrorContainer &error,
+                     SakuraThread* worker)
 {
     LOG_DEBUG("runTask " + blossomIO.blossomName);
 
@@ -294,25 +302,283 @@ Blossom::growBlossom(BlossomIO &blossomIO,
         return false;
     }
 
+    // use the result of a previous call with the same input, if the blossom is pure
+    CacheTicket ticket;
+    if(m_resultCache != nullptr)
+    {
+        ticket.input = blossomIO.input.getItemContent()->copy()->toMap();
+        if(m_resultCache->get(*blossomIO.output.getItemContent()->toMap(), ticket, worker)) {
+            return true;
+        }
+    }
+
+    acquireSlot(worker);
+
+    // start task and wait until it is finished
+    BlossomCompletion completion;
+    bool result = runTaskAsync(blossomIO, *context, status, error, completion);
+    if(result) {
+        result = waitForTask(completion, worker);
+    }
+
+    releaseSlot();
+
+    return finishBlossom(blossomIO, status, error, ticket, result);
+}
+
+/**
+ * @brief finish-phase of the execution of a blossom, after its task is done
+ *
+ * @param blossomIO leaf-object for values-handling while processing
+ * @param status reference for status-output
+ * @param error reference for error-output
+ * @param ticket ticket of the call for the cache, if the blossom is pure
+ * @param result result of the task
+ *
+ * @return true, if successful, else false
+ */
+bool
+Blossom::finishBlossom(BlossomIO &blossomIO,
+                       BlossomStatus &status,
+                       ErrorContainer &error,
+                       CacheTicket &ticket,
+                       const bool result)
+{
     // handle result
-    if(runTask(blossomIO, *context, status, error) == false)
+    if(result == false)
     {
+        if(m_resultCache != nullptr) {
+            m_resultCache->set(ticket, nullptr);
+        }
         createError(blossomIO, "blossom execute", error);
         return false;
     }
 
     // validate output
+    std::string errorMessage;
     if(checkBlossomValues(m_outputValidationMap,
                           *blossomIO.output.getItemContent()->toMap(),
                           FieldDef::OUTPUT_TYPE,
                           errorMessage) == false)
     {
+        if(m_resultCache != nullptr) {
+            m_resultCache->set(ticket, nullptr);
+        }
         error.addMeesage(errorMessage);
         status.errorMessage = errorMessage;
         status.statusCode = 500;
         return false;
     }
 
+    // store result for further calls with the same input
+    if(m_resultCache != nullptr) {
+        m_resultCache->set(ticket, blossomIO.output.getItemContent()->copy()->toMap());
+    }
+
+    return true;
+}
+
+/**
+ * @brief wait until the task of the blossom is finished. The plan of a worker-thread is parked
+ *        and continued by the finish-call of the completion-handle.
+ *
+ * @param completion completion-handle of the task
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr to block
+ *               the calling thread
+ *
+ * @return result of the task
+ */
+bool
+Blossom::waitForTask(BlossomCompletion &completion,
+                     SakuraThread* worker)
+{
+    PlanContext* planContext = nullptr;
+    if(worker != nullptr) {
+        planContext = worker->getCurrentPlan();
+    }
+
+    std::unique_lock<std::mutex> lock(completion.m_lock);
+    while(completion.m_finished == false)
+    {
+        if(planContext == nullptr)
+        {
+            completion.m_cond.wait(lock);
+            continue;
+        }
+
+        completion.m_onFinish = [worker, planContext]() { worker->resume(planContext); };
+        worker->park(lock);
+    }
+
+    return completion.m_success;
+}
+
+/**
+ * @brief start the task of the blossom. Blossoms, which wait for io, can override this to
+ *        start their work in the background and return directly. The default-implementation
+ *        runs the synchronous task and finishs the completion-handle directly.
+ *
+ * @param blossomIO leaf-object for values-handling while processing
+ * @param context const-map with global accasible values
+ * @param status reference for status-output
+ * @param error reference for error-output
+ * @param completion handle, which has to be finished, when the task is done
+ *
+ * @return false, if the task could not be started, else true
+ */
+bool
+Blossom::runTaskAsync(BlossomIO &blossomIO,
+                      const DataMap &context,
+                      BlossomStatus &status,
+                      ErrorContainer &error,
+                      BlossomCompletion &completion)
+{
+    completion.finish(runTask(blossomIO, context, status, error));
+    return true;
+}
+
+/**
+ * @brief called by the worker-thread, which owns this instance, before the first task, if the
+ *        blossom was registered by a factory. Blossoms can override this to create their
+ *        per-worker state, like connections or buffers.
+ */
+void
+Blossom::onWorkerStart()
+{
+}
+
+/**
+ * @brief called by the worker-thread, which owns this instance, before the thread stops, if the
+ *        blossom was registered by a factory
+ */
+void
+Blossom::onWorkerStop()
+{
+}
+
+/**
+ * @brief execute multiple calls of the blossom together
+ *
+ * @param blossomIOs leaf-objects for values-handling of each call
+ * @param context const-map with global accasible values
+ * @param status reference for status-output
+ * @param error reference for error-output
+ * @param worker worker-thread, which parks the current plan while waiting for a free slot, or
+ *               nullptr to block the calling thread
+ *
+ * @return true, if successful, else false
+ */
+bool
+Blossom::growBlossomBatch(std::vector<BlossomIO> &blossomIOs,
+                          const DataMap* context,
+                          BlossomStatus &status,
+                          ErrorContainer &error,
+                          SakuraThread* worker)
+{
+    if(blossomIOs.size() == 0) {
+        return true;
+    }
+
+    LOG_DEBUG("runTaskBatch " + blossomIOs.front().blossomName);
+
+    std::string errorMessage;
+
+    // set default-values and validate input
+    for(BlossomIO &blossomIO : blossomIOs)
+    {
+        fillDefaultValues(*blossomIO.input.getItemContent()->toMap());
+        if(checkBlossomValues(m_inputValidationMap,
+                              *blossomIO.input.getItemContent()->toMap(),
+                              FieldDef::INPUT_TYPE,
+                              errorMessage) == false)
+        {
+            error.addMeesage(errorMessage);
+            status.errorMessage = errorMessage;
+            status.statusCode = 400;
+            return false;
+        }
+    }
+
+    // a batch uses only one slot of a limited blossom
+    acquireSlot(worker);
+    const bool result = runTaskBatch(blossomIOs, *context, status, error);
+    releaseSlot();
+
+    // handle result
+    if(result == false)
+    {
+        createError(blossomIOs.front(), "blossom execute", error);
+        return false;
+    }
+
+    // validate output
+    for(BlossomIO &blossomIO : blossomIOs)
+    {
+        if(checkBlossomValues(m_outputValidationMap,
+                              *blossomIO.output.getItemContent()->toMap(),
+                              FieldDef::OUTPUT_TYPE,
+                              errorMessage) == false)
+        {
+            error.addMeesage(errorMessage);
+            status.errorMessage = errorMessage;
+            status.statusCode = 500;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief wait for a free slot, if the number of concurrent tasks of the blossom is limited
+ *
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr to block
+ *               the calling thread
+ */
+void
+Blossom::acquireSlot(SakuraThread* worker)
+{
+    if(m_concurrencyLimit != nullptr) {
+        m_concurrencyLimit->acquire(worker);
+    }
+}
+
+/**
+ * @brief give back the slot, which was taken by acquireSlot
+ */
+void
+Blossom::releaseSlot()
+{
+    if(m_concurrencyLimit != nullptr) {
+        m_concurrencyLimit->release();
+    }
+}
+
+/**
+ * @brief execute multiple calls of the blossom together. This default-implementation runs the
+ *        calls one after another and should be overridden by blossoms, which can share the
+ *        setup of their task between multiple calls, like a connection or a prepared statement.
+ *
+ * @param blossomIOs leaf-objects for values-handling of each call
+ * @param context const-map with global accasible values
+ * @param status reference for status-output
+ * @param error reference for error-output
+ *
+ * @return true, if successful, else false
+ */
+bool
+Blossom::runTaskBatch(std::vector<BlossomIO> &blossomIOs,
+                      const DataMap &context,
+                      BlossomStatus &status,
+                      ErrorContainer &error)
+{
+    for(BlossomIO &blossomIO : blossomIOs)
+    {
+        if(runTask(blossomIO, context, status, error) == false) {
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -0,0 +1,544 @@
+/**
+ * @file        expression_methods.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "expression_methods.h"
+
+#include <items/item_methods.h>
+
+#include <climits>
+#include <cstring>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief convert the result of a three-way-comparison into the result of a compare-expression
+ *
+ * @param compareResult negative, if left is smaller, 0 if equal and positive if left is greater
+ * @param type type of the compare-expression
+ *
+ * @return result of the compare-expression
+ */
+bool
+applyCompareType(const int compareResult,
+                 const ExpressionItem::ExpressionType type)
+{
+    switch(type)
+    {
+        case ExpressionItem::EQUAL_EXPRESSION:
+            return compareResult == 0;
+        case ExpressionItem::UNEQUAL_EXPRESSION:
+            return compareResult != 0;
+        case ExpressionItem::GREATER_EXPRESSION:
+            return compareResult > 0;
+        case ExpressionItem::GREATER_EQUAL_EXPRESSION:
+            return compareResult >= 0;
+        case ExpressionItem::SMALLER_EXPRESSION:
+            return compareResult < 0;
+        case ExpressionItem::SMALLER_EQUAL_EXPRESSION:
+            return compareResult <= 0;
+        default:
+            break;
+    }
+
+    return false;
+}
+
+/**
+ * @brief compare two data-items based on their types. Numbers, bools and strings are compared
+ *        directly, without converting them into strings. All other combinations can only be
+ *        checked for equality by comparing their string-representation.
+ *
+ * @param result reference for the result of the comparison
+ * @param left left side of the comparison
+ * @param right right side of the comparison
+ * @param type type of the compare-expression
+ * @param error reference for error-output
+ *
+ * @return false, if the values can not be compared with the given operator, else true
+ */
+bool
+compareValues(bool &result,
+              DataItem* left,
+              DataItem* right,
+              const ExpressionItem::ExpressionType type,
+              ErrorContainer &error)
+{
+    if(left->isValue()
+            && right->isValue())
+    {
+        DataValue* leftValue = left->toValue();
+        DataValue* rightValue = right->toValue();
+        const DataItem::dataValueTypes leftType = leftValue->getValueType();
+        const DataItem::dataValueTypes rightType = rightValue->getValueType();
+        const bool leftIsNumber = leftType == DataItem::INT_TYPE
+                                  || leftType == DataItem::FLOAT_TYPE;
+        const bool rightIsNumber = rightType == DataItem::INT_TYPE
+                                   || rightType == DataItem::FLOAT_TYPE;
+
+        // compare int-values
+        if(leftType == DataItem::INT_TYPE
+                && rightType == DataItem::INT_TYPE)
+        {
+            const long leftNumber = leftValue->getLong();
+            const long rightNumber = rightValue->getLong();
+            result = applyCompareType((leftNumber > rightNumber) - (leftNumber < rightNumber),
+                                      type);
+            return true;
+        }
+
+        // compare numbers, where at least one is a float-value
+        if(leftIsNumber
+                && rightIsNumber)
+        {
+            double leftNumber = 0.0;
+            double rightNumber = 0.0;
+            if(leftType == DataItem::INT_TYPE) {
+                leftNumber = static_cast<double>(leftValue->getLong());
+            } else {
+                leftNumber = leftValue->getDouble();
+            }
+            if(rightType == DataItem::INT_TYPE) {
+                rightNumber = static_cast<double>(rightValue->getLong());
+            } else {
+                rightNumber = rightValue->getDouble();
+            }
+
+            result = applyCompareType((leftNumber > rightNumber) - (leftNumber < rightNumber),
+                                      type);
+            return true;
+        }
+
+        // compare bool-values
+        if(leftType == DataItem::BOOL_TYPE
+                && rightType == DataItem::BOOL_TYPE)
+        {
+            const int leftBool = leftValue->getBool();
+            const int rightBool = rightValue->getBool();
+            result = applyCompareType(leftBool - rightBool, type);
+            return true;
+        }
+
+        // compare string-values without copy
+        if(leftType == DataItem::STRING_TYPE
+                && rightType == DataItem::STRING_TYPE)
+        {
+            const int compareResult = std::strcmp(leftValue->content.stringValue,
+                                                  rightValue->content.stringValue);
+            result = applyCompareType((compareResult > 0) - (compareResult < 0), type);
+            return true;
+        }
+    }
+
+    // all other combinations can only be checked for equality
+    if(type == ExpressionItem::EQUAL_EXPRESSION
+            || type == ExpressionItem::UNEQUAL_EXPRESSION)
+    {
+        const int compareResult = left->toString() == right->toString() ? 0 : 1;
+        result = applyCompareType(compareResult, type);
+        return true;
+    }
+
+    error.addMeesage("values can not be compared, because of incompatible types: '"
+                     + left->toString()
+                     + "' and '"
+                     + right->toString()
+                     + "'");
+    return false;
+}
+
+/**
+ * @brief calculate the result of an arithmetic expression. Int-values stay int-values, if both
+ *        operands are int-values, else the calculation is done with float-values. The addition
+ *        of a string with any other value results in the concatenation of both values.
+ *
+ * @param left left operand
+ * @param right right operand
+ * @param type type of the arithmetic expression
+ * @param error reference for error-output
+ *
+ * @return new data-item with the result, or nullptr, if the calculation failed
+ */
+DataItem*
+calculateValues(DataItem* left,
+                DataItem* right,
+                const ExpressionItem::ExpressionType type,
+                ErrorContainer &error)
+{
+    // concatenate strings
+    if(type == ExpressionItem::ADD_EXPRESSION
+            && (left->isStringValue() || right->isStringValue()))
+    {
+        return new DataValue(left->toString() + right->toString());
+    }
+
+    const bool leftIsNumber = left->isIntValue() || left->isFloatValue();
+    const bool rightIsNumber = right->isIntValue() || right->isFloatValue();
+    if(leftIsNumber == false
+            || rightIsNumber == false)
+    {
+        error.addMeesage("arithmetic expression is only allowed with numbers, but got: '"
+                         + left->toString()
+                         + "' and '"
+                         + right->toString()
+                         + "'");
+        return nullptr;
+    }
+
+    // calculate with int-values
+    if(left->isIntValue()
+            && right->isIntValue())
+    {
+        const long leftNumber = left->toValue()->getLong();
+        const long rightNumber = right->toValue()->getLong();
+        long resultNumber = 0;
+        bool overflow = false;
+
+        switch(type)
+        {
+            case ExpressionItem::ADD_EXPRESSION:
+                overflow = __builtin_add_overflow(leftNumber, rightNumber, &resultNumber);
+                break;
+            case ExpressionItem::SUBTRACT_EXPRESSION:
+                overflow = __builtin_sub_overflow(leftNumber, rightNumber, &resultNumber);
+                break;
+            case ExpressionItem::MULTIPLY_EXPRESSION:
+                overflow = __builtin_mul_overflow(leftNumber, rightNumber, &resultNumber);
+                break;
+            case ExpressionItem::DIVIDE_EXPRESSION:
+            case ExpressionItem::MODULO_EXPRESSION:
+            {
+                if(rightNumber == 0)
+                {
+                    error.addMeesage("division by zero");
+                    return nullptr;
+                }
+
+                // the result of the smallest number divided by -1 is not representable and the
+                // cpu raises an exception for this case, also for the modulo
+                if(leftNumber == LONG_MIN
+                        && rightNumber == -1)
+                {
+                    overflow = type == ExpressionItem::DIVIDE_EXPRESSION;
+                    break;
+                }
+
+                if(type == ExpressionItem::DIVIDE_EXPRESSION) {
+                    resultNumber = leftNumber / rightNumber;
+                } else {
+                    resultNumber = leftNumber % rightNumber;
+                }
+                break;
+            }
+            default:
+                return nullptr;
+        }
+
+        if(overflow)
+        {
+            error.addMeesage("integer overflow");
+            return nullptr;
+        }
+
+        return new DataValue(resultNumber);
+    }
+
+    // calculate with float-values
+    if(type == ExpressionItem::MODULO_EXPRESSION)
+    {
+        error.addMeesage("modulo is only allowed with int-values");
+        return nullptr;
+    }
+
+    double leftNumber = 0.0;
+    double rightNumber = 0.0;
+    if(left->isIntValue()) {
+        leftNumber = static_cast<double>(left->toValue()->getLong());
+    } else {
+        leftNumber = left->toValue()->getDouble();
+    }
+    if(right->isIntValue()) {
+        rightNumber = static_cast<double>(right->toValue()->getLong());
+    } else {
+        rightNumber = right->toValue()->getDouble();
+    }
+
+    switch(type)
+    {
+        case ExpressionItem::ADD_EXPRESSION:
+            return new DataValue(leftNumber + rightNumber);
+        case ExpressionItem::SUBTRACT_EXPRESSION:
+            return new DataValue(leftNumber - rightNumber);
+        case ExpressionItem::MULTIPLY_EXPRESSION:
+            return new DataValue(leftNumber * rightNumber);
+        case ExpressionItem::DIVIDE_EXPRESSION:
+        {
+            if(rightNumber == 0.0)
+            {
+                error.addMeesage("division by zero");
+                return nullptr;
+            }
+            return new DataValue(leftNumber / rightNumber);
+        }
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief store the result of an expression within the expression itself
+ *
+ * @param expression expression, which should hold the result
+ * @param result new result of the expression
+ *
+ * @return pointer to the result
+ */
+DataItem*
+setResult(ExpressionItem &expression,
+          DataItem* result)
+{
+    if(expression.value.item != nullptr) {
+        delete expression.value.item;
+    }
+    expression.value.item = result;
+
+    return result;
+}
+
+/**
+ * @brief evaluate an expression natively, without converting the values into strings. The
+ *        operands of and- and or-expressions are only evaluated, if they are necessary for the
+ *        result.
+ *
+ * @param expression expression to evaluate
+ * @param insertValues data-map with the values to fill the value-items of the expression
+ * @param error reference for error-output
+ *
+ * @return result of the expression, which is owned by the expression, or nullptr if the
+ *         evaluation failed
+ */
+DataItem*
+evaluateExpression(ExpressionItem &expression,
+                   DataMap &insertValues,
+                   ErrorContainer &error)
+{
+    switch(expression.type)
+    {
+        //------------------------------------------------------------------------------------------
+        case ExpressionItem::VALUE_EXPRESSION:
+        {
+            if(fillValueItem(expression.value, insertValues, error) == false) {
+                return nullptr;
+            }
+            return expression.value.item;
+        }
+        //------------------------------------------------------------------------------------------
+        case ExpressionItem::AND_EXPRESSION:
+        case ExpressionItem::OR_EXPRESSION:
+        {
+            bool result = false;
+            if(evaluateCondition(result, *expression.left, insertValues, error) == false) {
+                return nullptr;
+            }
+
+            // skip right side, if the result is already known
+            const bool isOr = expression.type == ExpressionItem::OR_EXPRESSION;
+            if(result != isOr
+                    && evaluateCondition(result, *expression.right, insertValues, error) == false)
+            {
+                return nullptr;
+            }
+
+            return setResult(expression, new DataValue(result));
+        }
+        //------------------------------------------------------------------------------------------
+        case ExpressionItem::NOT_EXPRESSION:
+        {
+            bool result = false;
+            if(evaluateCondition(result, *expression.left, insertValues, error) == false) {
+                return nullptr;
+            }
+            return setResult(expression, new DataValue(result == false));
+        }
+        //------------------------------------------------------------------------------------------
+        case ExpressionItem::ADD_EXPRESSION:
+        case ExpressionItem::SUBTRACT_EXPRESSION:
+        case ExpressionItem::MULTIPLY_EXPRESSION:
+        case ExpressionItem::DIVIDE_EXPRESSION:
+        case ExpressionItem::MODULO_EXPRESSION:
+        {
+            DataItem* left = evaluateExpression(*expression.left, insertValues, error);
+            if(left == nullptr) {
+                return nullptr;
+            }
+            DataItem* right = evaluateExpression(*expression.right, insertValues, error);
+            if(right == nullptr) {
+                return nullptr;
+            }
+
+            DataItem* result = calculateValues(left, right, expression.type, error);
+            if(result == nullptr) {
+                return nullptr;
+            }
+            return setResult(expression, result);
+        }
+        //------------------------------------------------------------------------------------------
+        default:
+        {
+            // compare-expressions
+            DataItem* left = evaluateExpression(*expression.left, insertValues, error);
+            if(left == nullptr) {
+                return nullptr;
+            }
+            DataItem* right = evaluateExpression(*expression.right, insertValues, error);
+            if(right == nullptr) {
+                return nullptr;
+            }
+
+            bool result = false;
+            if(compareValues(result, left, right, expression.type, error) == false) {
+                return nullptr;
+            }
+            return setResult(expression, new DataValue(result));
+        }
+        //------------------------------------------------------------------------------------------
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief reset the values of a copy of a lambda, which were replaced by the previous evaluation.
+ *        The results of the other expressions are overwritten by the next evaluation anyway.
+ *
+ * @param expression copy of the lambda, which should be reset
+ * @param lambda original lambda
+ */
+void
+resetLambda(ExpressionItem &expression,
+            const ExpressionItem &lambda)
+{
+    if(expression.type == ExpressionItem::VALUE_EXPRESSION)
+    {
+        if(lambda.value.isConstant == false) {
+            expression.value = lambda.value;
+        }
+        return;
+    }
+
+    if(expression.left != nullptr) {
+        resetLambda(*expression.left, *lambda.left);
+    }
+    if(expression.right != nullptr) {
+        resetLambda(*expression.right, *lambda.right);
+    }
+}
+
+/**
+ * @brief evaluate a lambda with the given values for its parameters. The parameters are only
+ *        bound for the evaluation and hide values with the same name.
+ *
+ * @param expression copy of the lambda, which is used for all evaluations of the lambda within
+ *                   one function-call, because the values of an expression are replaced while
+ *                   evaluating
+ * @param lambda expression with the names of its parameters
+ * @param parameters values for the parameters, which are not copied
+ * @param insertValues data-map with all other values, which can be used within the lambda
+ * @param error reference for error-output
+ *
+ * @return new data-item with the result, or nullptr if the evaluation failed
+ */
+DataItem*
+evaluateLambda(ExpressionItem &expression,
+               const ExpressionItem &lambda,
+               const std::vector<DataItem*> &parameters,
+               DataMap &insertValues,
+               ErrorContainer &error)
+{
+    // bind parameters
+    std::vector<DataItem*> hiddenValues;
+    hiddenValues.reserve(parameters.size());
+    for(uint64_t i = 0; i < parameters.size(); i++)
+    {
+        DataItem* &entry = insertValues.map[lambda.parameters.at(i)];
+        hiddenValues.push_back(entry);
+        entry = parameters.at(i);
+    }
+
+    // the result is moved out of the expression, so it is not deleted by the reset
+    DataItem* result = evaluateExpression(expression, insertValues, error);
+    if(result != nullptr) {
+        expression.value.item = nullptr;
+    }
+    resetLambda(expression, lambda);
+
+    // unbind parameters in reverse order to restore the hidden values
+    for(uint64_t i = parameters.size(); i > 0; i--)
+    {
+        const std::string &name = lambda.parameters.at(i - 1);
+        if(hiddenValues.at(i - 1) == nullptr) {
+            insertValues.map.erase(name);
+        } else {
+            insertValues.map[name] = hiddenValues.at(i - 1);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief evaluate an expression, which has to result in a bool-value
+ *
+ * @param result reference for the result of the condition
+ * @param expression condition to evaluate
+ * @param insertValues data-map with the values to fill the value-items of the condition
+ * @param error reference for error-output
+ *
+ * @return false, if the evaluation failed, else true
+ */
+bool
+evaluateCondition(bool &result,
+                  ExpressionItem &expression,
+                  DataMap &insertValues,
+                  ErrorContainer &error)
+{
+    DataItem* value = evaluateExpression(expression, insertValues, error);
+    if(value == nullptr) {
+        return false;
+    }
+
+    if(value->isBoolValue() == false)
+    {
+        error.addMeesage("condition is not a bool-value: " + value->toString());
+        return false;
+    }
+
+    result = value->toValue()->getBool();
+    return true;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
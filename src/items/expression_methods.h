@@ -0,0 +1,62 @@
+/**
+ * @file        expression_methods.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_EXPRESSION_METHODS_H
+#define KITSUNEMIMI_SAKURA_LANG_EXPRESSION_METHODS_H
+
+#include <libKitsunemimiCommon/items/data_items.h>
+#include <libKitsunemimiCommon/logger.h>
+
+#include <items/value_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+DataItem* evaluateExpression(ExpressionItem &expression,
+                             DataMap &insertValues,
+                             ErrorContainer &error);
+DataItem* evaluateLambda(ExpressionItem &expression,
+                         const ExpressionItem &lambda,
+                         const std::vector<DataItem*> &parameters,
+                         DataMap &insertValues,
+                         ErrorContainer &error);
+bool evaluateCondition(bool &result,
+                       ExpressionItem &expression,
+                       DataMap &insertValues,
+                       ErrorContainer &error);
+
+bool compareValues(bool &result,
+                   DataItem* left,
+                   DataItem* right,
+                   const ExpressionItem::ExpressionType type,
+                   ErrorContainer &error);
+DataItem* calculateValues(DataItem* left,
+                          DataItem* right,
+                          const ExpressionItem::ExpressionType type,
+                          ErrorContainer &error);
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_EXPRESSION_METHODS_H
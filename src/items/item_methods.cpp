@@ -22,13 +22,20 @@
 
 #include "item_methods.h"
 
+#include <items/expression_methods.h>
+#include <items/json_reader.h>
+#include <items/template_cache.h>
+#include <items/value_function_registry.h>
 #include <items/value_item_functions.h>
+#include <runtime_validation.h>
 #include <libKitsunemimiSakuraLang/blossom.h>
 
 #include <libKitsunemimiJinja2/jinja2_converter.h>
 #include <libKitsunemimiCommon/items/data_items.h>
 #include <libKitsunemimiCommon/items/table_item.h>
 
+#include <cstring>
+
 namespace Kitsunemimi
 {
 namespace Sakura
@@ -51,143 +58,108 @@ getProcessedItem(ValueItem &valueItem,
                  DataMap &insertValues,
                  ErrorContainer &error)
 {
-    for(const Kitsunemimi::Sakura::FunctionItem& functionItem : valueItem.functions)
+    for(uint64_t functionPos = 0; functionPos < valueItem.functions.size(); functionPos++)
     {
+        FunctionItem &functionItem = valueItem.functions[functionPos];
         if(valueItem.item == nullptr) {
             return false;
         }
-        DataItem* tempItem = nullptr;
-        const std::string type = functionItem.type;
 
-        //------------------------------------------------------------------------------------------
-        if(type == "get")
+        // json-strings, which are only read by get-calls, are parsed only as far as necessary
+        if(functionItem.specialType == FunctionItem::PARSE_JSON_TYPE
+                && functionPos + 1 < valueItem.functions.size()
+                && valueItem.functions[functionPos + 1].specialType == FunctionItem::GET_TYPE)
         {
-            if(functionItem.arguments.size() != 1)
-            {
-                error.addMeesage(type + "-function requires 1 argument");
+            if(processJsonPath(valueItem, functionPos, insertValues, error) == false) {
                 return false;
             }
-
-            ValueItem arg = functionItem.arguments.at(0);
-            if(fillValueItem(arg, insertValues, error) == false) {
-                return false;
-            }
-
-            tempItem = getValue(valueItem.item,
-                                arg.item->toValue(),
-                                error);
+            continue;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "split")
-        {
-            if(functionItem.arguments.size() != 1)
-            {
-                error.addMeesage(type + "-function requires 1 argument");
-                return false;
-            }
-
-            ValueItem arg = functionItem.arguments.at(0);
-            if(fillValueItem(arg, insertValues, error) == false) {
-                return false;
-            }
 
-            tempItem = splitValue(valueItem.item->toValue(),
-                                  arg.item->toValue(),
-                                  error);
+        // function-calls are resolved while loading the tree
+        if(functionItem.definition == nullptr
+                && functionItem.lambdaDefinition == nullptr)
+        {
+            error.addMeesage(functionItem.type + "-function was not resolved "
+                             "while loading the tree");
+            return false;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "contains")
+        const ValueFunctionDef* definition = functionItem.definition;
+        const LambdaFunctionDef* lambdaDefinition = functionItem.lambdaDefinition;
+
+        // the lambda of a lambda-function is evaluated by the function itself
+        uint64_t firstArgument = 0;
+        FieldType inputType = SAKURA_UNDEFINED_TYPE;
+        const std::vector<FieldType>* argumentTypes = nullptr;
+        if(lambdaDefinition != nullptr)
         {
-            if(functionItem.arguments.size() != 1)
-            {
-                error.addMeesage(type + "-function requires 1 argument");
-                return false;
-            }
-
-            ValueItem arg = functionItem.arguments.at(0);
-            if(fillValueItem(arg, insertValues, error) == false) {
-                return false;
-            }
-
-            tempItem = containsValue(valueItem.item,
-                                     arg.item->toValue(),
-                                     error);
+            firstArgument = 1;
+            inputType = lambdaDefinition->inputType;
+            argumentTypes = &lambdaDefinition->argumentTypes;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "size")
+        else
         {
-            if(functionItem.arguments.size() != 0)
-            {
-                error.addMeesage(type + "-function requires 0 arguments");
-                return false;
-            }
+            inputType = definition->inputType;
+            argumentTypes = &definition->argumentTypes;
+        }
 
-            tempItem = sizeValue(valueItem.item, error);
+        // check type of the value
+        if(inputType != SAKURA_UNDEFINED_TYPE
+                && checkType(valueItem.item, inputType) == false)
+        {
+            error.addMeesage(functionItem.type + "-function is called on a value "
+                             "with invalid type");
+            return false;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "insert")
+
+        // fill arguments, where constant arguments can be used without a copy
+        std::vector<ValueItem> filledArguments;
+        filledArguments.reserve(functionItem.arguments.size());
+        std::vector<DataItem*> arguments;
+        arguments.reserve(functionItem.arguments.size());
+        for(uint64_t i = firstArgument; i < functionItem.arguments.size(); i++)
         {
-            if(functionItem.arguments.size() != 2)
+            ValueItem &argument = functionItem.arguments[i];
+            DataItem* argumentItem = argument.item;
+            if(argument.isConstant == false)
             {
-                error.addMeesage(type + "-function requires 2 arguments");
-                return false;
+                filledArguments.push_back(argument);
+                if(fillValueItem(filledArguments.back(), insertValues, error) == false) {
+                    return false;
+                }
+                argumentItem = filledArguments.back().item;
             }
 
-            ValueItem arg1 = functionItem.arguments.at(0);
-            ValueItem arg2 = functionItem.arguments.at(1);
-
-            if(fillValueItem(arg1, insertValues, error) == false
-                    || fillValueItem(arg2, insertValues, error) == false)
+            const FieldType argumentType = argumentTypes->at(i - firstArgument);
+            if(argumentType != SAKURA_UNDEFINED_TYPE
+                    && checkType(argumentItem, argumentType) == false)
             {
+                error.addMeesage("argument " + std::to_string(i) + " of the "
+                                 + functionItem.type + "-function has an invalid type");
                 return false;
             }
 
-            tempItem = insertValue(valueItem.item->toMap(),
-                                   arg1.item->toValue(),
-                                   arg2.item,
-                                   error);
+            arguments.push_back(argumentItem);
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "append")
-        {
-            if(functionItem.arguments.size() != 1)
-            {
-                error.addMeesage(type + "-function requires 1 argument");
-                return false;
-            }
 
-            ValueItem arg = functionItem.arguments.at(0);
-            if(fillValueItem(arg, insertValues, error) == false) {
-                return false;
-            }
-
-            tempItem = appendValue(valueItem.item->toArray(),
-                                   arg.item,
-                                   error);
-        }
-        //------------------------------------------------------------------------------------------
-        if(type == "clear_empty")
+        // the value is owned by the value-item, so functions are allowed to modify it in-place
+        // and return it again instead of creating a new item
+        DataItem* tempItem = nullptr;
+        if(lambdaDefinition != nullptr)
         {
-            if(functionItem.arguments.size() != 0)
-            {
-                error.addMeesage(type + "-function requires 0 arguments");
-                return false;
-            }
-
-            tempItem = clearEmpty(valueItem.item->toArray(),  error);
+            tempItem = lambdaDefinition->function(valueItem.item,
+                                                  *functionItem.arguments.front().expression,
+                                                  arguments,
+                                                  insertValues,
+                                                  error);
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "parse_json")
+        else
         {
-            if(functionItem.arguments.size() != 0)
-            {
-                error.addMeesage(type + "-function requires 0 arguments");
-                return false;
-            }
-
-            tempItem = parseJson(valueItem.item->toValue(), error);
+            tempItem = definition->function(valueItem.item, arguments, error);
+        }
+        if(tempItem == valueItem.item) {
+            continue;
         }
-        //------------------------------------------------------------------------------------------
 
         delete valueItem.item;
         valueItem.item = tempItem;
@@ -200,6 +172,163 @@ getProcessedItem(ValueItem &valueItem,
     return true;
 }
 
+/**
+ * @brief process a parse_json-call together with the directly following get-calls, where only
+ *        the requested value is converted into a data-item and all other values of the
+ *        json-string are skipped
+ *
+ * @param valueItem value-item with the json-string
+ * @param functionPos position of the parse_json-call, which is moved to the last get-call
+ * @param insertValues data-map with information to fill into the arguments
+ * @param error reference for error-output
+ *
+ * @return false, if something went wrong while processing and filling, else true. If false
+ *         an error-message was sent directly into the sakura-root-object
+ */
+bool
+processJsonPath(ValueItem &valueItem,
+                uint64_t &functionPos,
+                DataMap &insertValues,
+                ErrorContainer &error)
+{
+    if(valueItem.item->isValue() == false)
+    {
+        error.addMeesage("parse_json-function is called on a value with invalid type");
+        return false;
+    }
+
+    // fill the keys of all following get-calls
+    std::vector<ValueItem> filledArguments;
+    filledArguments.reserve(valueItem.functions.size() - functionPos);
+    std::vector<DataValue*> path;
+    while(functionPos + 1 < valueItem.functions.size()
+          && valueItem.functions[functionPos + 1].specialType == FunctionItem::GET_TYPE)
+    {
+        functionPos++;
+
+        filledArguments.push_back(valueItem.functions[functionPos].arguments.at(0));
+        if(fillValueItem(filledArguments.back(), insertValues, error) == false) {
+            return false;
+        }
+
+        if(filledArguments.back().item->isValue() == false)
+        {
+            error.addMeesage("inputs for get-function are invalid");
+            return false;
+        }
+        path.push_back(filledArguments.back().item->toValue());
+    }
+
+    // read string-values directly without converting them into a new string
+    DataValue* input = valueItem.item->toValue();
+    std::string text = "";
+    std::string_view textView;
+    if(input->isStringValue())
+    {
+        textView = input->content.stringValue;
+    }
+    else
+    {
+        text = input->toString();
+        textView = text;
+    }
+
+    JsonReader reader(textView);
+    DataItem* result = reader.parsePath(path, error);
+    if(result == nullptr) {
+        return false;
+    }
+
+    delete valueItem.item;
+    valueItem.item = result;
+
+    return true;
+}
+
+/**
+ * @brief process the first contains-call of an identifier-value by the index of the array,
+ *        which was created before the loop, instead of copying and iterating over the array
+ *
+ * @param valueItem value-item with index
+ * @param insertValues data-map with information to fill into the arguments
+ * @param error reference for error-output
+ *
+ * @return false, if something went wrong while processing and filling, else true. If false
+ *         an error-message was sent directly into the sakura-root-object
+ */
+bool
+fillIndexedItem(ValueItem &valueItem,
+                DataMap &insertValues,
+                ErrorContainer &error)
+{
+    ValueItem key = valueItem.functions.front().arguments.front();
+    if(fillValueItem(key, insertValues, error) == false) {
+        return false;
+    }
+
+    if(key.item->isValue() == false)
+    {
+        error.addMeesage("inputs for contains-function are invalid");
+        return false;
+    }
+
+    const bool found = isInContainsIndex(*valueItem.containsIndex, key.item->toValue());
+
+    delete valueItem.item;
+    valueItem.item = new DataValue(found);
+    valueItem.isIdentifier = false;
+    valueItem.containsIndex.reset();
+    valueItem.functions.erase(valueItem.functions.begin());
+
+    return getProcessedItem(valueItem, insertValues, error);
+}
+
+/**
+ * @brief process the first slice-call of an identifier-value, where only the selected entries
+ *        of the array are copied instead of the whole array
+ *
+ * @param valueItem value-item with a slice-call as first function
+ * @param array array of the identifier
+ * @param insertValues data-map with information to fill into the arguments
+ * @param error reference for error-output
+ *
+ * @return false, if something went wrong while processing and filling, else true. If false
+ *         an error-message was sent directly into the sakura-root-object
+ */
+bool
+fillSlicedItem(ValueItem &valueItem,
+               DataArray* array,
+               DataMap &insertValues,
+               ErrorContainer &error)
+{
+    const FunctionItem &functionItem = valueItem.functions.front();
+
+    // fill arguments
+    std::vector<ValueItem> filledArguments = functionItem.arguments;
+    std::vector<DataItem*> arguments;
+    for(ValueItem &argument : filledArguments)
+    {
+        if(fillValueItem(argument, insertValues, error) == false) {
+            return false;
+        }
+        arguments.push_back(argument.item);
+    }
+
+    uint64_t start = 0;
+    uint64_t end = 0;
+    const uint64_t size = array->size();
+    if(getSliceRange(start, end, functionItem.specialType, arguments, size, error) == false) {
+        return false;
+    }
+
+    delete valueItem.item;
+    valueItem.item = copySlice(array, start, end);
+    valueItem.isIdentifier = false;
+    valueItem.functions.erase(valueItem.functions.begin());
+
+    return getProcessedItem(valueItem, insertValues, error);
+}
+
 /**
  * @brief fill and process an identifier value by filling with incoming information and
  *        processing it functions-calls
@@ -216,6 +345,11 @@ fillIdentifierItem(ValueItem &valueItem,
                    DataMap &insertValues,
                    ErrorContainer &error)
 {
+    // membership-checks on arrays, which don't change within a loop, use the prebuilt index
+    if(valueItem.containsIndex != nullptr) {
+        return fillIndexedItem(valueItem, insertValues, error);
+    }
+
     // replace identifier with value from the insert-values
     DataItem* tempItem = insertValues.get(valueItem.item->toString());
     if(tempItem == nullptr)
@@ -224,6 +358,19 @@ fillIdentifierItem(ValueItem &valueItem,
         return false;
     }
 
+    // slices of arrays copy only the selected entries
+    if(tempItem->isArray()
+            && valueItem.functions.size() > 0)
+    {
+        const FunctionItem::SpecialType specialType = valueItem.functions.front().specialType;
+        if(specialType == FunctionItem::TAKE_TYPE
+                || specialType == FunctionItem::SKIP_TYPE
+                || specialType == FunctionItem::SLICE_TYPE)
+        {
+            return fillSlicedItem(valueItem, tempItem->toArray(), insertValues, error);
+        }
+    }
+
     delete valueItem.item;
     valueItem.item = tempItem->copy();
     valueItem.isIdentifier = false;
@@ -232,6 +379,69 @@ fillIdentifierItem(ValueItem &valueItem,
     return getProcessedItem(valueItem, insertValues, error);
 }
 
+/**
+ * @brief check if a string contains any jinja2-markers, so it has to be converted by the
+ *        jinja2-converter
+ *
+ * @param text string to check
+ *
+ * @return true, if the string contains an expression, statement or comment of jinja2
+ */
+bool
+isJinja2Template(const char* text)
+{
+    const char* pos = std::strchr(text, '{');
+    while(pos != nullptr)
+    {
+        const char next = pos[1];
+        if(next == '{'
+                || next == '%'
+                || next == '#')
+        {
+            return true;
+        }
+
+        pos = std::strchr(pos + 1, '{');
+    }
+
+    return false;
+}
+
+/**
+ * @brief convert a jinja2-string. Strings without jinja2-markers are returned without calling
+ *        the converter.
+ *
+ * @param result reference for the converted string
+ * @param templateString string to convert
+ * @param insertValues data-map with information to fill into the jinja2-string
+ * @param error reference for error-output
+ *
+ * @return false, if the conversion failed, else true
+ */
+bool
+convertJinja2Template(std::string &result,
+                      const std::string &templateString,
+                      DataMap &insertValues,
+                      ErrorContainer &error)
+{
+    if(isJinja2Template(templateString.c_str()) == false)
+    {
+        result = templateString;
+        return true;
+    }
+
+    // templates, which only insert values, are rendered by the cached parsed version of the
+    // template, so only the other ones have to wait for the shared converter
+    if(TemplateCache::getInstance()->render(result, templateString, insertValues)) {
+        return true;
+    }
+
+    // all threads use the same converter, because its parser is not reentrant and the
+    // converter serializes the calls
+    Jinja2Converter* converter = Jinja2Converter::getInstance();
+    return converter->convert(result, templateString, &insertValues, error);
+}
+
 /**
  * @brief interprete a string as jinja2-string, parse it and fill it with incoming information
  *
@@ -247,13 +457,18 @@ fillJinja2Template(ValueItem &valueItem,
                    DataMap &insertValues,
                    ErrorContainer &error)
 {
+    // plain strings stay as they are
+    DataValue* value = valueItem.item->toValue();
+    if(isJinja2Template(value->content.stringValue) == false) {
+        return true;
+    }
+
     // convert jinja2-string
-    Jinja2Converter* converter = Jinja2Converter::getInstance();
     std::string convertResult = "";
-    bool ret = converter->convert(convertResult,
-                                  valueItem.item->toString(),
-                                  &insertValues,
-                                  error);
+    bool ret = convertJinja2Template(convertResult,
+                                     value->content.stringValue,
+                                     insertValues,
+                                     error);
 
     if(ret == false)
     {
@@ -267,6 +482,39 @@ fillJinja2Template(ValueItem &valueItem,
     return true;
 }
 
+/**
+ * @brief evaluate the native expression of a value-item and replace the expression by its result
+ *
+ * @param valueItem value-item with expression
+ * @param insertValues data-map with the values to fill into the expression
+ * @param error reference for error-output
+ *
+ * @return false, if something went wrong while processing and filling, else true. If false
+ *         an error-message was sent directly into the sakura-root-object
+ */
+bool
+fillExpressionItem(ValueItem &valueItem,
+                   DataMap &insertValues,
+                   ErrorContainer &error)
+{
+    DataItem* result = evaluateExpression(*valueItem.expression, insertValues, error);
+    if(result == nullptr)
+    {
+        error.addMeesage("Failed to evaluate expression");
+        return false;
+    }
+
+    // the result is owned by the root of the expression, which is deleted afterwards, so the
+    // result can be taken over without a copy
+    valueItem.expression->value.item = nullptr;
+    delete valueItem.item;
+    valueItem.item = result;
+    delete valueItem.expression;
+    valueItem.expression = nullptr;
+
+    return getProcessedItem(valueItem, insertValues, error);
+}
+
 /**
  * @brief fill a single value-item with the information of the values of in incoming
  *        data-map, which processing all functions within the value-item-map
@@ -283,6 +531,16 @@ fillValueItem(ValueItem &valueItem,
               DataMap &insertValues,
               ErrorContainer &error)
 {
+    // constant values were already completely processed while loading the tree
+    if(valueItem.isConstant) {
+        return true;
+    }
+
+    // evaluate native expression
+    if(valueItem.expression != nullptr) {
+        return fillExpressionItem(valueItem, insertValues, error);
+    }
+
     // process and fill incoming string, which is interpreted as jinja2-template
     if(valueItem.isIdentifier == false
             && valueItem.type != ValueItem::OUTPUT_PAIR_TYPE
@@ -494,6 +752,104 @@ overrideItems(DataMap &original,
     }
 }
 
+/**
+ * @brief override data of a data-map by moving the items of another data-map, which is not
+ *        used anymore, instead of copying them
+ *
+ * @param original data-map with the original key-values, which should be updates with the
+ *                 information of the override-map
+ * @param override map with the new incoming information, which is empty afterwards
+ */
+void
+moveItems(DataMap &original,
+          DataMap &override)
+{
+    std::map<std::string, DataItem*>::iterator overrideIt;
+    for(overrideIt = override.map.begin();
+        overrideIt != override.map.end();
+        overrideIt++)
+    {
+        original.insert(overrideIt->first, overrideIt->second, true);
+    }
+
+    override.map.clear();
+}
+
+/**
+ * @brief move the output-values of a blossom into the declared output-slots of the caller.
+ *        Only values, which already exist in the original map, are updated. Outputs, which
+ *        are assigned to multiple slots, are copied for all except the last slot.
+ *
+ * @param original data-map of the caller, which should be updated
+ * @param items value-item-map of the blossom with the output-declarations
+ * @param output output of the blossom, where the moved values are removed
+ *
+ * @return false, if a declared output doesn't exist in the output of the blossom, else true
+ */
+bool
+moveOutputItems(DataMap &original,
+                ValueItemMap &items,
+                DataMap &output)
+{
+    std::map<std::string, ValueItem>::const_iterator it;
+
+    // count the slots for each output
+    std::map<std::string, uint32_t> numberOfSlots;
+    for(it = items.m_valueMap.begin();
+        it != items.m_valueMap.end();
+        it++)
+    {
+        if(it->second.type != ValueItem::OUTPUT_PAIR_TYPE) {
+            continue;
+        }
+
+        const std::string outputName = it->second.item->toString();
+        if(output.map.find(outputName) == output.map.end()) {
+            return false;
+        }
+
+        if(original.map.find(it->first) != original.map.end()) {
+            numberOfSlots[outputName]++;
+        }
+    }
+
+    // move or copy the outputs into the slots
+    for(it = items.m_valueMap.begin();
+        it != items.m_valueMap.end();
+        it++)
+    {
+        if(it->second.type != ValueItem::OUTPUT_PAIR_TYPE) {
+            continue;
+        }
+
+        std::map<std::string, DataItem*>::iterator originalIt;
+        originalIt = original.map.find(it->first);
+        if(originalIt == original.map.end()) {
+            continue;
+        }
+
+        const std::string outputName = it->second.item->toString();
+        std::map<std::string, DataItem*>::iterator outputIt = output.map.find(outputName);
+
+        if(originalIt->second != nullptr) {
+            delete originalIt->second;
+        }
+
+        numberOfSlots[outputName]--;
+        if(numberOfSlots[outputName] > 0)
+        {
+            originalIt->second = outputIt->second->copy();
+        }
+        else
+        {
+            originalIt->second = outputIt->second;
+            output.map.erase(outputIt);
+        }
+    }
+
+    return true;
+}
+
 /**
  * @brief override data of a value-item-map with new incoming information
  *
@@ -639,31 +995,47 @@ convertBlossomOutput(const BlossomIO &blossom)
 }
 
 /**
- * @brief convert value-item-map into data-map
+ * @brief move the values of a value-item-map into a data-map as input of a blossom. The
+ *        value-items are empty afterwards, so this can only be used for value-item-maps, which
+ *        are not used anymore. Output-declarations only contain the name of the output, so
+ *        they are copied and stay in the value-item-map.
  *
  * @param result resulting data-map
  * @param input input value-item-map
  */
 void
-convertValueMap(DataMap &result, const ValueItemMap &input)
+moveValueMap(DataMap &result,
+             ValueItemMap &input)
 {
-    // fill values
-    std::map<std::string, ValueItem>::const_iterator it;
+    // move values
+    std::map<std::string, ValueItem>::iterator it;
     for(it = input.m_valueMap.begin();
         it != input.m_valueMap.end();
         it++)
     {
-        result.insert(it->first, it->second.item->copy());
+        if(it->second.item == nullptr) {
+            continue;
+        }
+
+        if(it->second.type == ValueItem::OUTPUT_PAIR_TYPE)
+        {
+            result.insert(it->first, it->second.item->copy());
+        }
+        else
+        {
+            result.insert(it->first, it->second.item);
+            it->second.item = nullptr;
+        }
     }
 
-    // fill childs
+    // move childs
     std::map<std::string, ValueItemMap*>::const_iterator itChild;
     for(itChild = input.m_childMaps.begin();
         itChild != input.m_childMaps.end();
         itChild++)
     {
         DataMap* internalMap = new DataMap();
-        convertValueMap(*internalMap, *itChild->second);
+        moveValueMap(*internalMap, *itChild->second);
         result.insert(itChild->first, internalMap);
     }
 }
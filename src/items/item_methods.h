@@ -42,11 +42,30 @@ using Kitsunemimi::DataMap;
 bool getProcessedItem(ValueItem &valueItem,
                       DataMap &insertValues,
                       ErrorContainer &error);
+bool processJsonPath(ValueItem &valueItem,
+                     uint64_t &functionPos,
+                     DataMap &insertValues,
+                     ErrorContainer &error);
 
 // fill functions
+bool fillIndexedItem(ValueItem &valueItem,
+                     DataMap &insertValues,
+                     ErrorContainer &error);
+bool fillSlicedItem(ValueItem &valueItem,
+                    DataArray* array,
+                    DataMap &insertValues,
+                    ErrorContainer &error);
 bool fillIdentifierItem(ValueItem &valueItem,
                         DataMap &insertValues,
                         ErrorContainer &error);
+bool fillExpressionItem(ValueItem &valueItem,
+                        DataMap &insertValues,
+                        ErrorContainer &error);
+bool isJinja2Template(const char* text);
+bool convertJinja2Template(std::string &result,
+                           const std::string &templateString,
+                           DataMap &insertValues,
+                           ErrorContainer &error);
 bool fillJinja2Template(ValueItem &valueItem,
                         DataMap &insertValues,
                         ErrorContainer &error);
@@ -76,6 +95,11 @@ void overrideItems(DataMap &original,
 void overrideItems(ValueItemMap &original,
                    const ValueItemMap &override,
                    OverrideType type);
+void moveItems(DataMap &original,
+               DataMap &override);
+bool moveOutputItems(DataMap &original,
+                     ValueItemMap &items,
+                     DataMap &output);
 
 // check items
 const std::vector<std::string> checkInput(ValueItemMap &original,
@@ -84,8 +108,8 @@ const std::vector<std::string> checkItems(DataMap &items);
 
 // convert
 const std::string convertBlossomOutput(const BlossomIO &blossom);
-void convertValueMap(DataMap &result,
-                     const ValueItemMap &input);
+void moveValueMap(DataMap &result,
+                  ValueItemMap &input);
 
 // error-output
 void createError(const BlossomItem &blossomItem,
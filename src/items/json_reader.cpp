@@ -0,0 +1,949 @@
+/**
+ * @file        json_reader.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+
+#include "json_reader.h"
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+
+// maximum depth of nested objects and arrays to avoid a stack-overflow by the recursion
+#define MAX_JSON_DEPTH 512
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief check 8 characters at once, if one of them is the searched character
+ *
+ * @param word 8 characters of the string
+ * @param character searched character
+ *
+ * @return true, if the character is within the word, else false
+ */
+inline bool
+hasCharacter(const uint64_t word,
+             const char character)
+{
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    const uint64_t value = word ^ (ones * static_cast<uint8_t>(character));
+
+    return ((value - ones) & ~value & highs) != 0;
+}
+
+/**
+ * @brief read the 4 hex-digits of an unicode-escape
+ *
+ * @param text json-string
+ * @param pos position of the first digit
+ * @param result reference for the resulting number
+ *
+ * @return false, if the digits are invalid, else true
+ */
+bool
+readHex(const std::string_view &text,
+        const uint64_t pos,
+        uint32_t &result)
+{
+    if(pos + 4 > text.size()) {
+        return false;
+    }
+
+    result = 0;
+    for(uint64_t i = pos; i < pos + 4; i++)
+    {
+        const char digit = text[i];
+        result <<= 4;
+
+        if(digit >= '0' && digit <= '9') {
+            result |= static_cast<uint32_t>(digit - '0');
+        } else if(digit >= 'a' && digit <= 'f') {
+            result |= static_cast<uint32_t>(digit - 'a' + 10);
+        } else if(digit >= 'A' && digit <= 'F') {
+            result |= static_cast<uint32_t>(digit - 'A' + 10);
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief constructor
+ *
+ * @param text json-formated string, which must exist as long as the reader is used
+ */
+JsonReader::JsonReader(const std::string_view &text)
+{
+    m_text = text;
+}
+
+/**
+ * @brief destructor
+ */
+JsonReader::~JsonReader() {}
+
+/**
+ * @brief parse the complete json-string
+ *
+ * @param error reference for error-output
+ *
+ * @return nullptr, if the string is invalid, else the parsed content
+ */
+DataItem*
+JsonReader::parse(ErrorContainer &error)
+{
+    m_pos = 0;
+
+    DataItem* result = parseValue(0, error);
+    if(result == nullptr) {
+        return nullptr;
+    }
+
+    if(skipWhitespaces())
+    {
+        addError("unexpected content behind the json-value", error);
+        delete result;
+        return nullptr;
+    }
+
+    return result;
+}
+
+/**
+ * @brief parse only the value behind a path of keys and positions like a chain of get-calls.
+ *        All other values on the way are only skipped and the content behind the requested
+ *        value is not checked at all.
+ *
+ * @param path keys of objects or positions in arrays to the requested value
+ * @param error reference for error-output
+ *
+ * @return nullptr, if the path doesn't exist or the string is invalid, else the requested value
+ */
+DataItem*
+JsonReader::parsePath(const std::vector<DataValue*> &path,
+                      ErrorContainer &error)
+{
+    m_pos = 0;
+
+    for(DataValue* key : path)
+    {
+        if(findEntry(key, error) == false) {
+            return nullptr;
+        }
+    }
+
+    return parseValue(0, error);
+}
+
+/**
+ * @brief move the position behind all whitespaces
+ *
+ * @return false, if the end of the string was reached, else true
+ */
+bool
+JsonReader::skipWhitespaces()
+{
+    while(m_pos < m_text.size())
+    {
+        const char character = m_text[m_pos];
+        if(character != ' '
+                && character != '\n'
+                && character != '\r'
+                && character != '\t')
+        {
+            return true;
+        }
+        m_pos++;
+    }
+
+    return false;
+}
+
+/**
+ * @brief search the next quote or backslash within a string by checking 8 characters at once
+ *
+ * @param pos start-position of the search
+ *
+ * @return position of the found character or the size of the string, if nothing was found
+ */
+uint64_t
+JsonReader::findStringSpecial(uint64_t pos) const
+{
+    const char* data = m_text.data();
+    const uint64_t size = m_text.size();
+
+    // skip all words without a special character
+    while(pos + 8 <= size)
+    {
+        uint64_t word = 0;
+        memcpy(&word, data + pos, 8);
+        if(hasCharacter(word, '"')
+                || hasCharacter(word, '\\'))
+        {
+            break;
+        }
+        pos += 8;
+    }
+
+    // find the exact position within the last word
+    while(pos < size)
+    {
+        if(data[pos] == '"'
+                || data[pos] == '\\')
+        {
+            return pos;
+        }
+        pos++;
+    }
+
+    return size;
+}
+
+/**
+ * @brief search the next structural character, which is relevant to skip nested content
+ *
+ * @param pos start-position of the search
+ *
+ * @return position of the found character or the size of the string, if nothing was found
+ */
+uint64_t
+JsonReader::findStructural(uint64_t pos) const
+{
+    const char* data = m_text.data();
+    const uint64_t size = m_text.size();
+
+    // skip all words without a structural character
+    while(pos + 8 <= size)
+    {
+        uint64_t word = 0;
+        memcpy(&word, data + pos, 8);
+        if(hasCharacter(word, '"')
+                || hasCharacter(word, '{')
+                || hasCharacter(word, '}')
+                || hasCharacter(word, '[')
+                || hasCharacter(word, ']'))
+        {
+            break;
+        }
+        pos += 8;
+    }
+
+    // find the exact position within the last word
+    while(pos < size)
+    {
+        const char character = data[pos];
+        if(character == '"'
+                || character == '{'
+                || character == '}'
+                || character == '['
+                || character == ']')
+        {
+            return pos;
+        }
+        pos++;
+    }
+
+    return size;
+}
+
+/**
+ * @brief parse the value at the current position
+ *
+ * @param depth current depth of nested objects and arrays
+ * @param error reference for error-output
+ *
+ * @return nullptr, if the value is invalid, else the parsed value
+ */
+DataItem*
+JsonReader::parseValue(const uint32_t depth,
+                       ErrorContainer &error)
+{
+    if(skipWhitespaces() == false)
+    {
+        addError("unexpected end of the json-string", error);
+        return nullptr;
+    }
+
+    if(depth > MAX_JSON_DEPTH)
+    {
+        addError("json-string is nested too deep", error);
+        return nullptr;
+    }
+
+    const char character = m_text[m_pos];
+
+    //----------------------------------------------------------------------------------------------
+    if(character == '{') {
+        return parseObject(depth + 1, error);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(character == '[') {
+        return parseArray(depth + 1, error);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(character == '"')
+    {
+        std::string value = "";
+        if(parseString(value, error) == false) {
+            return nullptr;
+        }
+        return new DataValue(value);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(character == '-'
+            || (character >= '0' && character <= '9'))
+    {
+        return parseNumber(error);
+    }
+    //----------------------------------------------------------------------------------------------
+
+    return parseLiteral(error);
+}
+
+/**
+ * @brief parse the object at the current position
+ *
+ * @param depth current depth of nested objects and arrays
+ * @param error reference for error-output
+ *
+ * @return nullptr, if the object is invalid, else the parsed object
+ */
+DataMap*
+JsonReader::parseObject(const uint32_t depth,
+                        ErrorContainer &error)
+{
+    DataMap* result = new DataMap();
+
+    // skip '{' and handle empty object
+    m_pos++;
+    if(skipWhitespaces()
+            && m_text[m_pos] == '}')
+    {
+        m_pos++;
+        return result;
+    }
+
+    std::string key = "";
+    while(true)
+    {
+        if(skipWhitespaces() == false
+                || m_text[m_pos] != '"')
+        {
+            addError("expected key within object", error);
+            delete result;
+            return nullptr;
+        }
+
+        if(parseString(key, error) == false
+                || expect(':', error) == false)
+        {
+            delete result;
+            return nullptr;
+        }
+
+        DataItem* value = parseValue(depth, error);
+        if(value == nullptr)
+        {
+            delete result;
+            return nullptr;
+        }
+        result->insert(key, value, true);
+
+        if(skipWhitespaces()
+                && m_text[m_pos] == '}')
+        {
+            m_pos++;
+            return result;
+        }
+
+        if(expect(',', error) == false)
+        {
+            delete result;
+            return nullptr;
+        }
+    }
+}
+
+/**
+ * @brief parse the array at the current position
+ *
+ * @param depth current depth of nested objects and arrays
+ * @param error reference for error-output
+ *
+ * @return nullptr, if the array is invalid, else the parsed array
+ */
+DataArray*
+JsonReader::parseArray(const uint32_t depth,
+                       ErrorContainer &error)
+{
+    DataArray* result = new DataArray();
+
+    // skip '[' and handle empty array
+    m_pos++;
+    if(skipWhitespaces()
+            && m_text[m_pos] == ']')
+    {
+        m_pos++;
+        return result;
+    }
+
+    while(true)
+    {
+        DataItem* value = parseValue(depth, error);
+        if(value == nullptr)
+        {
+            delete result;
+            return nullptr;
+        }
+        result->append(value);
+
+        if(skipWhitespaces()
+                && m_text[m_pos] == ']')
+        {
+            m_pos++;
+            return result;
+        }
+
+        if(expect(',', error) == false)
+        {
+            delete result;
+            return nullptr;
+        }
+    }
+}
+
+/**
+ * @brief parse the number at the current position. Numbers without fraction and exponent
+ *        become int-values, as long as they fit into them.
+ *
+ * @param error reference for error-output
+ *
+ * @return nullptr, if the number is invalid, else the parsed number
+ */
+DataValue*
+JsonReader::parseNumber(ErrorContainer &error)
+{
+    const uint64_t start = m_pos;
+    bool isFloat = false;
+
+    if(m_text[m_pos] == '-') {
+        m_pos++;
+    }
+
+    while(m_pos < m_text.size())
+    {
+        const char character = m_text[m_pos];
+        if(character == '.'
+                || character == 'e'
+                || character == 'E'
+                || character == '+'
+                || character == '-')
+        {
+            isFloat = true;
+        }
+        else if(character < '0' || character > '9')
+        {
+            break;
+        }
+        m_pos++;
+    }
+
+    const char* begin = m_text.data() + start;
+    const char* end = m_text.data() + m_pos;
+
+    if(isFloat == false)
+    {
+        long value = 0;
+        const std::from_chars_result ret = std::from_chars(begin, end, value);
+        if(ret.ec == std::errc()
+                && ret.ptr == end)
+        {
+            return new DataValue(value);
+        }
+
+        // numbers, which are too big for an int-value, are converted into a float-value
+        if(ret.ec != std::errc::result_out_of_range)
+        {
+            addError("invalid number", error);
+            return nullptr;
+        }
+    }
+
+    const std::string number(begin, end);
+    char* numberEnd = nullptr;
+    const double value = std::strtod(number.c_str(), &numberEnd);
+    if(number.size() == 0
+            || numberEnd != number.c_str() + number.size())
+    {
+        addError("invalid number", error);
+        return nullptr;
+    }
+
+    return new DataValue(value);
+}
+
+/**
+ * @brief parse the literal true, false or null at the current position
+ *
+ * @param error reference for error-output
+ *
+ * @return nullptr, if there is no valid literal, else the parsed value
+ */
+DataValue*
+JsonReader::parseLiteral(ErrorContainer &error)
+{
+    const std::string_view rest = m_text.substr(m_pos);
+
+    if(rest.substr(0, 4) == "true")
+    {
+        m_pos += 4;
+        return new DataValue(true);
+    }
+
+    if(rest.substr(0, 5) == "false")
+    {
+        m_pos += 5;
+        return new DataValue(false);
+    }
+
+    if(rest.substr(0, 4) == "null")
+    {
+        m_pos += 4;
+        return new DataValue();
+    }
+
+    addError("invalid value", error);
+    return nullptr;
+}
+
+/**
+ * @brief parse the string at the current position, where the parts between escape-sequences
+ *        are appended as whole blocks
+ *
+ * @param result reference for the resulting string
+ * @param error reference for error-output
+ *
+ * @return false, if the string is invalid, else true
+ */
+bool
+JsonReader::parseString(std::string &result,
+                        ErrorContainer &error)
+{
+    result.clear();
+
+    // skip '"'
+    m_pos++;
+
+    while(true)
+    {
+        const uint64_t end = findStringSpecial(m_pos);
+        if(end >= m_text.size())
+        {
+            addError("string is not terminated", error);
+            return false;
+        }
+
+        result.append(m_text.data() + m_pos, end - m_pos);
+        m_pos = end + 1;
+
+        if(m_text[end] == '"') {
+            return true;
+        }
+
+        // handle escape-sequence
+        if(m_pos >= m_text.size())
+        {
+            addError("string is not terminated", error);
+            return false;
+        }
+
+        const char character = m_text[m_pos];
+        m_pos++;
+
+        switch(character)
+        {
+            case '"':
+            case '\\':
+            case '/':
+                result.push_back(character);
+                break;
+            case 'b':
+                result.push_back('\b');
+                break;
+            case 'f':
+                result.push_back('\f');
+                break;
+            case 'n':
+                result.push_back('\n');
+                break;
+            case 'r':
+                result.push_back('\r');
+                break;
+            case 't':
+                result.push_back('\t');
+                break;
+            case 'u':
+                if(parseUnicode(result, error) == false) {
+                    return false;
+                }
+                break;
+            default:
+                addError("invalid escape-sequence within string", error);
+                return false;
+        }
+    }
+}
+
+/**
+ * @brief convert an unicode-escape at the current position into utf8
+ *
+ * @param result reference for the string, where the character should be appended
+ * @param error reference for error-output
+ *
+ * @return false, if the escape-sequence is invalid, else true
+ */
+bool
+JsonReader::parseUnicode(std::string &result,
+                         ErrorContainer &error)
+{
+    uint32_t codePoint = 0;
+    if(readHex(m_text, m_pos, codePoint) == false)
+    {
+        addError("invalid unicode-escape within string", error);
+        return false;
+    }
+    m_pos += 4;
+
+    // combine surrogate-pair
+    if(codePoint >= 0xD800
+            && codePoint <= 0xDBFF)
+    {
+        uint32_t low = 0;
+        if(m_pos + 1 >= m_text.size()
+                || m_text[m_pos] != '\\'
+                || m_text[m_pos + 1] != 'u'
+                || readHex(m_text, m_pos + 2, low) == false
+                || low < 0xDC00
+                || low > 0xDFFF)
+        {
+            addError("invalid surrogate-pair within string", error);
+            return false;
+        }
+
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+        m_pos += 6;
+    }
+
+    // encode as utf8
+    if(codePoint < 0x80)
+    {
+        result.push_back(static_cast<char>(codePoint));
+    }
+    else if(codePoint < 0x800)
+    {
+        result.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if(codePoint < 0x10000)
+    {
+        result.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else
+    {
+        result.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        result.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+
+    return true;
+}
+
+/**
+ * @brief skip the value at the current position without creating any data-item. Nested
+ *        content is skipped by jumping from one structural character to the next one.
+ *
+ * @param error reference for error-output
+ *
+ * @return false, if the end of the string was reached, else true
+ */
+bool
+JsonReader::skipValue(ErrorContainer &error)
+{
+    if(skipWhitespaces() == false)
+    {
+        addError("unexpected end of the json-string", error);
+        return false;
+    }
+
+    const char character = m_text[m_pos];
+
+    //----------------------------------------------------------------------------------------------
+    if(character == '"') {
+        return skipString(error);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(character == '{'
+            || character == '[')
+    {
+        uint64_t depth = 0;
+        m_pos = findStructural(m_pos);
+        while(m_pos < m_text.size())
+        {
+            const char current = m_text[m_pos];
+            if(current == '"')
+            {
+                if(skipString(error) == false) {
+                    return false;
+                }
+            }
+            else
+            {
+                if(current == '{' || current == '[')
+                {
+                    depth++;
+                }
+                else
+                {
+                    depth--;
+                    if(depth == 0)
+                    {
+                        m_pos++;
+                        return true;
+                    }
+                }
+                m_pos++;
+            }
+
+            m_pos = findStructural(m_pos);
+        }
+
+        addError("unexpected end of the json-string", error);
+        return false;
+    }
+    //----------------------------------------------------------------------------------------------
+
+    // skip numbers and literals until the next delimiter
+    while(m_pos < m_text.size())
+    {
+        const char current = m_text[m_pos];
+        if(current == ','
+                || current == '}'
+                || current == ']'
+                || current == ' '
+                || current == '\n'
+                || current == '\r'
+                || current == '\t')
+        {
+            break;
+        }
+        m_pos++;
+    }
+
+    return true;
+}
+
+/**
+ * @brief skip the string at the current position
+ *
+ * @param error reference for error-output
+ *
+ * @return false, if the string is not terminated, else true
+ */
+bool
+JsonReader::skipString(ErrorContainer &error)
+{
+    // skip '"'
+    m_pos++;
+
+    while(true)
+    {
+        const uint64_t end = findStringSpecial(m_pos);
+        if(end >= m_text.size())
+        {
+            addError("string is not terminated", error);
+            return false;
+        }
+
+        if(m_text[end] == '"')
+        {
+            m_pos = end + 1;
+            return true;
+        }
+
+        // skip the escaped character
+        m_pos = end + 2;
+    }
+}
+
+/**
+ * @brief move the position to a value within the object or array at the current position,
+ *        with the same behavior like the get-function
+ *
+ * @param key key within an object or position within an array
+ * @param error reference for error-output
+ *
+ * @return false, if the value doesn't exist, else true
+ */
+bool
+JsonReader::findEntry(DataValue* key,
+                      ErrorContainer &error)
+{
+    if(skipWhitespaces() == false)
+    {
+        addError("unexpected end of the json-string", error);
+        return false;
+    }
+
+    //----------------------------------------------------------------------------------------------
+    if(m_text[m_pos] == '{')
+    {
+        const std::string searchedKey = key->toString();
+        std::string currentKey = "";
+
+        m_pos++;
+        while(skipWhitespaces()
+              && m_text[m_pos] == '"')
+        {
+            if(parseString(currentKey, error) == false
+                    || expect(':', error) == false)
+            {
+                return false;
+            }
+
+            if(currentKey == searchedKey) {
+                return true;
+            }
+
+            if(skipValue(error) == false) {
+                return false;
+            }
+
+            if(skipWhitespaces() == false
+                    || m_text[m_pos] != ',')
+            {
+                break;
+            }
+            m_pos++;
+        }
+
+        error.addMeesage("key " + searchedKey + " doesn't exist in the map");
+        return false;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(m_text[m_pos] == '[')
+    {
+        // check that value for access is an integer
+        if(key->isIntValue() == false)
+        {
+            error.addMeesage("input for the get-function is not an integer-typed value-item");
+            return false;
+        }
+        if(key->getLong() < 0)
+        {
+            error.addMeesage("input for the get-function has a negative value");
+            return false;
+        }
+
+        const uint64_t searchedPos = static_cast<uint64_t>(key->getLong());
+
+        m_pos++;
+        if(skipWhitespaces()
+                && m_text[m_pos] != ']')
+        {
+            for(uint64_t i = 0; ; i++)
+            {
+                if(i == searchedPos) {
+                    return true;
+                }
+
+                if(skipValue(error) == false) {
+                    return false;
+                }
+
+                if(skipWhitespaces() == false
+                        || m_text[m_pos] != ',')
+                {
+                    break;
+                }
+                m_pos++;
+            }
+        }
+
+        error.addMeesage("input value for get-function is too but for the array");
+        return false;
+    }
+    //----------------------------------------------------------------------------------------------
+
+    error.addMeesage("item for calling the get-function is a value-item");
+    return false;
+}
+
+/**
+ * @brief skip whitespaces and the expected character
+ *
+ * @param character expected character
+ * @param error reference for error-output
+ *
+ * @return false, if the expected character is not at the current position, else true
+ */
+bool
+JsonReader::expect(const char character,
+                   ErrorContainer &error)
+{
+    if(skipWhitespaces()
+            && m_text[m_pos] == character)
+    {
+        m_pos++;
+        return true;
+    }
+
+    addError("expected '" + std::string(1, character) + "'", error);
+    return false;
+}
+
+/**
+ * @brief add a parser-error with the current position to the error-container
+ *
+ * @param message error-message
+ * @param error reference for error-output
+ */
+void
+JsonReader::addError(const std::string &message,
+                     ErrorContainer &error) const
+{
+    error.addMeesage("invalid json-string at position "
+                     + std::to_string(m_pos) + ": " + message);
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
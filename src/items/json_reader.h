@@ -0,0 +1,93 @@
+/**
+ * @file        json_reader.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_JSON_READER_H
+#define KITSUNEMIMI_SAKURA_LANG_JSON_READER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class DataItem;
+class DataMap;
+class DataArray;
+class DataValue;
+
+namespace Sakura
+{
+
+/**
+ * @brief Single-pass reader for json-formated strings, which creates the data-items directly
+ *        out of the string without any intermediate representation. Values, which are not
+ *        requested by a path, are only skipped and never converted into data-items.
+ */
+class JsonReader
+{
+public:
+    JsonReader(const std::string_view &text);
+    ~JsonReader();
+
+    DataItem* parse(ErrorContainer &error);
+    DataItem* parsePath(const std::vector<DataValue*> &path,
+                        ErrorContainer &error);
+
+private:
+    std::string_view m_text;
+    uint64_t m_pos = 0;
+
+    bool skipWhitespaces();
+    uint64_t findStringSpecial(uint64_t pos) const;
+    uint64_t findStructural(uint64_t pos) const;
+
+    DataItem* parseValue(const uint32_t depth,
+                         ErrorContainer &error);
+    DataMap* parseObject(const uint32_t depth,
+                         ErrorContainer &error);
+    DataArray* parseArray(const uint32_t depth,
+                          ErrorContainer &error);
+    DataValue* parseNumber(ErrorContainer &error);
+    DataValue* parseLiteral(ErrorContainer &error);
+    bool parseString(std::string &result,
+                     ErrorContainer &error);
+    bool parseUnicode(std::string &result,
+                      ErrorContainer &error);
+
+    bool skipValue(ErrorContainer &error);
+    bool skipString(ErrorContainer &error);
+    bool findEntry(DataValue* key,
+                   ErrorContainer &error);
+
+    bool expect(const char character,
+                ErrorContainer &error);
+    void addError(const std::string &message,
+                  ErrorContainer &error) const;
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_JSON_READER_H
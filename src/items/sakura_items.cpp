@@ -60,6 +60,7 @@ BlossomItem::copy()
     newItem->blossomName = blossomName;
     newItem->blossomGroupType = blossomGroupType;
     newItem->blossomType = blossomType;
+    newItem->linkedResource = linkedResource;
 
     return newItem;
 }
@@ -124,6 +125,9 @@ TreeItem::copy()
     newItem->type = type;
     newItem->values = values;
     newItem->outputKeys = outputKeys;
+    newItem->fixedKeys = fixedKeys;
+    newItem->cacheSize = cacheSize;
+    newItem->cacheContextKeys = cacheContextKeys;
 
     newItem->unparsedConent = unparsedConent;
     newItem->relativePath = relativePath;
@@ -161,6 +165,10 @@ SubtreeItem::copy()
     newItem->values = values;
 
     newItem->nameOrPath = nameOrPath;
+    newItem->linkedTree = linkedTree;
+    newItem->linkedId = linkedId;
+    newItem->isCached = isCached;
+    newItem->cacheTimeToLive = cacheTimeToLive;
 
     return newItem;
 }
@@ -192,9 +200,7 @@ IfBranching::copy()
     newItem->type = type;
     newItem->values = values;
 
-    newItem->leftSide = leftSide;
-    newItem->ifType = ifType;
-    newItem->rightSide = rightSide;
+    newItem->condition = condition;
 
     if(ifContent != nullptr) {
         newItem->ifContent = ifContent->copy();
@@ -232,6 +238,9 @@ ForEachBranching::copy()
     newItem->tempVarName = tempVarName;
     newItem->iterateArray = iterateArray;
     newItem->parallel = parallel;
+    newItem->parallelWidth = parallelWidth;
+    newItem->variantValues = variantValues;
+    newItem->isAnalyzed = isAnalyzed;
 
     if(content != nullptr) {
         newItem->content = content->copy();
@@ -267,6 +276,9 @@ ForBranching::copy()
     newItem->start = start;
     newItem->end = end;
     newItem->parallel = parallel;
+    newItem->parallelWidth = parallelWidth;
+    newItem->variantValues = variantValues;
+    newItem->isAnalyzed = isAnalyzed;
 
     if(content != nullptr) {
         newItem->content = content->copy();
@@ -36,6 +36,7 @@ struct DataBuffer;
 
 namespace Sakura
 {
+class TreeItem;
 
 //==================================================================================================
 // SakuraItem
@@ -82,6 +83,9 @@ public:
     std::string blossomName = "";
     std::string blossomType = "";
     std::string blossomGroupType = "";
+
+    // resource, which is called instead of a blossom (resolved by the linking of the garden)
+    TreeItem* linkedResource = nullptr;
 };
 
 //==================================================================================================
@@ -120,6 +124,14 @@ public:
     std::string comment = "";
     std::vector<std::string> outputKeys;
 
+    // input-values, which were fixed by a specialization of the tree
+    std::vector<std::string> fixedKeys;
+
+    // maximum number of cached results of the tree (0 = not cacheable) and the keys of the
+    // context, which are used together with the input-values to identify a result
+    uint64_t cacheSize = 0;
+    std::vector<std::string> cacheContextKeys;
+
     SakuraItem* childs;
 };
 
@@ -136,6 +148,15 @@ public:
     std::string nameOrPath = "";
     DataMap* parentValues = nullptr;
 
+    // called tree and its id within the garden (resolved by the linking of the garden)
+    TreeItem* linkedTree = nullptr;
+    std::string linkedId = "";
+
+    // results of calls with the same input-values are reused within the same run or, if a
+    // time-to-live in seconds is set, over multiple runs
+    bool isCached = false;
+    uint32_t cacheTimeToLive = 0;
+
     // result
     std::vector<std::string> nameHirarchie;
 };
@@ -146,22 +167,11 @@ public:
 class IfBranching : public SakuraItem
 {
 public:
-    enum compareTypes {
-        EQUAL = 0,
-        GREATER_EQUAL = 1,
-        GREATER = 2,
-        SMALLER_EQUAL = 3,
-        SMALLER = 4,
-        UNEQUAL = 5
-    };
-
     IfBranching();
     ~IfBranching();
     SakuraItem* copy();
 
-    ValueItem leftSide;
-    compareTypes ifType = EQUAL;
-    ValueItem rightSide;
+    ExpressionItem condition;
 
     SakuraItem* ifContent = nullptr;
     SakuraItem* elseContent = nullptr;
@@ -181,6 +191,13 @@ public:
     ValueItemMap iterateArray;
     bool parallel = false;
 
+    // maximum number of iterations of a parallel loop, which run at the same time (0 = default)
+    uint32_t parallelWidth = 0;
+
+    // names of values, which can change between the iterations (set by the linking)
+    std::vector<std::string> variantValues;
+    bool isAnalyzed = false;
+
     SakuraItem* content = nullptr;
 };
 
@@ -199,6 +216,13 @@ public:
     ValueItem end;
     bool parallel = false;
 
+    // maximum number of iterations of a parallel loop, which run at the same time (0 = default)
+    uint32_t parallelWidth = 0;
+
+    // names of values, which can change between the iterations (set by the linking)
+    std::vector<std::string> variantValues;
+    bool isAnalyzed = false;
+
     SakuraItem* content = nullptr;
 };
 
@@ -0,0 +1,197 @@
+/**
+ * @file        template_cache.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "template_cache.h"
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+#include <cctype>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+// created at startup, because the first call can come from multiple worker-threads at once
+TemplateCache* TemplateCache::m_instance = new TemplateCache();
+
+// the templates are defined by the sakura-files, so the limit is only a protection against
+// templates, which are created at runtime
+#define MAX_NUMBER_OF_TEMPLATES 4096
+
+/**
+ * @brief constructor
+ */
+TemplateCache::TemplateCache() {}
+
+/**
+ * @brief static methode to get instance of the interface
+ *
+ * @return pointer to the static instance
+ */
+TemplateCache*
+TemplateCache::getInstance()
+{
+    return m_instance;
+}
+
+/**
+ * @brief render a simple jinja2-template, which only inserts values, without the
+ *        jinja2-converter, so these templates can be rendered by all threads at the same time
+ *
+ * @param result reference for the rendered string
+ * @param templateString template to render
+ * @param insertValues data-map with the values to fill into the template
+ *
+ * @return false, if the template has to be converted by the jinja2-converter, else true
+ */
+bool
+TemplateCache::render(std::string &result,
+                      const std::string &templateString,
+                      DataMap &insertValues)
+{
+    const ParsedTemplate* parsedTemplate = getTemplate(templateString);
+    if(parsedTemplate->isSimple == false) {
+        return false;
+    }
+
+    std::string rendered = parsedTemplate->textParts.at(0);
+    for(uint64_t i = 0; i < parsedTemplate->valueNames.size(); i++)
+    {
+        // missing values and values of other types are left to the converter, which also
+        // creates the error-messages for them
+        DataItem* item = insertValues.get(parsedTemplate->valueNames.at(i));
+        if(item == nullptr
+                || item->isValue() == false)
+        {
+            return false;
+        }
+
+        if(item->isStringValue()) {
+            rendered += item->toValue()->getString();
+        } else if(item->isIntValue()) {
+            rendered += std::to_string(item->toValue()->getLong());
+        } else {
+            return false;
+        }
+
+        rendered += parsedTemplate->textParts.at(i + 1);
+    }
+
+    result = rendered;
+    return true;
+}
+
+/**
+ * @brief get the parsed version of a template and parse it, if not already cached
+ *
+ * @param templateString template to parse
+ *
+ * @return parsed template
+ */
+const ParsedTemplate*
+TemplateCache::getTemplate(const std::string &templateString)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    std::map<std::string, ParsedTemplate*>::const_iterator it;
+    it = m_templates.find(templateString);
+    if(it != m_templates.end()) {
+        return it->second;
+    }
+
+    // cached templates are never deleted, so they can be used without the lock
+    ParsedTemplate* parsedTemplate = new ParsedTemplate();
+    parseTemplate(*parsedTemplate, templateString);
+    if(m_templates.size() >= MAX_NUMBER_OF_TEMPLATES)
+    {
+        static ParsedTemplate notCached;
+        delete parsedTemplate;
+        return &notCached;
+    }
+
+    m_templates.insert(std::make_pair(templateString, parsedTemplate));
+
+    return parsedTemplate;
+}
+
+/**
+ * @brief split a template into text-parts and value-names, if it only contains expressions with
+ *        a single value-name
+ *
+ * @param parsedTemplate reference for the result
+ * @param templateString template to parse
+ */
+void
+TemplateCache::parseTemplate(ParsedTemplate &parsedTemplate,
+                             const std::string &templateString)
+{
+    // statements and comments need the jinja2-converter
+    if(templateString.find("{%") != std::string::npos
+            || templateString.find("{#") != std::string::npos)
+    {
+        return;
+    }
+
+    uint64_t pos = 0;
+    while(true)
+    {
+        const uint64_t start = templateString.find("{{", pos);
+        if(start == std::string::npos) {
+            break;
+        }
+
+        const uint64_t end = templateString.find("}}", start + 2);
+        if(end == std::string::npos) {
+            return;
+        }
+
+        // trim the name of the value
+        const std::string expression = templateString.substr(start + 2, end - start - 2);
+        const uint64_t nameBegin = expression.find_first_not_of(' ');
+        if(nameBegin == std::string::npos) {
+            return;
+        }
+        const uint64_t nameEnd = expression.find_last_not_of(' ');
+        const std::string name = expression.substr(nameBegin, nameEnd - nameBegin + 1);
+
+        // filters, paths, operators and so on need the jinja2-converter
+        for(const char c : name)
+        {
+            if(std::isalnum(static_cast<unsigned char>(c)) == 0
+                    && c != '_')
+            {
+                return;
+            }
+        }
+
+        parsedTemplate.textParts.push_back(templateString.substr(pos, start - pos));
+        parsedTemplate.valueNames.push_back(name);
+        pos = end + 2;
+    }
+
+    parsedTemplate.textParts.push_back(templateString.substr(pos));
+    parsedTemplate.isSimple = true;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
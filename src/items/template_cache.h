@@ -0,0 +1,75 @@
+/**
+ * @file        template_cache.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_TEMPLATE_CACHE_H
+#define KITSUNEMIMI_SAKURA_LANG_TEMPLATE_CACHE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+
+namespace Kitsunemimi
+{
+class DataMap;
+
+namespace Sakura
+{
+
+/**
+ * Jinja2-template, which was split into its text-parts and the names of the values, which have
+ * to be inserted between these parts. Templates with other markers than simple value-names are
+ * not split and have to be converted by the jinja2-converter.
+ */
+struct ParsedTemplate
+{
+    bool isSimple = false;
+    std::vector<std::string> textParts;
+    std::vector<std::string> valueNames;
+};
+
+class TemplateCache
+{
+public:
+    static TemplateCache* getInstance();
+
+    bool render(std::string &result,
+                const std::string &templateString,
+                DataMap &insertValues);
+
+private:
+    TemplateCache();
+
+    static TemplateCache* m_instance;
+
+    std::mutex m_lock;
+    std::map<std::string, ParsedTemplate*> m_templates;
+
+    const ParsedTemplate* getTemplate(const std::string &templateString);
+    void parseTemplate(ParsedTemplate &parsedTemplate,
+                       const std::string &templateString);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_TEMPLATE_CACHE_H
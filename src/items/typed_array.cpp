@@ -0,0 +1,321 @@
+/**
+ * @file        typed_array.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+
+#include "typed_array.h"
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief constructor
+ */
+TypedArray::TypedArray() {}
+
+/**
+ * @brief destructor
+ */
+TypedArray::~TypedArray() {}
+
+/**
+ * @brief copy the entries of an array-item into a continuous buffer of their type. Strings are
+ *        stored one after another in a single buffer together with a table of their offsets.
+ *
+ * @param array array-item to convert
+ * @param mixNumbers true to allow int- and float-values together in one array, which are
+ *                   all converted into float-values in this case
+ *
+ * @return false, if the entries don't have all the same type, else true
+ */
+bool
+TypedArray::fromDataArray(DataArray* array,
+                          const bool mixNumbers)
+{
+    clear();
+
+    const ColumnType type = detectType(array, mixNumbers);
+    if(type == UNDEFINED_COLUMN) {
+        return false;
+    }
+
+    const uint64_t size = array->array.size();
+    switch(type)
+    {
+        //------------------------------------------------------------------------------------------
+        case INT_COLUMN:
+        {
+            m_intValues.resize(size);
+            for(uint64_t i = 0; i < size; i++) {
+                m_intValues[i] = array->array[i]->toValue()->getLong();
+            }
+            break;
+        }
+        //------------------------------------------------------------------------------------------
+        case FLOAT_COLUMN:
+        {
+            // mixed numbers have to be converted one by one. The int-values are kept additionally,
+            // because their conversion into float-values loses precision above 2^53
+            m_floatValues.resize(size);
+            for(uint64_t i = 0; i < size; i++)
+            {
+                DataValue* value = array->array[i]->toValue();
+                if(value->isIntValue())
+                {
+                    if(m_isIntValue.size() == 0)
+                    {
+                        m_isIntValue.resize(size, false);
+                        m_intValues.resize(size, 0);
+                    }
+                    m_isIntValue[i] = true;
+                    m_intValues[i] = value->getLong();
+                    m_floatValues[i] = static_cast<double>(m_intValues[i]);
+                }
+                else
+                {
+                    m_floatValues[i] = value->getDouble();
+                }
+            }
+            break;
+        }
+        //------------------------------------------------------------------------------------------
+        case BOOL_COLUMN:
+        {
+            m_boolValues.resize(size);
+            for(uint64_t i = 0; i < size; i++) {
+                m_boolValues[i] = array->array[i]->toValue()->getBool();
+            }
+            break;
+        }
+        //------------------------------------------------------------------------------------------
+        case STRING_COLUMN:
+        {
+            m_stringOffsets.resize(size + 1);
+            m_stringOffsets[0] = 0;
+            for(uint64_t i = 0; i < size; i++)
+            {
+                const char* text = array->array[i]->toValue()->content.stringValue;
+                m_stringBuffer.append(text, std::strlen(text));
+                m_stringOffsets[i + 1] = m_stringBuffer.size();
+            }
+            break;
+        }
+        //------------------------------------------------------------------------------------------
+        default:
+            break;
+    }
+
+    m_type = type;
+    m_size = size;
+
+    return true;
+}
+
+/**
+ * @brief get type of the buffer
+ *
+ * @return type of all entries
+ */
+TypedArray::ColumnType
+TypedArray::getType() const
+{
+    return m_type;
+}
+
+/**
+ * @brief get number of entries
+ *
+ * @return number of entries
+ */
+uint64_t
+TypedArray::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief get a string of a string-buffer without copy
+ *
+ * @param pos position of the entry
+ *
+ * @return view on the string within the buffer
+ */
+const std::string_view
+TypedArray::getString(const uint64_t pos) const
+{
+    const uint64_t start = m_stringOffsets[pos];
+    return std::string_view(m_stringBuffer.data() + start, m_stringOffsets[pos + 1] - start);
+}
+
+/**
+ * @brief compare an int-value exactly with a float-value
+ *
+ * @param intValue int-value to compare
+ * @param floatValue float-value to compare
+ *
+ * @return -1, if the int-value is smaller, 1 if it is bigger, else 0
+ */
+int
+compareIntWithFloat(const long intValue,
+                    const double floatValue)
+{
+    // NaN is unordered like in the comparison of float-values
+    if(std::isnan(floatValue)) {
+        return 0;
+    }
+
+    // float-values outside of the range of long are bigger or smaller than all int-values
+    const double limit = -static_cast<double>(std::numeric_limits<long>::min());
+    if(floatValue >= limit) {
+        return -1;
+    }
+    if(floatValue < -limit) {
+        return 1;
+    }
+
+    // compare the integral part as int-value and the remaining fraction afterwards
+    const long integralPart = static_cast<long>(floatValue);
+    if(intValue != integralPart) {
+        return (intValue > integralPart) - (intValue < integralPart);
+    }
+    const double fraction = floatValue - static_cast<double>(integralPart);
+    return (fraction < 0.0) - (fraction > 0.0);
+}
+
+/**
+ * @brief compare two entries of a float-buffer. Int-values of mixed numbers are compared with
+ *        their original value instead of the converted float-value.
+ *
+ * @param left position of the left entry
+ * @param right position of the right entry
+ *
+ * @return -1, if the left entry is smaller, 1 if it is bigger, else 0
+ */
+int
+TypedArray::compareNumbers(const uint64_t left,
+                           const uint64_t right) const
+{
+    const bool leftIsInt = m_isIntValue.size() > 0 && m_isIntValue[left];
+    const bool rightIsInt = m_isIntValue.size() > 0 && m_isIntValue[right];
+
+    if(leftIsInt
+            && rightIsInt)
+    {
+        const long leftNumber = m_intValues[left];
+        const long rightNumber = m_intValues[right];
+        return (leftNumber > rightNumber) - (leftNumber < rightNumber);
+    }
+    if(leftIsInt) {
+        return compareIntWithFloat(m_intValues[left], m_floatValues[right]);
+    }
+    if(rightIsInt) {
+        return -compareIntWithFloat(m_intValues[right], m_floatValues[left]);
+    }
+
+    const double leftNumber = m_floatValues[left];
+    const double rightNumber = m_floatValues[right];
+    return (leftNumber > rightNumber) - (leftNumber < rightNumber);
+}
+
+/**
+ * @brief get the common type of all entries of an array-item
+ *
+ * @param array array-item to check
+ * @param mixNumbers true to accept int- and float-values together
+ *
+ * @return type of all entries, or UNDEFINED_COLUMN, if they don't have the same type
+ */
+TypedArray::ColumnType
+TypedArray::detectType(DataArray* array,
+                       const bool mixNumbers) const
+{
+    if(array == nullptr) {
+        return UNDEFINED_COLUMN;
+    }
+
+    // empty arrays are handled like int-arrays
+    ColumnType result = INT_COLUMN;
+    for(uint64_t i = 0; i < array->array.size(); i++)
+    {
+        DataItem* entry = array->array[i];
+        ColumnType entryType = UNDEFINED_COLUMN;
+        if(entry->isIntValue()) {
+            entryType = INT_COLUMN;
+        } else if(entry->isFloatValue()) {
+            entryType = FLOAT_COLUMN;
+        } else if(entry->isBoolValue()) {
+            entryType = BOOL_COLUMN;
+        } else if(entry->isStringValue()) {
+            entryType = STRING_COLUMN;
+        } else {
+            return UNDEFINED_COLUMN;
+        }
+
+        if(i == 0
+                || entryType == result)
+        {
+            result = entryType;
+            continue;
+        }
+
+        // int- and float-values together result in a float-buffer
+        const bool isNumber = entryType == INT_COLUMN || entryType == FLOAT_COLUMN;
+        const bool resultIsNumber = result == INT_COLUMN || result == FLOAT_COLUMN;
+        if(mixNumbers
+                && isNumber
+                && resultIsNumber)
+        {
+            result = FLOAT_COLUMN;
+            continue;
+        }
+
+        return UNDEFINED_COLUMN;
+    }
+
+    return result;
+}
+
+/**
+ * @brief remove all entries
+ */
+void
+TypedArray::clear()
+{
+    m_intValues.clear();
+    m_floatValues.clear();
+    m_boolValues.clear();
+    m_stringBuffer.clear();
+    m_stringOffsets.clear();
+    m_isIntValue.clear();
+    m_type = UNDEFINED_COLUMN;
+    m_size = 0;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
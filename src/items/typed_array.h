@@ -0,0 +1,85 @@
+/**
+ * @file        typed_array.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_TYPED_ARRAY_H
+#define KITSUNEMIMI_SAKURA_LANG_TYPED_ARRAY_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Kitsunemimi
+{
+class DataArray;
+
+namespace Sakura
+{
+
+class TypedArray
+{
+public:
+    enum ColumnType
+    {
+        UNDEFINED_COLUMN = 0,
+        INT_COLUMN = 1,
+        FLOAT_COLUMN = 2,
+        BOOL_COLUMN = 3,
+        STRING_COLUMN = 4,
+    };
+
+    TypedArray();
+    ~TypedArray();
+
+    bool fromDataArray(DataArray* array,
+                       const bool mixNumbers = false);
+
+    // getter
+    ColumnType getType() const;
+    uint64_t size() const;
+    const std::string_view getString(const uint64_t pos) const;
+    int compareNumbers(const uint64_t left,
+                       const uint64_t right) const;
+
+    // internal buffers, where only the buffer of the column-type is used
+    std::vector<long> m_intValues;
+    std::vector<double> m_floatValues;
+    std::vector<bool> m_boolValues;
+    std::string m_stringBuffer;
+    std::vector<uint64_t> m_stringOffsets;
+
+    // positions of the int-values within mixed numbers, which are also in the int-buffer
+    std::vector<bool> m_isIntValue;
+
+private:
+    ColumnType m_type = UNDEFINED_COLUMN;
+    uint64_t m_size = 0;
+
+    ColumnType detectType(DataArray* array,
+                          const bool mixNumbers) const;
+    void clear();
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_TYPED_ARRAY_H
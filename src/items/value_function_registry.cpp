@@ -0,0 +1,691 @@
+/**
+ * @file        value_function_registry.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "value_function_registry.h"
+
+#include <items/value_items.h>
+#include <items/value_item_functions.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+// created at startup, because trees can be loaded by multiple threads at once
+ValueFunctionRegistry* ValueFunctionRegistry::m_instance = new ValueFunctionRegistry();
+
+//==================================================================================================
+// wrapper for the builtin functions
+//==================================================================================================
+
+DataItem*
+callGet(DataItem* item,
+        const std::vector<DataItem*> &arguments,
+        ErrorContainer &error)
+{
+    return getValue(item, arguments.at(0)->toValue(), error);
+}
+
+DataItem*
+callSplit(DataItem* item,
+          const std::vector<DataItem*> &arguments,
+          ErrorContainer &error)
+{
+    return splitValue(item->toValue(), arguments.at(0)->toValue(), error);
+}
+
+DataItem*
+callFileLines(DataItem* item,
+              const std::vector<DataItem*> &,
+              ErrorContainer &error)
+{
+    return fileLines(item->toValue(), error);
+}
+
+DataItem*
+callFileChunks(DataItem* item,
+               const std::vector<DataItem*> &arguments,
+               ErrorContainer &error)
+{
+    return fileChunks(item->toValue(), arguments.at(0)->toValue(), error);
+}
+
+DataItem*
+callContains(DataItem* item,
+             const std::vector<DataItem*> &arguments,
+             ErrorContainer &error)
+{
+    return containsValue(item, arguments.at(0)->toValue(), error);
+}
+
+DataItem*
+callSize(DataItem* item,
+         const std::vector<DataItem*> &,
+         ErrorContainer &error)
+{
+    return sizeValue(item, error);
+}
+
+DataItem*
+callInsert(DataItem* item,
+           const std::vector<DataItem*> &arguments,
+           ErrorContainer &error)
+{
+    return insertValue(item->toMap(), arguments.at(0)->toValue(), arguments.at(1), error);
+}
+
+DataItem*
+callAppend(DataItem* item,
+           const std::vector<DataItem*> &arguments,
+           ErrorContainer &error)
+{
+    return appendValue(item->toArray(), arguments.at(0), error);
+}
+
+DataItem*
+callClearEmpty(DataItem* item,
+               const std::vector<DataItem*> &,
+               ErrorContainer &error)
+{
+    return clearEmpty(item->toArray(), error);
+}
+
+DataItem*
+callParseJson(DataItem* item,
+              const std::vector<DataItem*> &,
+              ErrorContainer &error)
+{
+    return parseJson(item->toValue(), error);
+}
+
+DataItem*
+callSort(DataItem* item,
+         const std::vector<DataItem*> &,
+         ErrorContainer &error)
+{
+    return sortValues(item->toArray(), error);
+}
+
+DataItem*
+callUnique(DataItem* item,
+           const std::vector<DataItem*> &,
+           ErrorContainer &error)
+{
+    return uniqueValues(item->toArray(), error);
+}
+
+DataItem*
+callZip(DataItem* item,
+        const std::vector<DataItem*> &arguments,
+        ErrorContainer &error)
+{
+    return zipValues(item->toArray(), arguments.at(0)->toArray(), error);
+}
+
+DataItem*
+callFlatten(DataItem* item,
+            const std::vector<DataItem*> &,
+            ErrorContainer &error)
+{
+    return flattenValues(item->toArray(), error);
+}
+
+DataItem*
+callTake(DataItem* item,
+         const std::vector<DataItem*> &arguments,
+         ErrorContainer &error)
+{
+    uint64_t start = 0;
+    uint64_t end = 0;
+    const FunctionItem::SpecialType type = FunctionItem::TAKE_TYPE;
+    if(getSliceRange(start, end, type, arguments, item->size(), error) == false) {
+        return nullptr;
+    }
+    return sliceValues(item->toArray(), start, end);
+}
+
+DataItem*
+callSkip(DataItem* item,
+         const std::vector<DataItem*> &arguments,
+         ErrorContainer &error)
+{
+    uint64_t start = 0;
+    uint64_t end = 0;
+    const FunctionItem::SpecialType type = FunctionItem::SKIP_TYPE;
+    if(getSliceRange(start, end, type, arguments, item->size(), error) == false) {
+        return nullptr;
+    }
+    return sliceValues(item->toArray(), start, end);
+}
+
+DataItem*
+callSlice(DataItem* item,
+          const std::vector<DataItem*> &arguments,
+          ErrorContainer &error)
+{
+    uint64_t start = 0;
+    uint64_t end = 0;
+    const FunctionItem::SpecialType type = FunctionItem::SLICE_TYPE;
+    if(getSliceRange(start, end, type, arguments, item->size(), error) == false) {
+        return nullptr;
+    }
+    return sliceValues(item->toArray(), start, end);
+}
+
+DataItem*
+callSum(DataItem* item,
+        const std::vector<DataItem*> &,
+        ErrorContainer &error)
+{
+    return sumValues(item->toArray(), error);
+}
+
+DataItem*
+callMin(DataItem* item,
+        const std::vector<DataItem*> &,
+        ErrorContainer &error)
+{
+    return extremeValue(item->toArray(), false, error);
+}
+
+DataItem*
+callMax(DataItem* item,
+        const std::vector<DataItem*> &,
+        ErrorContainer &error)
+{
+    return extremeValue(item->toArray(), true, error);
+}
+
+DataItem*
+callAvg(DataItem* item,
+        const std::vector<DataItem*> &,
+        ErrorContainer &error)
+{
+    return avgValue(item->toArray(), error);
+}
+
+DataItem*
+callPercentile(DataItem* item,
+               const std::vector<DataItem*> &arguments,
+               ErrorContainer &error)
+{
+    return percentileValue(item->toArray(), arguments.at(0)->toValue(), error);
+}
+
+DataItem*
+callMap(DataItem* item,
+        const ExpressionItem &lambda,
+        const std::vector<DataItem*> &,
+        DataMap &insertValues,
+        ErrorContainer &error)
+{
+    return mapValues(item->toArray(), lambda, insertValues, error);
+}
+
+DataItem*
+callFilter(DataItem* item,
+           const ExpressionItem &lambda,
+           const std::vector<DataItem*> &,
+           DataMap &insertValues,
+           ErrorContainer &error)
+{
+    return filterValues(item->toArray(), lambda, insertValues, error);
+}
+
+DataItem*
+callCountIf(DataItem* item,
+            const ExpressionItem &lambda,
+            const std::vector<DataItem*> &,
+            DataMap &insertValues,
+            ErrorContainer &error)
+{
+    return countIfValues(item->toArray(), lambda, insertValues, error);
+}
+
+DataItem*
+callReduce(DataItem* item,
+           const ExpressionItem &lambda,
+           const std::vector<DataItem*> &arguments,
+           DataMap &insertValues,
+           ErrorContainer &error)
+{
+    return reduceValues(item->toArray(), lambda, arguments.at(0), insertValues, error);
+}
+
+//==================================================================================================
+// ValueFunctionRegistry
+//==================================================================================================
+
+/**
+ * @brief constructor, which registers all builtin functions
+ */
+ValueFunctionRegistry::ValueFunctionRegistry()
+{
+    addBuiltinFunction("get",
+                       callGet,
+                       SAKURA_UNDEFINED_TYPE,
+                       {SAKURA_UNDEFINED_TYPE});
+    addBuiltinFunction("split",
+                       callSplit,
+                       SAKURA_UNDEFINED_TYPE,
+                       {SAKURA_UNDEFINED_TYPE});
+    addBuiltinFunction("file_lines",
+                       callFileLines,
+                       SAKURA_STRING_TYPE,
+                       {});
+    addBuiltinFunction("file_chunks",
+                       callFileChunks,
+                       SAKURA_STRING_TYPE,
+                       {SAKURA_INT_TYPE});
+    addBuiltinFunction("contains",
+                       callContains,
+                       SAKURA_UNDEFINED_TYPE,
+                       {SAKURA_UNDEFINED_TYPE});
+    addBuiltinFunction("size",
+                       callSize,
+                       SAKURA_UNDEFINED_TYPE,
+                       {});
+    addBuiltinFunction("insert",
+                       callInsert,
+                       SAKURA_UNDEFINED_TYPE,
+                       {SAKURA_UNDEFINED_TYPE, SAKURA_UNDEFINED_TYPE});
+    addBuiltinFunction("append",
+                       callAppend,
+                       SAKURA_UNDEFINED_TYPE,
+                       {SAKURA_UNDEFINED_TYPE});
+    addBuiltinFunction("clear_empty",
+                       callClearEmpty,
+                       SAKURA_UNDEFINED_TYPE,
+                       {});
+    addBuiltinFunction("parse_json",
+                       callParseJson,
+                       SAKURA_UNDEFINED_TYPE,
+                       {});
+    addBuiltinFunction("sort",
+                       callSort,
+                       SAKURA_ARRAY_TYPE,
+                       {});
+    addBuiltinFunction("unique",
+                       callUnique,
+                       SAKURA_ARRAY_TYPE,
+                       {});
+    addBuiltinFunction("zip",
+                       callZip,
+                       SAKURA_ARRAY_TYPE,
+                       {SAKURA_ARRAY_TYPE});
+    addBuiltinFunction("flatten",
+                       callFlatten,
+                       SAKURA_ARRAY_TYPE,
+                       {});
+    addBuiltinFunction("take",
+                       callTake,
+                       SAKURA_ARRAY_TYPE,
+                       {SAKURA_INT_TYPE});
+    addBuiltinFunction("skip",
+                       callSkip,
+                       SAKURA_ARRAY_TYPE,
+                       {SAKURA_INT_TYPE});
+    addBuiltinFunction("slice",
+                       callSlice,
+                       SAKURA_ARRAY_TYPE,
+                       {SAKURA_INT_TYPE, SAKURA_INT_TYPE});
+    addBuiltinFunction("sum",
+                       callSum,
+                       SAKURA_ARRAY_TYPE,
+                       {});
+    addBuiltinFunction("min",
+                       callMin,
+                       SAKURA_ARRAY_TYPE,
+                       {});
+    addBuiltinFunction("max",
+                       callMax,
+                       SAKURA_ARRAY_TYPE,
+                       {});
+    addBuiltinFunction("avg",
+                       callAvg,
+                       SAKURA_ARRAY_TYPE,
+                       {});
+    addBuiltinFunction("percentile",
+                       callPercentile,
+                       SAKURA_ARRAY_TYPE,
+                       {SAKURA_UNDEFINED_TYPE});
+
+    addLambdaFunction("map", callMap, 1, {});
+    addLambdaFunction("filter", callFilter, 1, {});
+    addLambdaFunction("reduce", callReduce, 2, {SAKURA_UNDEFINED_TYPE});
+    addLambdaFunction("count_if", callCountIf, 1, {});
+
+    // builtin functions, which are processed differently in combination with others
+    m_specialTypes["parse_json"] = FunctionItem::PARSE_JSON_TYPE;
+    m_specialTypes["get"] = FunctionItem::GET_TYPE;
+    m_specialTypes["take"] = FunctionItem::TAKE_TYPE;
+    m_specialTypes["skip"] = FunctionItem::SKIP_TYPE;
+    m_specialTypes["slice"] = FunctionItem::SLICE_TYPE;
+    m_specialTypes["contains"] = FunctionItem::CONTAINS_TYPE;
+    m_specialTypes["split"] = FunctionItem::SPLIT_TYPE;
+    m_specialTypes["file_lines"] = FunctionItem::FILE_LINES_TYPE;
+    m_specialTypes["file_chunks"] = FunctionItem::FILE_CHUNKS_TYPE;
+}
+
+/**
+ * @brief static methode to get instance of the registry
+ *
+ * @return pointer to the static instance
+ */
+ValueFunctionRegistry*
+ValueFunctionRegistry::getInstance()
+{
+    return m_instance;
+}
+
+/**
+ * @brief register a new value-function
+ *
+ * @param name name of the function, which is used to call the function within a sakura-file
+ * @param definition definition with function-pointer and expected types
+ *
+ * @return false, if name is already registered or the function-pointer is invalid, else true
+ */
+bool
+ValueFunctionRegistry::addFunction(const std::string &name,
+                                   const ValueFunctionDef &definition)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if(definition.function == nullptr
+            || m_lambdaFunctions.count(name) > 0)
+    {
+        return false;
+    }
+
+    return m_functions.insert(std::make_pair(name, definition)).second;
+}
+
+/**
+ * @brief get a registered value-function
+ *
+ * @param name name of the function
+ *
+ * @return pointer to the definition of the function, or nullptr, if not found
+ */
+const ValueFunctionDef*
+ValueFunctionRegistry::getFunction(const std::string &name) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    // the definitions are never removed and the map doesn't move them while inserting new ones,
+    // so the returned pointer stays valid without the lock
+    std::map<std::string, ValueFunctionDef>::const_iterator it;
+    it = m_functions.find(name);
+    if(it != m_functions.end()) {
+        return &it->second;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief get a registered function, which is called with a lambda
+ *
+ * @param name name of the function
+ *
+ * @return pointer to the definition of the function, or nullptr, if not found
+ */
+const LambdaFunctionDef*
+ValueFunctionRegistry::getLambdaFunction(const std::string &name) const
+{
+    std::map<std::string, LambdaFunctionDef>::const_iterator it;
+    it = m_lambdaFunctions.find(name);
+    if(it != m_lambdaFunctions.end()) {
+        return &it->second;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief resolve the function of a function-call and check the number of arguments, so this
+ *        has to be done only once while loading instead of with each call
+ *
+ * @param functionItem function-call to resolve
+ * @param error reference for error-output
+ *
+ * @return false, if function doesn't exist or has a different number of arguments, else true
+ */
+bool
+ValueFunctionRegistry::resolveFunction(FunctionItem &functionItem,
+                                       ErrorContainer &error) const
+{
+    const LambdaFunctionDef* lambdaDefinition = getLambdaFunction(functionItem.type);
+    if(lambdaDefinition != nullptr) {
+        return resolveLambdaFunction(functionItem, lambdaDefinition, error);
+    }
+
+    const ValueFunctionDef* definition = getFunction(functionItem.type);
+    if(definition == nullptr)
+    {
+        error.addMeesage("unknown function: " + functionItem.type);
+        return false;
+    }
+
+    if(functionItem.arguments.size() > 0
+            && functionItem.arguments.front().expression != nullptr
+            && functionItem.arguments.front().expression->parameters.size() > 0)
+    {
+        error.addMeesage(functionItem.type + "-function can not be called with a lambda");
+        return false;
+    }
+
+    const uint64_t numberOfArguments = definition->argumentTypes.size();
+    if(functionItem.arguments.size() != numberOfArguments)
+    {
+        std::string message = functionItem.type + "-function requires ";
+        message += std::to_string(numberOfArguments);
+        message += numberOfArguments == 1 ? " argument" : " arguments";
+        error.addMeesage(message);
+        return false;
+    }
+
+    functionItem.definition = definition;
+    functionItem.specialType = getSpecialType(functionItem.type);
+
+    return true;
+}
+
+/**
+ * @brief get the special type of a builtin function, which is processed differently, if it is
+ *        combined with the value or other functions
+ *
+ * @param name name of the function
+ *
+ * @return special type or NO_SPECIAL_TYPE, if the function is always processed normally
+ */
+FunctionItem::SpecialType
+ValueFunctionRegistry::getSpecialType(const std::string &name) const
+{
+    std::map<std::string, FunctionItem::SpecialType>::const_iterator it;
+    it = m_specialTypes.find(name);
+    if(it != m_specialTypes.end()) {
+        return it->second;
+    }
+
+    return FunctionItem::NO_SPECIAL_TYPE;
+}
+
+/**
+ * @brief resolve a function-call with a lambda and check the lambda and the other arguments
+ *
+ * @param functionItem function-call to resolve
+ * @param definition definition of the function
+ * @param error reference for error-output
+ *
+ * @return false, if the call doesn't match the definition, else true
+ */
+bool
+ValueFunctionRegistry::resolveLambdaFunction(FunctionItem &functionItem,
+                                             const LambdaFunctionDef* definition,
+                                             ErrorContainer &error) const
+{
+    if(functionItem.arguments.size() == 0
+            || functionItem.arguments.front().expression == nullptr
+            || functionItem.arguments.front().expression->parameters.size() == 0)
+    {
+        error.addMeesage(functionItem.type + "-function requires a lambda as first argument");
+        return false;
+    }
+
+    const uint64_t numberOfParameters = definition->numberOfParameters;
+    if(functionItem.arguments.front().expression->parameters.size() != numberOfParameters)
+    {
+        std::string message = "lambda of the " + functionItem.type + "-function requires ";
+        message += std::to_string(numberOfParameters);
+        message += numberOfParameters == 1 ? " parameter" : " parameters";
+        error.addMeesage(message);
+        return false;
+    }
+
+    const uint64_t numberOfArguments = definition->argumentTypes.size() + 1;
+    if(functionItem.arguments.size() != numberOfArguments)
+    {
+        std::string message = functionItem.type + "-function requires ";
+        message += std::to_string(numberOfArguments);
+        message += numberOfArguments == 1 ? " argument" : " arguments";
+        error.addMeesage(message);
+        return false;
+    }
+
+    functionItem.lambdaDefinition = definition;
+
+    return true;
+}
+
+/**
+ * @brief resolve all function-calls of a value-item, including its arguments and expressions
+ *
+ * @param valueItem value-item to process
+ * @param error reference for error-output
+ *
+ * @return false, if at least one function-call can not be resolved, else true
+ */
+bool
+ValueFunctionRegistry::resolveFunctions(ValueItem &valueItem,
+                                        ErrorContainer &error) const
+{
+    if(valueItem.expression != nullptr
+            && resolveFunctions(*valueItem.expression, error) == false)
+    {
+        return false;
+    }
+
+    for(FunctionItem &functionItem : valueItem.functions)
+    {
+        for(ValueItem &argument : functionItem.arguments)
+        {
+            if(resolveFunctions(argument, error) == false) {
+                return false;
+            }
+        }
+
+        if(resolveFunction(functionItem, error) == false) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief resolve all function-calls within the operands of an expression
+ *
+ * @param expression expression to process
+ * @param error reference for error-output
+ *
+ * @return false, if at least one function-call can not be resolved, else true
+ */
+bool
+ValueFunctionRegistry::resolveFunctions(ExpressionItem &expression,
+                                        ErrorContainer &error) const
+{
+    if(resolveFunctions(expression.value, error) == false) {
+        return false;
+    }
+
+    if(expression.left != nullptr
+            && resolveFunctions(*expression.left, error) == false)
+    {
+        return false;
+    }
+
+    if(expression.right != nullptr
+            && resolveFunctions(*expression.right, error) == false)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief register a builtin function
+ *
+ * @param name name of the function
+ * @param function pointer to the function
+ * @param inputType expected type of the value
+ * @param argumentTypes expected types of the arguments
+ */
+void
+ValueFunctionRegistry::addBuiltinFunction(const std::string &name,
+                                          ValueFunction function,
+                                          const FieldType inputType,
+                                          const std::vector<FieldType> &argumentTypes)
+{
+    ValueFunctionDef definition;
+    definition.function = function;
+    definition.inputType = inputType;
+    definition.argumentTypes = argumentTypes;
+    addFunction(name, definition);
+}
+
+/**
+ * @brief register a builtin function, which is called with a lambda
+ *
+ * @param name name of the function
+ * @param function pointer to the function
+ * @param numberOfParameters number of parameters of the lambda
+ * @param argumentTypes expected types of the arguments after the lambda
+ */
+void
+ValueFunctionRegistry::addLambdaFunction(const std::string &name,
+                                         LambdaFunction function,
+                                         const uint64_t numberOfParameters,
+                                         const std::vector<FieldType> &argumentTypes)
+{
+    LambdaFunctionDef definition;
+    definition.function = function;
+    definition.inputType = SAKURA_ARRAY_TYPE;
+    definition.numberOfParameters = numberOfParameters;
+    definition.argumentTypes = argumentTypes;
+    m_lambdaFunctions.insert(std::make_pair(name, definition));
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
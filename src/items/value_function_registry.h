@@ -0,0 +1,108 @@
+/**
+ * @file        value_function_registry.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_VALUE_FUNCTION_REGISTRY_H
+#define KITSUNEMIMI_SAKURA_LANG_VALUE_FUNCTION_REGISTRY_H
+
+#include <string>
+#include <map>
+#include <mutex>
+
+#include <libKitsunemimiCommon/logger.h>
+#include <libKitsunemimiSakuraLang/structs.h>
+#include <items/value_items.h>
+
+namespace Kitsunemimi
+{
+class DataMap;
+
+namespace Sakura
+{
+
+/**
+ * Function, which is called with a lambda as first argument. The lambda is not evaluated
+ * before the call, but by the function itself for each entry of the value.
+ */
+typedef DataItem* (*LambdaFunction)(DataItem* item,
+                                    const ExpressionItem &lambda,
+                                    const std::vector<DataItem*> &arguments,
+                                    DataMap &insertValues,
+                                    ErrorContainer &error);
+
+struct LambdaFunctionDef
+{
+    LambdaFunction function = nullptr;
+
+    // expected type of the value, number of parameters of the lambda and expected types of the
+    // arguments after the lambda
+    FieldType inputType = SAKURA_UNDEFINED_TYPE;
+    uint64_t numberOfParameters = 1;
+    std::vector<FieldType> argumentTypes;
+};
+
+class ValueFunctionRegistry
+{
+public:
+    static ValueFunctionRegistry* getInstance();
+
+    bool addFunction(const std::string &name,
+                     const ValueFunctionDef &definition);
+    const ValueFunctionDef* getFunction(const std::string &name) const;
+    const LambdaFunctionDef* getLambdaFunction(const std::string &name) const;
+
+    bool resolveFunction(FunctionItem &functionItem,
+                         ErrorContainer &error) const;
+    bool resolveFunctions(ValueItem &valueItem,
+                          ErrorContainer &error) const;
+    bool resolveFunctions(ExpressionItem &expression,
+                          ErrorContainer &error) const;
+
+private:
+    ValueFunctionRegistry();
+
+    static ValueFunctionRegistry* m_instance;
+
+    // only the value-functions can be registered after the creation of the registry, so the
+    // other maps are not protected by the lock
+    mutable std::mutex m_lock;
+    std::map<std::string, ValueFunctionDef> m_functions;
+    std::map<std::string, LambdaFunctionDef> m_lambdaFunctions;
+    std::map<std::string, FunctionItem::SpecialType> m_specialTypes;
+
+    void addBuiltinFunction(const std::string &name,
+                            ValueFunction function,
+                            const FieldType inputType,
+                            const std::vector<FieldType> &argumentTypes);
+    void addLambdaFunction(const std::string &name,
+                           LambdaFunction function,
+                           const uint64_t numberOfParameters,
+                           const std::vector<FieldType> &argumentTypes);
+    FunctionItem::SpecialType getSpecialType(const std::string &name) const;
+    bool resolveLambdaFunction(FunctionItem &functionItem,
+                               const LambdaFunctionDef* definition,
+                               ErrorContainer &error) const;
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_VALUE_FUNCTION_REGISTRY_H
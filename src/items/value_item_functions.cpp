@@ -22,12 +22,18 @@
 
 #include "value_item_functions.h"
 
-#include <libKitsunemimiCommon/methods/string_methods.h>
-#include <libKitsunemimiCommon/items/data_items.h>
+#include <items/expression_methods.h>
+#include <items/typed_array.h>
+#include <items/json_reader.h>
+
+#include <libKitsunemimiSakuraLang/sakura_lang_interface.h>
 
-#include <libKitsunemimiJson/json_item.h>
+#include <libKitsunemimiCommon/items/data_items.h>
+#include <libKitsunemimiCommon/buffer/data_buffer.h>
 
-using Kitsunemimi::splitStringByDelimiter;
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace Kitsunemimi
 {
@@ -99,6 +105,93 @@ getValue(DataItem* item,
     return nullptr;
 }
 
+/**
+ * @brief get the next part of a string, which is splitted by a delimiter. The delimiter is
+ *        searched with the search-functions of std::string_view, which are based on the
+ *        vectorized memchr and memcmp of the libc. Like before, a delimiter at the end of the
+ *        string doesn't create an empty part at the end.
+ *
+ * @param part reference for the next part, which is a view on the string
+ * @param pos reference for the position within the string, which is moved behind the part
+ * @param text string, which should be splitted
+ * @param delimiter non-empty delimiter, which can have multiple characters
+ *
+ * @return false, if the end of the string was reached, else true
+ */
+bool
+getNextSplitPart(std::string_view &part,
+                 uint64_t &pos,
+                 const std::string_view &text,
+                 const std::string_view &delimiter)
+{
+    if(pos >= text.size()) {
+        return false;
+    }
+
+    uint64_t found = 0;
+    if(delimiter.size() == 1) {
+        found = text.find(delimiter.front(), pos);
+    } else {
+        found = text.find(delimiter, pos);
+    }
+
+    if(found == std::string_view::npos)
+    {
+        part = text.substr(pos);
+        pos = text.size();
+        return true;
+    }
+
+    part = text.substr(pos, found - pos);
+    pos = found + delimiter.size();
+
+    return true;
+}
+
+/**
+ * @brief split a string into an array of string-values
+ *
+ * @param result array-item, where the parts should be appended
+ * @param text string, which should be splitted
+ * @param delimiter delimiter, which can have multiple characters
+ */
+void
+splitString(DataArray &result,
+            const std::string_view &text,
+            const std::string_view &delimiter)
+{
+    uint64_t pos = 0;
+    std::string_view part;
+    while(getNextSplitPart(part, pos, text, delimiter)) {
+        result.append(new DataValue(std::string(part)));
+    }
+}
+
+/**
+ * @brief get the delimiter for a split of a string
+ *
+ * @param result reference for the delimiter
+ * @param delimiter value with the delimiter of the function-call
+ *
+ * @return false, if the delimiter is empty, else true
+ */
+bool
+getSplitDelimiter(std::string &result,
+                  DataValue* delimiter)
+{
+    result = delimiter->toString();
+    if(result.size() == 0) {
+        return false;
+    }
+
+    // handle line-break as special rule
+    if(result == "\\n") {
+        result = "\n";
+    }
+
+    return true;
+}
+
 /**
  * @brief splitValue split a value-item by a delimiter
  *
@@ -122,26 +215,130 @@ splitValue(DataValue* item,
     }
 
     // get and check delimiter-string
-    const std::string delimiterString = delimiter->toString();
-    if(delimiterString.size() == 0) {
+    std::string delimiterString = "";
+    if(getSplitDelimiter(delimiterString, delimiter) == false)
+    {
+        error.addMeesage("delimiter for the split-function is empty");
         return nullptr;
     }
 
-    // get first character as delimiter and handle line-break as special rule
-    char demilimter = delimiterString.at(0);
-    if(delimiterString == "\\n") {
-        demilimter = '\n';
+    // split string into string-array without copy of the original string
+    DataArray* resultArray = new DataArray();
+    if(item->getValueType() == DataItem::STRING_TYPE)
+    {
+        splitString(*resultArray, item->content.stringValue, delimiterString);
+    }
+    else
+    {
+        const std::string text = item->toString();
+        splitString(*resultArray, text, delimiterString);
+    }
+
+    return resultArray;
+}
+
+/**
+ * @brief get the content of a file of the garden as text without copy
+ *
+ * @param text reference for the content of the file
+ * @param fileId value with the id of the file
+ * @param error reference for error-output
+ *
+ * @return false, if the file doesn't exist, else true
+ */
+bool
+getFileText(std::string_view &text,
+            DataValue* fileId,
+            ErrorContainer &error)
+{
+    const std::string id = fileId->toString();
+    DataBuffer* file = SakuraLangInterface::getInstance()->getFile(id);
+    if(file == nullptr)
+    {
+        error.addMeesage("file with id '" + id + "' doesn't exist");
+        return false;
+    }
+
+    text = std::string_view(static_cast<const char*>(file->data), file->usedBufferSize);
+
+    return true;
+}
+
+/**
+ * @brief get and check the size of chunks of the file_chunks-function
+ *
+ * @param chunkSize reference for the size of the chunks
+ * @param value value of the function-call
+ * @param error reference for error-output
+ *
+ * @return false, if the size is not a positive int-value, else true
+ */
+bool
+getChunkSize(uint64_t &chunkSize,
+             DataValue* value,
+             ErrorContainer &error)
+{
+    if(value == nullptr
+            || value->isIntValue() == false
+            || value->getLong() <= 0)
+    {
+        error.addMeesage("input for the file_chunks-function must be a positive int-value");
+        return false;
     }
 
-    // split string into string-array
-    std::vector<std::string> splittedContent;
-    splitStringByDelimiter(splittedContent, item->toString(), demilimter);
+    chunkSize = static_cast<uint64_t>(value->getLong());
+
+    return true;
+}
+
+/**
+ * @brief split a file of the garden into its lines
+ *
+ * @param fileId value with the id of the file
+ * @param error reference for error-output
+ *
+ * @return array-item with the lines of the file
+ */
+DataArray*
+fileLines(DataValue* fileId,
+          ErrorContainer &error)
+{
+    std::string_view text;
+    if(getFileText(text, fileId, error) == false) {
+        return nullptr;
+    }
 
-    // convert string-array into a DataArray-object
     DataArray* resultArray = new DataArray();
-    for(const std::string& object : splittedContent)
+    splitString(*resultArray, text, "\n");
+
+    return resultArray;
+}
+
+/**
+ * @brief split a file of the garden into chunks of the same size
+ *
+ * @param fileId value with the id of the file
+ * @param chunkSize value with the size of the chunks
+ * @param error reference for error-output
+ *
+ * @return array-item with the chunks of the file
+ */
+DataArray*
+fileChunks(DataValue* fileId,
+           DataValue* chunkSize,
+           ErrorContainer &error)
+{
+    std::string_view text;
+    uint64_t size = 0;
+    if(getFileText(text, fileId, error) == false
+            || getChunkSize(size, chunkSize, error) == false)
     {
-        resultArray->append(new DataValue(object));
+        return nullptr;
+    }
+
+    DataArray* resultArray = new DataArray();
+    for(uint64_t pos = 0; pos < text.size(); pos += size) {
+        resultArray->append(new DataValue(std::string(text.substr(pos, size))));
     }
 
     return resultArray;
@@ -204,11 +401,19 @@ containsValue(DataItem* item,
     // in case, that the item is an array
     if(item->isArray())
     {
-        // iterate over the array in interprete all as string for easier comparing
+        // compare values of the same type directly without converting them into strings. Only
+        // values of different types are compared by their string-representation like before.
         DataArray* tempArray = item->toArray();
+        ErrorContainer compareError;
         for(uint32_t i = 0; i < tempArray->size(); i++)
         {
-            if(tempArray->get(i)->toString() == key->toString()) {
+            bool isEqual = false;
+            compareValues(isEqual,
+                          tempArray->get(i),
+                          key,
+                          ExpressionItem::EQUAL_EXPRESSION,
+                          compareError);
+            if(isEqual) {
                 return new DataValue(true);
             }
         }
@@ -219,6 +424,15 @@ containsValue(DataItem* item,
     // in case, that the item is a value
     if(item->isValue())
     {
+        // search substring without copy of the strings
+        DataValue* value = item->toValue();
+        if(value->getValueType() == DataItem::STRING_TYPE
+                && key->getValueType() == DataItem::STRING_TYPE)
+        {
+            const std::string_view text(value->content.stringValue);
+            return new DataValue(text.find(key->content.stringValue) != std::string_view::npos);
+        }
+
         // interprete this value as string and check if the substring exist in it
         if (item->toString().find(key->toString()) != std::string::npos) {
             return new DataValue(true);
@@ -231,6 +445,11 @@ containsValue(DataItem* item,
     return nullptr;
 }
 
+//==================================================================================================
+// The following functions modify and return the given item in-place, because it is owned by the
+// value-item of the caller.
+//==================================================================================================
+
 /**
  * @brief add a new object to an existing DataArray-object
  *
@@ -238,7 +457,7 @@ containsValue(DataItem* item,
  * @param value data-item, which should be added
  * @param error reference for error-output
  *
- * @return copy of the original array-item together with the new added object
+ * @return the original array-item together with the new added object
  */
 DataArray*
 appendValue(DataArray* item,
@@ -259,11 +478,10 @@ appendValue(DataArray* item,
         return nullptr;
     }
 
-    // add oject to the map
-    DataArray* result = item->copy()->toArray();
-    result->append(value->copy());
+    // add oject to the array
+    item->append(value->copy());
 
-    return result;
+    return item;
 }
 
 /**
@@ -274,7 +492,7 @@ appendValue(DataArray* item,
  * @param value value of the new pair
  * @param error reference for error-output
  *
- * @return copy of the original map-item together with the new added pair
+ * @return the original map-item together with the new added pair
  */
 DataMap*
 insertValue(DataMap* item,
@@ -298,11 +516,9 @@ insertValue(DataMap* item,
     }
 
     // insert new key-value-pair
-    const std::string keyString = key->toString();
-    DataMap* result = item->copy()->toMap();
-    result->insert(key->toString(), value->copy(), true);
+    item->insert(key->toString(), value->copy(), true);
 
-    return result;
+    return item;
 }
 
 
@@ -312,7 +528,7 @@ insertValue(DataMap* item,
  * @param item array-item, which shluld be cleared
  * @param error reference for error-output
  *
- * @return copy of the original array-item together with the new added object
+ * @return the original array-item without the empty entries
  */
 DataArray*
 clearEmpty(DataArray* item,
@@ -331,48 +547,1038 @@ clearEmpty(DataArray* item,
         return nullptr;
     }
 
-    // add oject to the map
-    DataArray* result = item->copy()->toArray();
-    for(uint32_t i = 0; i < result->size(); i++)
+    // remove empty entries
+    for(uint32_t i = 0; i < item->size(); i++)
     {
-        if(result->get(i)->toString() == "")
+        if(item->get(i)->toString() == "")
         {
-            result->remove(i);
+            item->remove(i);
             i--;
         }
     }
 
-    return result;
+    return item;
 }
 
 /**
- * @brief parse a json-formated string into a data-item
+ * @brief replace each entry of an array-item by the result of a lambda
  *
- * @param intput input-value with the json-formated content
+ * @param item array-item, which should be transformed
+ * @param lambda lambda with one parameter, which gets the entry
+ * @param insertValues data-map with all other values, which can be used within the lambda
  * @param error reference for error-output
  *
- * @return nullptr, if failed, else a data-item with the parsed content
+ * @return the original array-item with the transformed entries
  */
-DataItem*
-parseJson(DataValue* intput,
+DataArray*
+mapValues(DataArray* item,
+          const ExpressionItem &lambda,
+          DataMap &insertValues,
           ErrorContainer &error)
 {
     // precheck
-    if(intput == nullptr)
+    if(item == nullptr)
     {
-        error.addMeesage("inputs for size-function are invalid");
+        error.addMeesage("inputs for map-function are invalid");
         return nullptr;
     }
 
-    // try to parse json
-    Kitsunemimi::Json::JsonItem jsonItem;
-    if(jsonItem.parse(intput->toString(), error))
+    // replace entries
+    ExpressionItem expression = lambda;
+    for(uint64_t i = 0; i < item->array.size(); i++)
     {
-        DataItem* resultItem = jsonItem.getItemContent()->copy();
-        return resultItem;
+        DataItem* result = evaluateLambda(expression,
+                                          lambda,
+                                          {item->array[i]},
+                                          insertValues,
+                                          error);
+        if(result == nullptr)
+        {
+            error.addMeesage("failed to process entry " + std::to_string(i) + " in map-function");
+            return nullptr;
+        }
+
+        delete item->array[i];
+        item->array[i] = result;
     }
 
-    return nullptr;
+    return item;
+}
+
+/**
+ * @brief remove all entries of an array-item, for which a lambda doesn't return true
+ *
+ * @param item array-item, which should be filtered
+ * @param lambda lambda with one parameter, which gets the entry and returns a bool-value
+ * @param insertValues data-map with all other values, which can be used within the lambda
+ * @param error reference for error-output
+ *
+ * @return the original array-item without the removed entries
+ */
+DataArray*
+filterValues(DataArray* item,
+             const ExpressionItem &lambda,
+             DataMap &insertValues,
+             ErrorContainer &error)
+{
+    // precheck
+    if(item == nullptr)
+    {
+        error.addMeesage("inputs for filter-function are invalid");
+        return nullptr;
+    }
+
+    // move the entries, which should be kept, to the front within one pass over the array
+    uint64_t numberOfKept = 0;
+    ExpressionItem expression = lambda;
+    for(uint64_t i = 0; i < item->array.size(); i++)
+    {
+        DataItem* result = evaluateLambda(expression,
+                                          lambda,
+                                          {item->array[i]},
+                                          insertValues,
+                                          error);
+        if(result == nullptr
+                || result->isBoolValue() == false)
+        {
+            delete result;
+            // remove the already moved or deleted entries, before the array is deleted
+            item->array.erase(item->array.begin() + numberOfKept, item->array.begin() + i);
+            error.addMeesage("lambda of the filter-function doesn't return a bool-value "
+                             "for entry " + std::to_string(i));
+            return nullptr;
+        }
+
+        const bool keep = result->toValue()->getBool();
+        delete result;
+
+        if(keep) {
+            item->array[numberOfKept++] = item->array[i];
+        } else {
+            delete item->array[i];
+        }
+    }
+    item->array.resize(numberOfKept);
+
+    return item;
+}
+
+/**
+ * @brief combine all entries of an array-item into a single value
+ *
+ * @param item array-item, which should be reduced
+ * @param lambda lambda with two parameters, which gets the current result and the entry and
+ *               returns the new result
+ * @param initial initial result, which is used for the first entry
+ * @param insertValues data-map with all other values, which can be used within the lambda
+ * @param error reference for error-output
+ *
+ * @return new data-item with the result, or nullptr if the processing failed
+ */
+DataItem*
+reduceValues(DataArray* item,
+             const ExpressionItem &lambda,
+             DataItem* initial,
+             DataMap &insertValues,
+             ErrorContainer &error)
+{
+    // precheck
+    if(item == nullptr
+            || initial == nullptr)
+    {
+        error.addMeesage("inputs for reduce-function are invalid");
+        return nullptr;
+    }
+
+    DataItem* result = initial->copy();
+    ExpressionItem expression = lambda;
+    for(uint64_t i = 0; i < item->array.size(); i++)
+    {
+        DataItem* next = evaluateLambda(expression,
+                                        lambda,
+                                        {result, item->array[i]},
+                                        insertValues,
+                                        error);
+        delete result;
+        if(next == nullptr)
+        {
+            error.addMeesage("failed to process entry " + std::to_string(i)
+                             + " in reduce-function");
+            return nullptr;
+        }
+        result = next;
+    }
+
+    return result;
+}
+
+/**
+ * @brief get the order of the entries of a typed buffer
+ *
+ * @param order reference for the positions of the entries in ascending order
+ * @param values buffer with the values
+ */
+void
+getSortOrder(std::vector<uint64_t> &order,
+             const TypedArray &values)
+{
+    order.resize(values.size());
+    for(uint64_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+
+    switch(values.getType())
+    {
+        case TypedArray::INT_COLUMN:
+        {
+            const std::vector<long> &numbers = values.m_intValues;
+            std::stable_sort(order.begin(), order.end(), [&](uint64_t left, uint64_t right) {
+                return numbers[left] < numbers[right];
+            });
+            break;
+        }
+        case TypedArray::FLOAT_COLUMN:
+        {
+            std::stable_sort(order.begin(), order.end(), [&](uint64_t left, uint64_t right) {
+                return values.compareNumbers(left, right) < 0;
+            });
+            break;
+        }
+        case TypedArray::BOOL_COLUMN:
+        {
+            const std::vector<bool> &bools = values.m_boolValues;
+            std::stable_sort(order.begin(), order.end(), [&](uint64_t left, uint64_t right) {
+                return bools[left] < bools[right];
+            });
+            break;
+        }
+        case TypedArray::STRING_COLUMN:
+        {
+            std::stable_sort(order.begin(), order.end(), [&](uint64_t left, uint64_t right) {
+                return values.getString(left) < values.getString(right);
+            });
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief sort the entries of an array-item by the values of its typed buffer. Only the
+ *        pointers of the entries are moved, so no entry has to be copied.
+ *
+ * @param item array-item, which should be sorted
+ * @param values typed buffer with the values of the array-item
+ *
+ * @return the original array-item with the sorted entries
+ */
+DataArray*
+sortByBuffer(DataArray* item,
+             const TypedArray &values)
+{
+    std::vector<uint64_t> order;
+    getSortOrder(order, values);
+
+    std::vector<DataItem*> sortedEntries(order.size());
+    for(uint64_t i = 0; i < order.size(); i++) {
+        sortedEntries[i] = item->array[order[i]];
+    }
+    item->array.swap(sortedEntries);
+
+    return item;
+}
+
+/**
+ * @brief sort the entries of an array-item in ascending order. All entries must be numbers,
+ *        strings or bool-values, but not mixed.
+ *
+ * @param item array-item, which should be sorted
+ * @param error reference for error-output
+ *
+ * @return the original array-item with the sorted entries
+ */
+DataArray*
+sortValues(DataArray* item,
+           ErrorContainer &error)
+{
+    // precheck
+    if(item == nullptr)
+    {
+        error.addMeesage("inputs for sort-function are invalid");
+        return nullptr;
+    }
+
+    // arrays with values of only one type are sorted by their typed buffer
+    TypedArray values;
+    if(values.fromDataArray(item, true)) {
+        return sortByBuffer(item, values);
+    }
+
+    // check types before sorting, so the comparison can not fail while sorting
+    for(uint64_t i = 1; i < item->array.size(); i++)
+    {
+        bool isSmaller = false;
+        if(compareValues(isSmaller,
+                         item->array[0],
+                         item->array[i],
+                         ExpressionItem::SMALLER_EXPRESSION,
+                         error) == false)
+        {
+            error.addMeesage("sort-function requires values of the same type");
+            return nullptr;
+        }
+    }
+
+    // sort entries
+    std::stable_sort(item->array.begin(),
+                     item->array.end(),
+                     [&](DataItem* left, DataItem* right)
+    {
+        bool isSmaller = false;
+        compareValues(isSmaller, left, right, ExpressionItem::SMALLER_EXPRESSION, error);
+        return isSmaller;
+    });
+
+    return item;
+}
+
+/**
+ * @brief remove all duplicate entries of an int- or string-array by the values of its typed
+ *        buffer, while keeping the first occurrence
+ *
+ * @param item array-item, which should be cleared
+ * @param values typed buffer with the values of the array-item
+ *
+ * @return the original array-item without the duplicate entries
+ */
+DataArray*
+uniqueByBuffer(DataArray* item,
+               const TypedArray &values)
+{
+    std::unordered_set<long> existingNumbers;
+    std::unordered_set<std::string_view> existingStrings;
+    const bool isInt = values.getType() == TypedArray::INT_COLUMN;
+    if(isInt) {
+        existingNumbers.reserve(values.size());
+    } else {
+        existingStrings.reserve(values.size());
+    }
+
+    uint64_t numberOfKept = 0;
+    for(uint64_t i = 0; i < item->array.size(); i++)
+    {
+        bool isNew = false;
+        if(isInt) {
+            isNew = existingNumbers.insert(values.m_intValues[i]).second;
+        } else {
+            isNew = existingStrings.insert(values.getString(i)).second;
+        }
+
+        if(isNew) {
+            item->array[numberOfKept++] = item->array[i];
+        } else {
+            delete item->array[i];
+        }
+    }
+    item->array.resize(numberOfKept);
+
+    return item;
+}
+
+/**
+ * @brief remove all duplicate entries of an array-item, while keeping the first occurrence
+ *
+ * @param item array-item, which should be cleared
+ * @param error reference for error-output
+ *
+ * @return the original array-item without the duplicate entries
+ */
+DataArray*
+uniqueValues(DataArray* item,
+             ErrorContainer &error)
+{
+    // precheck
+    if(item == nullptr)
+    {
+        error.addMeesage("inputs for unique-function are invalid");
+        return nullptr;
+    }
+
+    // int- and string-arrays are compared by their typed buffer without converting
+    // each entry into a string
+    TypedArray values;
+    if(values.fromDataArray(item)
+            && (values.getType() == TypedArray::INT_COLUMN
+                || values.getType() == TypedArray::STRING_COLUMN))
+    {
+        return uniqueByBuffer(item, values);
+    }
+
+    std::unordered_set<std::string> existingKeys;
+    existingKeys.reserve(item->array.size());
+
+    uint64_t numberOfKept = 0;
+    for(uint64_t i = 0; i < item->array.size(); i++)
+    {
+        if(existingKeys.insert(getIndexKey(item->array[i])).second) {
+            item->array[numberOfKept++] = item->array[i];
+        } else {
+            delete item->array[i];
+        }
+    }
+    item->array.resize(numberOfKept);
+
+    return item;
+}
+
+/**
+ * @brief combine the entries of two array-items into pairs. If the arrays have different
+ *        length, the additional entries of the longer array are dropped.
+ *
+ * @param item array-item with the first entries of the pairs
+ * @param other array-item with the second entries of the pairs
+ * @param error reference for error-output
+ *
+ * @return the original array-item with the pairs as entries
+ */
+DataArray*
+zipValues(DataArray* item,
+          DataArray* other,
+          ErrorContainer &error)
+{
+    // precheck
+    if(item == nullptr
+            || other == nullptr)
+    {
+        error.addMeesage("inputs for zip-function are invalid");
+        return nullptr;
+    }
+
+    // drop additional entries
+    while(item->array.size() > other->array.size())
+    {
+        delete item->array.back();
+        item->array.pop_back();
+    }
+
+    // the entries of the own array are moved into the pairs without copy
+    for(uint64_t i = 0; i < item->array.size(); i++)
+    {
+        DataArray* pair = new DataArray();
+        pair->append(item->array[i]);
+        pair->append(other->array[i]->copy());
+        item->array[i] = pair;
+    }
+
+    return item;
+}
+
+/**
+ * @brief replace all array-entries of an array-item by their entries. This is done only for
+ *        one level.
+ *
+ * @param item array-item, which should be flattened
+ * @param error reference for error-output
+ *
+ * @return the original array-item with the flattened entries
+ */
+DataArray*
+flattenValues(DataArray* item,
+              ErrorContainer &error)
+{
+    // precheck
+    if(item == nullptr)
+    {
+        error.addMeesage("inputs for flatten-function are invalid");
+        return nullptr;
+    }
+
+    // the entries of the inner arrays are moved without copy
+    std::vector<DataItem*> result;
+    result.reserve(item->array.size());
+    for(DataItem* entry : item->array)
+    {
+        if(entry->isArray())
+        {
+            DataArray* innerArray = entry->toArray();
+            result.insert(result.end(), innerArray->array.begin(), innerArray->array.end());
+            innerArray->array.clear();
+            delete innerArray;
+        }
+        else
+        {
+            result.push_back(entry);
+        }
+    }
+    item->array.swap(result);
+
+    return item;
+}
+
+/**
+ * @brief get the range of entries, which are selected by a slice-function
+ *
+ * @param start reference for the first selected position
+ * @param end reference for the position behind the last selected entry
+ * @param sliceType type of the slice-function (take, skip or slice)
+ * @param arguments arguments of the function-call
+ * @param size number of entries of the array
+ * @param error reference for error-output
+ *
+ * @return false, if the arguments are invalid, else true
+ */
+bool
+getSliceRange(uint64_t &start,
+              uint64_t &end,
+              const FunctionItem::SpecialType sliceType,
+              const std::vector<DataItem*> &arguments,
+              const uint64_t size,
+              ErrorContainer &error)
+{
+    std::string functionName = "slice";
+    if(sliceType == FunctionItem::TAKE_TYPE) {
+        functionName = "take";
+    } else if(sliceType == FunctionItem::SKIP_TYPE) {
+        functionName = "skip";
+    }
+
+    std::vector<uint64_t> positions;
+    for(DataItem* argument : arguments)
+    {
+        if(argument == nullptr
+                || argument->isIntValue() == false
+                || argument->toValue()->getLong() < 0)
+        {
+            error.addMeesage("input for the " + functionName + "-function must be a "
+                             "positive int-value");
+            return false;
+        }
+
+        const uint64_t position = static_cast<uint64_t>(argument->toValue()->getLong());
+        positions.push_back(std::min(position, size));
+    }
+
+    start = 0;
+    end = size;
+    if(sliceType == FunctionItem::TAKE_TYPE) {
+        end = positions.at(0);
+    } else if(sliceType == FunctionItem::SKIP_TYPE) {
+        start = positions.at(0);
+    } else {
+        start = positions.at(0);
+        end = std::max(positions.at(1), start);
+    }
+
+    return true;
+}
+
+/**
+ * @brief reduce an array-item to a range of its entries
+ *
+ * @param item array-item, which should be reduced
+ * @param start first position, which should be kept
+ * @param end position behind the last entry, which should be kept
+ *
+ * @return the original array-item with only the entries of the range
+ */
+DataArray*
+sliceValues(DataArray* item,
+            const uint64_t start,
+            const uint64_t end)
+{
+    for(uint64_t i = 0; i < item->array.size(); i++)
+    {
+        if(i < start || i >= end) {
+            delete item->array[i];
+        }
+    }
+
+    item->array.erase(item->array.begin() + end, item->array.end());
+    item->array.erase(item->array.begin(), item->array.begin() + start);
+
+    return item;
+}
+
+/**
+ * @brief copy a range of the entries of an array-item, without copying the other entries
+ *
+ * @param item array-item with the entries
+ * @param start first position, which should be copied
+ * @param end position behind the last entry, which should be copied
+ *
+ * @return new array-item with the copied entries
+ */
+DataArray*
+copySlice(DataArray* item,
+          const uint64_t start,
+          const uint64_t end)
+{
+    DataArray* result = new DataArray();
+    result->array.reserve(end - start);
+    for(uint64_t i = start; i < end; i++) {
+        result->append(item->array[i]->copy());
+    }
+
+    return result;
+}
+
+/**
+ * @brief sum up int-values
+ *
+ * @param values values to sum up
+ *
+ * @return sum of the values
+ */
+long
+sumNumbers(const std::vector<long> &values)
+{
+    long result = 0;
+    for(const long value : values) {
+        result += value;
+    }
+
+    return result;
+}
+
+/**
+ * @brief sum up float-values with four independent partial sums, so the loop can be
+ *        vectorized without changing the order of the additions by the compiler
+ *
+ * @param values values to sum up
+ *
+ * @return sum of the values
+ */
+double
+sumNumbers(const std::vector<double> &values)
+{
+    double partialSums[4] = {0.0, 0.0, 0.0, 0.0};
+    const uint64_t blockEnd = values.size() - (values.size() % 4);
+
+    for(uint64_t i = 0; i < blockEnd; i += 4)
+    {
+        partialSums[0] += values[i];
+        partialSums[1] += values[i + 1];
+        partialSums[2] += values[i + 2];
+        partialSums[3] += values[i + 3];
+    }
+
+    double result = (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+    for(uint64_t i = blockEnd; i < values.size(); i++) {
+        result += values[i];
+    }
+
+    return result;
+}
+
+/**
+ * @brief get the minimum or maximum of a non-empty list of numbers
+ *
+ * @param values values to check
+ * @param searchMax true to get the maximum, false to get the minimum
+ *
+ * @return minimum or maximum of the values
+ */
+template<typename T>
+T
+getExtremeNumber(const std::vector<T> &values,
+                 const bool searchMax)
+{
+    T result = values[0];
+    if(searchMax)
+    {
+        for(const T value : values) {
+            result = value > result ? value : result;
+        }
+    }
+    else
+    {
+        for(const T value : values) {
+            result = value < result ? value : result;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief get the percentile of a non-empty list of numbers with linear interpolation between
+ *        the two nearest values
+ *
+ * @param values values to check, which are partially sorted by this function
+ * @param percent percentile in the range of 0 to 100
+ *
+ * @return percentile of the values
+ */
+template<typename T>
+double
+getPercentile(std::vector<T> &values,
+              const double percent)
+{
+    const double rank = (percent / 100.0) * static_cast<double>(values.size() - 1);
+    const uint64_t lowerPos = static_cast<uint64_t>(rank);
+
+    // only the position of the searched value has to be sorted
+    std::nth_element(values.begin(), values.begin() + lowerPos, values.end());
+    const double lower = static_cast<double>(values[lowerPos]);
+    if(lowerPos + 1 >= values.size()) {
+        return lower;
+    }
+
+    // all values behind the position are greater or equal, so the next value is their minimum
+    const double upper = static_cast<double>(*std::min_element(values.begin() + lowerPos + 1,
+                                                                values.end()));
+
+    return lower + (rank - static_cast<double>(lowerPos)) * (upper - lower);
+}
+
+/**
+ * @brief precheck and collect the numbers of an array-item for an aggregation
+ *
+ * @param numbers reference for the buffer with the numbers
+ * @param item array-item with the numbers
+ * @param functionName name of the calling function for the error-message
+ * @param allowEmpty true, if the function accepts an empty array
+ * @param error reference for error-output
+ *
+ * @return false, if the precheck failed, else true
+ */
+bool
+prepareAggregation(TypedArray &numbers,
+                   DataArray* item,
+                   const std::string &functionName,
+                   const bool allowEmpty,
+                   ErrorContainer &error)
+{
+    if(item == nullptr)
+    {
+        error.addMeesage("inputs for " + functionName + "-function are invalid");
+        return false;
+    }
+
+    if(allowEmpty == false
+            && item->array.size() == 0)
+    {
+        error.addMeesage(functionName + "-function can not be called on an empty array");
+        return false;
+    }
+
+    if(numbers.fromDataArray(item, true) == false
+            || (numbers.getType() != TypedArray::INT_COLUMN
+                && numbers.getType() != TypedArray::FLOAT_COLUMN))
+    {
+        error.addMeesage(functionName + "-function requires an array with only int- "
+                         "and float-values");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief sum up all numbers of an array-item
+ *
+ * @param item array-item with the numbers
+ * @param error reference for error-output
+ *
+ * @return int-value, if all numbers are int-values, else float-value
+ */
+DataValue*
+sumValues(DataArray* item,
+          ErrorContainer &error)
+{
+    TypedArray numbers;
+    if(prepareAggregation(numbers, item, "sum", true, error) == false) {
+        return nullptr;
+    }
+
+    if(numbers.getType() == TypedArray::FLOAT_COLUMN) {
+        return new DataValue(sumNumbers(numbers.m_floatValues));
+    }
+
+    return new DataValue(sumNumbers(numbers.m_intValues));
+}
+
+/**
+ * @brief get the minimum or maximum of all numbers of an array-item
+ *
+ * @param item array-item with the numbers
+ * @param searchMax true to get the maximum, false to get the minimum
+ * @param error reference for error-output
+ *
+ * @return int-value, if all numbers are int-values, else float-value
+ */
+DataValue*
+extremeValue(DataArray* item,
+             const bool searchMax,
+             ErrorContainer &error)
+{
+    TypedArray numbers;
+    const std::string functionName = searchMax ? "max" : "min";
+    if(prepareAggregation(numbers, item, functionName, false, error) == false) {
+        return nullptr;
+    }
+
+    if(numbers.getType() == TypedArray::FLOAT_COLUMN) {
+        return new DataValue(getExtremeNumber(numbers.m_floatValues, searchMax));
+    }
+
+    return new DataValue(getExtremeNumber(numbers.m_intValues, searchMax));
+}
+
+/**
+ * @brief get the average of all numbers of an array-item
+ *
+ * @param item array-item with the numbers
+ * @param error reference for error-output
+ *
+ * @return float-value with the average
+ */
+DataValue*
+avgValue(DataArray* item,
+         ErrorContainer &error)
+{
+    TypedArray numbers;
+    if(prepareAggregation(numbers, item, "avg", false, error) == false) {
+        return nullptr;
+    }
+
+    const double size = static_cast<double>(numbers.size());
+    if(numbers.getType() == TypedArray::FLOAT_COLUMN) {
+        return new DataValue(sumNumbers(numbers.m_floatValues) / size);
+    }
+
+    return new DataValue(static_cast<double>(sumNumbers(numbers.m_intValues)) / size);
+}
+
+/**
+ * @brief get a percentile of all numbers of an array-item
+ *
+ * @param item array-item with the numbers
+ * @param percent percentile in the range of 0 to 100
+ * @param error reference for error-output
+ *
+ * @return float-value with the percentile
+ */
+DataValue*
+percentileValue(DataArray* item,
+                DataValue* percent,
+                ErrorContainer &error)
+{
+    TypedArray numbers;
+    if(prepareAggregation(numbers, item, "percentile", false, error) == false) {
+        return nullptr;
+    }
+
+    // check percentile
+    double percentNumber = -1.0;
+    if(percent != nullptr
+            && percent->isIntValue())
+    {
+        percentNumber = static_cast<double>(percent->getLong());
+    }
+    else if(percent != nullptr
+            && percent->isFloatValue())
+    {
+        percentNumber = percent->getDouble();
+    }
+    if(percentNumber < 0.0
+            || percentNumber > 100.0)
+    {
+        error.addMeesage("input for the percentile-function must be a number between 0 and 100");
+        return nullptr;
+    }
+
+    if(numbers.getType() == TypedArray::FLOAT_COLUMN) {
+        return new DataValue(getPercentile(numbers.m_floatValues, percentNumber));
+    }
+
+    return new DataValue(getPercentile(numbers.m_intValues, percentNumber));
+}
+
+/**
+ * @brief count all entries of an array-item, for which a lambda returns true
+ *
+ * @param item array-item with the entries
+ * @param lambda lambda with one parameter, which gets the entry and returns a bool-value
+ * @param insertValues data-map with all other values, which can be used within the lambda
+ * @param error reference for error-output
+ *
+ * @return int-value with the number of matching entries
+ */
+DataValue*
+countIfValues(DataArray* item,
+              const ExpressionItem &lambda,
+              DataMap &insertValues,
+              ErrorContainer &error)
+{
+    // precheck
+    if(item == nullptr)
+    {
+        error.addMeesage("inputs for count_if-function are invalid");
+        return nullptr;
+    }
+
+    long counter = 0;
+    ExpressionItem expression = lambda;
+    for(uint64_t i = 0; i < item->array.size(); i++)
+    {
+        DataItem* result = evaluateLambda(expression,
+                                          lambda,
+                                          {item->array[i]},
+                                          insertValues,
+                                          error);
+        if(result == nullptr
+                || result->isBoolValue() == false)
+        {
+            delete result;
+            error.addMeesage("lambda of the count_if-function doesn't return a bool-value "
+                             "for entry " + std::to_string(i));
+            return nullptr;
+        }
+
+        counter += result->toValue()->getBool();
+        delete result;
+    }
+
+    return new DataValue(counter);
+}
+
+/**
+ * @brief get the key of a value for the unique-function. Numbers with the same value get the
+ *        same key, independent of their type. All other values are represented by their
+ *        string-form, like in the comparison of values with different types.
+ *
+ * @param item item to convert
+ *
+ * @return key for the comparison
+ */
+const std::string
+getIndexKey(DataItem* item)
+{
+    if(item->isIntValue()) {
+        return std::to_string(item->toValue()->getLong());
+    }
+
+    if(item->isFloatValue())
+    {
+        // only integral values within the range of long can be converted. NaN fails all checks.
+        const double value = item->toValue()->getDouble();
+        const double limit = -static_cast<double>(std::numeric_limits<long>::min());
+        if(value >= -limit
+                && value < limit
+                && std::trunc(value) == value)
+        {
+            return std::to_string(static_cast<long>(value));
+        }
+    }
+
+    return item->toString();
+}
+
+/**
+ * @brief create an index over all entries of an array, so the contains-function can check the
+ *        existence of a value without iterating over the array
+ *
+ * @param index reference for the resulting index
+ * @param array array-item to index
+ */
+void
+buildContainsIndex(ContainsIndex &index,
+                   DataArray* array)
+{
+    for(uint64_t i = 0; i < array->size(); i++)
+    {
+        DataItem* entry = array->get(i);
+        if(entry->isIntValue())
+        {
+            const long value = entry->toValue()->getLong();
+            index.intValues.insert(value);
+            index.intValuesAsFloat.insert(static_cast<double>(value));
+            index.numberStrings.insert(entry->toString());
+        }
+        else if(entry->isFloatValue())
+        {
+            // NaN is not equal to any number
+            const double value = entry->toValue()->getDouble();
+            if(std::isnan(value) == false) {
+                index.floatValues.insert(value);
+            }
+            index.numberStrings.insert(entry->toString());
+        }
+        else
+        {
+            index.otherStrings.insert(entry->toString());
+        }
+    }
+}
+
+/**
+ * @brief check if a value is in the index of an array. The result is the same like comparing the
+ *        value with each entry of the array by the comparison of the contains-function.
+ *
+ * @param index index to check
+ * @param key value, which should be searched in the index
+ *
+ * @return true, if the value was found, else false
+ */
+bool
+isInContainsIndex(const ContainsIndex &index,
+                  DataValue* key)
+{
+    const std::string keyString = key->toString();
+
+    // int-values are compared with other int-values without conversion
+    if(key->getValueType() == DataItem::INT_TYPE)
+    {
+        const long value = key->getLong();
+        return index.intValues.count(value) > 0
+               || index.floatValues.count(static_cast<double>(value)) > 0
+               || index.otherStrings.count(keyString) > 0;
+    }
+
+    // float-values are compared with all numbers as float-value
+    if(key->getValueType() == DataItem::FLOAT_TYPE)
+    {
+        const double value = key->getDouble();
+        return index.floatValues.count(value) > 0
+               || index.intValuesAsFloat.count(value) > 0
+               || index.otherStrings.count(keyString) > 0;
+    }
+
+    return index.otherStrings.count(keyString) > 0
+           || index.numberStrings.count(keyString) > 0;
+}
+
+/**
+ * @brief parse a json-formated string into a data-item
+ *
+ * @param intput input-value with the json-formated content
+ * @param error reference for error-output
+ *
+ * @return nullptr, if failed, else a data-item with the parsed content
+ */
+DataItem*
+parseJson(DataValue* intput,
+          ErrorContainer &error)
+{
+    // precheck
+    if(intput == nullptr)
+    {
+        error.addMeesage("inputs for parse_json-function are invalid");
+        return nullptr;
+    }
+
+    // string-values are parsed directly without converting them into a new string
+    if(intput->isStringValue())
+    {
+        JsonReader reader(intput->content.stringValue);
+        return reader.parse(error);
+    }
+
+    const std::string text = intput->toString();
+    JsonReader reader(text);
+    return reader.parse(error);
 }
 
 } // namespace Sakura
@@ -24,7 +24,11 @@
 #define KITSUNEMIMI_SAKURA_LANG_VALUE_ITEM_FUNCTIONS_H
 
 #include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
 #include <libKitsunemimiCommon/logger.h>
+#include <items/value_items.h>
 
 namespace Kitsunemimi
 {
@@ -35,13 +39,34 @@ class DataValue;
 
 namespace Sakura
 {
+struct ExpressionItem;
 
 DataItem* getValue(DataItem* item,
                    DataValue* key,
                    ErrorContainer &error);
+bool getNextSplitPart(std::string_view &part,
+                      uint64_t &pos,
+                      const std::string_view &text,
+                      const std::string_view &delimiter);
+void splitString(DataArray &result,
+                 const std::string_view &text,
+                 const std::string_view &delimiter);
+bool getSplitDelimiter(std::string &result,
+                       DataValue* delimiter);
 DataArray* splitValue(DataValue* item,
                       DataValue* delimiter,
                       ErrorContainer &error);
+bool getFileText(std::string_view &text,
+                 DataValue* fileId,
+                 ErrorContainer &error);
+bool getChunkSize(uint64_t &chunkSize,
+                  DataValue* value,
+                  ErrorContainer &error);
+DataArray* fileLines(DataValue* fileId,
+                     ErrorContainer &error);
+DataArray* fileChunks(DataValue* fileId,
+                      DataValue* chunkSize,
+                      ErrorContainer &error);
 DataValue* sizeValue(DataItem* item,
                      ErrorContainer &error);
 DataValue* containsValue(DataItem* item,
@@ -56,6 +81,60 @@ DataMap* insertValue(DataMap* item,
                      ErrorContainer &error);
 DataArray* clearEmpty(DataArray* item,
                       ErrorContainer &error);
+DataArray* mapValues(DataArray* item,
+                     const ExpressionItem &lambda,
+                     DataMap &insertValues,
+                     ErrorContainer &error);
+DataArray* filterValues(DataArray* item,
+                        const ExpressionItem &lambda,
+                        DataMap &insertValues,
+                        ErrorContainer &error);
+DataItem* reduceValues(DataArray* item,
+                       const ExpressionItem &lambda,
+                       DataItem* initial,
+                       DataMap &insertValues,
+                       ErrorContainer &error);
+DataArray* sortValues(DataArray* item,
+                      ErrorContainer &error);
+DataArray* uniqueValues(DataArray* item,
+                        ErrorContainer &error);
+DataArray* zipValues(DataArray* item,
+                     DataArray* other,
+                     ErrorContainer &error);
+DataArray* flattenValues(DataArray* item,
+                         ErrorContainer &error);
+bool getSliceRange(uint64_t &start,
+                   uint64_t &end,
+                   const FunctionItem::SpecialType sliceType,
+                   const std::vector<DataItem*> &arguments,
+                   const uint64_t size,
+                   ErrorContainer &error);
+DataArray* sliceValues(DataArray* item,
+                       const uint64_t start,
+                       const uint64_t end);
+DataArray* copySlice(DataArray* item,
+                     const uint64_t start,
+                     const uint64_t end);
+DataValue* sumValues(DataArray* item,
+                     ErrorContainer &error);
+DataValue* extremeValue(DataArray* item,
+                        const bool searchMax,
+                        ErrorContainer &error);
+DataValue* avgValue(DataArray* item,
+                    ErrorContainer &error);
+DataValue* percentileValue(DataArray* item,
+                           DataValue* percent,
+                           ErrorContainer &error);
+DataValue* countIfValues(DataArray* item,
+                         const ExpressionItem &lambda,
+                         DataMap &insertValues,
+                         ErrorContainer &error);
+const std::string getIndexKey(DataItem* item);
+void buildContainsIndex(ContainsIndex &index,
+                        DataArray* array);
+bool isInContainsIndex(const ContainsIndex &index,
+                       DataValue* key);
+
 DataItem* parseJson(DataValue* intput,
                     ErrorContainer &error);
 
@@ -25,6 +25,8 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include <unordered_set>
 
 #include <libKitsunemimiCommon/items/data_items.h>
 #include <libKitsunemimiSakuraLang/blossom.h>
@@ -38,11 +40,52 @@ namespace Sakura
 // FunctionItem
 //==================================================================================================
 struct ValueItem;
+struct ExpressionItem;
+struct LambdaFunctionDef;
 
 struct FunctionItem
 {
+    enum SpecialType
+    {
+        NO_SPECIAL_TYPE = 0,
+        PARSE_JSON_TYPE = 1,
+        GET_TYPE = 2,
+        TAKE_TYPE = 3,
+        SKIP_TYPE = 4,
+        SLICE_TYPE = 5,
+        CONTAINS_TYPE = 6,
+        SPLIT_TYPE = 7,
+        FILE_LINES_TYPE = 8,
+        FILE_CHUNKS_TYPE = 9,
+    };
+
     std::string type = "";
     std::vector<ValueItem> arguments;
+
+    // functions, which are processed differently than by the registered function, if they are
+    // combined with the value or other functions, which is resolved while loading the tree
+    SpecialType specialType = NO_SPECIAL_TYPE;
+
+    // registered function, which was resolved by the type while loading the tree
+    const ValueFunctionDef* definition = nullptr;
+
+    // registered function, if the function is called with a lambda as first argument
+    const LambdaFunctionDef* lambdaDefinition = nullptr;
+};
+
+//==================================================================================================
+// ContainsIndex
+//==================================================================================================
+struct ContainsIndex
+{
+    // numbers are found by their value, like in the comparison of values
+    std::unordered_set<long> intValues;
+    std::unordered_set<double> intValuesAsFloat;
+    std::unordered_set<double> floatValues;
+
+    // all other combinations are found by their string-representation
+    std::unordered_set<std::string> numberStrings;
+    std::unordered_set<std::string> otherStrings;
 };
 
 //==================================================================================================
@@ -62,62 +105,189 @@ struct ValueItem
     DataItem* item = nullptr;
     ValueType type = INPUT_PAIR_TYPE;
     bool isIdentifier = false;
+    bool isConstant = false;
     std::string comment = "";
     FieldType fieldType = SAKURA_UNDEFINED_TYPE;
     std::vector<FunctionItem> functions;
 
+    // native expression, which is evaluated instead of the item
+    ExpressionItem* expression = nullptr;
+
+    // index over the array of the identifier for its first contains-call, which is shared
+    // between all copies of the value-item
+    std::shared_ptr<const ContainsIndex> containsIndex;
+
     ValueItem() {}
+    ValueItem(const ValueItem &other);
+    ~ValueItem();
+    ValueItem &operator=(const ValueItem &other);
+};
 
-    ValueItem(const ValueItem &other)
+//==================================================================================================
+// ExpressionItem
+//==================================================================================================
+struct ExpressionItem
+{
+    enum ExpressionType
     {
-        if(item != nullptr) {
-            delete item;
-        }
+        VALUE_EXPRESSION = 0,
+        EQUAL_EXPRESSION = 1,
+        UNEQUAL_EXPRESSION = 2,
+        GREATER_EXPRESSION = 3,
+        GREATER_EQUAL_EXPRESSION = 4,
+        SMALLER_EXPRESSION = 5,
+        SMALLER_EQUAL_EXPRESSION = 6,
+        AND_EXPRESSION = 7,
+        OR_EXPRESSION = 8,
+        NOT_EXPRESSION = 9,
+        ADD_EXPRESSION = 10,
+        SUBTRACT_EXPRESSION = 11,
+        MULTIPLY_EXPRESSION = 12,
+        DIVIDE_EXPRESSION = 13,
+        MODULO_EXPRESSION = 14,
+    };
 
-        if(other.item != nullptr) {
-            item = other.item->copy();
-        } else {
-            item = nullptr;
-        }
+    ExpressionType type = VALUE_EXPRESSION;
+
+    // value of value-expressions and result of all other expressions after evaluation
+    ValueItem value;
 
+    // operands of the expression (only left for unary expressions)
+    ExpressionItem* left = nullptr;
+    ExpressionItem* right = nullptr;
+
+    // names of the parameters, if the expression is a lambda, which is not evaluated directly,
+    // but for each entry within a function like map or filter
+    std::vector<std::string> parameters;
+
+    ExpressionItem() {}
+
+    ExpressionItem(const ExpressionItem &other)
+    {
         type = other.type;
-        isIdentifier = other.isIdentifier;
-        functions = other.functions;
-        fieldType = other.fieldType;
-        comment = other.comment;
+        value = other.value;
+        parameters = other.parameters;
+
+        if(other.left != nullptr) {
+            left = new ExpressionItem(*other.left);
+        }
+        if(other.right != nullptr) {
+            right = new ExpressionItem(*other.right);
+        }
     }
 
-    ~ValueItem()
+    ~ExpressionItem()
     {
-        if(item != nullptr) {
-            delete item;
+        if(left != nullptr) {
+            delete left;
+        }
+        if(right != nullptr) {
+            delete right;
         }
     }
 
-    ValueItem &operator=(const ValueItem &other)
+    ExpressionItem &operator=(const ExpressionItem &other)
     {
         if(this != &other)
         {
-            if(this->item != nullptr) {
-                delete this->item;
+            ExpressionItem* newLeft = nullptr;
+            ExpressionItem* newRight = nullptr;
+
+            if(other.left != nullptr) {
+                newLeft = new ExpressionItem(*other.left);
+            }
+            if(other.right != nullptr) {
+                newRight = new ExpressionItem(*other.right);
             }
 
-            if(other.item != nullptr) {
-                this->item = other.item->copy();
-            } else {
-                this->item = nullptr;
+            if(this->left != nullptr) {
+                delete this->left;
+            }
+            if(this->right != nullptr) {
+                delete this->right;
             }
 
             this->type = other.type;
-            this->isIdentifier = other.isIdentifier;
-            this->functions = other.functions;
-            this->fieldType = other.fieldType;
-            this->comment = other.comment;
+            this->value = other.value;
+            this->left = newLeft;
+            this->right = newRight;
+            this->parameters = other.parameters;
         }
         return *this;
     }
 };
 
+//==================================================================================================
+// ValueItem
+//==================================================================================================
+inline
+ValueItem::ValueItem(const ValueItem &other)
+{
+    if(other.item != nullptr) {
+        item = other.item->copy();
+    } else {
+        item = nullptr;
+    }
+
+    if(other.expression != nullptr) {
+        expression = new ExpressionItem(*other.expression);
+    }
+
+    type = other.type;
+    isIdentifier = other.isIdentifier;
+    isConstant = other.isConstant;
+    functions = other.functions;
+    fieldType = other.fieldType;
+    comment = other.comment;
+    containsIndex = other.containsIndex;
+}
+
+inline
+ValueItem::~ValueItem()
+{
+    if(item != nullptr) {
+        delete item;
+    }
+    if(expression != nullptr) {
+        delete expression;
+    }
+}
+
+inline ValueItem&
+ValueItem::operator=(const ValueItem &other)
+{
+    if(this != &other)
+    {
+        if(this->item != nullptr) {
+            delete this->item;
+        }
+
+        if(other.item != nullptr) {
+            this->item = other.item->copy();
+        } else {
+            this->item = nullptr;
+        }
+
+        ExpressionItem* newExpression = nullptr;
+        if(other.expression != nullptr) {
+            newExpression = new ExpressionItem(*other.expression);
+        }
+        if(this->expression != nullptr) {
+            delete this->expression;
+        }
+        this->expression = newExpression;
+
+        this->type = other.type;
+        this->isIdentifier = other.isIdentifier;
+        this->isConstant = other.isConstant;
+        this->functions = other.functions;
+        this->fieldType = other.fieldType;
+        this->comment = other.comment;
+        this->containsIndex = other.containsIndex;
+    }
+    return *this;
+}
+
 } // namespace Sakura
 } // namespace Kitsunemimi
 
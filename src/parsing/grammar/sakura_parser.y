@@ -117,6 +117,12 @@ YY_DECL;
     SMALLER_COMPARE "<"
     SHIFT_LEFT "<<"
     SHIFT_RIGHT ">>"
+    AND "&&"
+    OR "||"
+    NOT "!"
+    STAR "*"
+    SLASH "/"
+    PERCENT "%"
 ;
 
 %token <std::string> IDENTIFIER "identifier"
@@ -130,6 +136,8 @@ YY_DECL;
 %type  <std::string> compare_type
 %type  <ValueItem>  value_item
 %type  <std::vector<ValueItem>*>  value_item_list
+%type  <ValueItem>  lambda
+%type  <std::vector<std::string>*>  lambda_parameters
 %type  <std::string> registerable_identifier;
 
 %type  <BlossomGroupItem*> blossom_group
@@ -147,12 +155,21 @@ YY_DECL;
 %type  <std::vector<FunctionItem>*> function_list
 
 %type  <IfBranching*> if_condition
+%type  <ExpressionItem*> expression
+%type  <ExpressionItem*> and_expression
+%type  <ExpressionItem*> compare_expression
+%type  <ExpressionItem*> sum_expression
+%type  <ExpressionItem*> product_expression
+%type  <ExpressionItem*> unary_expression
 %type  <ForEachBranching*> for_each_loop
 %type  <ForBranching*> for_loop
+%type  <uint32_t> parallel_width
 
 %type  <ParallelPart*> parallel
 
 %type  <TreeItem*> tree
+%type  <TreeItem*> tree_header
+%type  <std::vector<std::string>*> tree_cache_keys
 %type  <SubtreeItem*> subtree_fork
 
 %type  <DataItem*> json_abstract
@@ -172,23 +189,64 @@ startpoint:
     }
 
 tree:
-    "[" name_item "]" item_set blossom_group_set
+    tree_header item_set blossom_group_set
+    {
+        $$ = $1;
+        $$->values = *$2;
+        delete $2;
+        $$->childs = $3;
+    }
+|
+    tree_header "(" "string" ")" item_set blossom_group_set
+    {
+        $$ = $1;
+        $$->comment = $3;
+        $$->values = *$5;
+        delete $5;
+        $$->childs = $6;
+    }
+
+tree_header:
+    "[" name_item "]"
     {
         $$ = new TreeItem();
         $$->id = $2;
-        $$->values = *$4;
-        delete $4;
-        $$->childs = $5;
     }
 |
-    "[" name_item "]" "(" "string" ")" item_set blossom_group_set
+    "[" name_item "]" "<" "identifier" "(" "number" tree_cache_keys ")" ">"
     {
+        if($5 != "cache")
+        {
+            driver.error(yyla.location,
+                         "unknown tree-option \"" + $5 + "\"",
+                         true);
+            return 1;
+        }
+        if($7 <= 0)
+        {
+            driver.error(yyla.location,
+                         "size of the cache of a tree must be greater than 0",
+                         true);
+            return 1;
+        }
+
         $$ = new TreeItem();
         $$->id = $2;
-        $$->comment = $5;
-        $$->values = *$7;
-        delete $7;
-        $$->childs = $8;
+        $$->cacheSize = static_cast<uint64_t>($7);
+        $$->cacheContextKeys = *$8;
+        delete $8;
+    }
+
+tree_cache_keys:
+    %empty
+    {
+        $$ = new std::vector<std::string>();
+    }
+|
+    tree_cache_keys "," name_item
+    {
+        $1->push_back($3);
+        $$ = $1;
     }
 
 blossom_group_set:
@@ -266,38 +324,150 @@ blossom_group_set:
 
 
 if_condition:
-    "if" "(" value_item compare_type value_item ")" "{" blossom_group_set "}" "else" "{" blossom_group_set "}"
+    "if" "(" expression ")" "{" blossom_group_set "}" "else" "{" blossom_group_set "}"
     {
         $$ = new IfBranching();
-        $$->leftSide = $3;
-        $$->rightSide = $5;
-
-        if($4 == "==") {
-            $$->ifType = IfBranching::EQUAL;
-        }
-        if($4 == "!=") {
-            $$->ifType = IfBranching::UNEQUAL;
-        }
+        $$->condition = *$3;
+        delete $3;
 
-        $$->ifContent = $8;
-        $$->elseContent = $12;
+        $$->ifContent = $6;
+        $$->elseContent = $10;
     }
 |
-    "if" "(" value_item compare_type value_item ")" "{" blossom_group_set "}"
+    "if" "(" expression ")" "{" blossom_group_set "}"
     {
         $$ = new IfBranching();
-        $$->leftSide = $3;
-        $$->rightSide = $5;
+        $$->condition = *$3;
+        delete $3;
 
-        if($4 == "==") {
-            $$->ifType = IfBranching::EQUAL;
+        $$->ifContent = $6;
+        $$->elseContent = new SequentiellPart();
+    }
+
+expression:
+    expression "||" and_expression
+    {
+        $$ = new ExpressionItem();
+        $$->type = ExpressionItem::OR_EXPRESSION;
+        $$->left = $1;
+        $$->right = $3;
+    }
+|
+    and_expression
+    {
+        $$ = $1;
+    }
+
+and_expression:
+    and_expression "&&" compare_expression
+    {
+        $$ = new ExpressionItem();
+        $$->type = ExpressionItem::AND_EXPRESSION;
+        $$->left = $1;
+        $$->right = $3;
+    }
+|
+    compare_expression
+    {
+        $$ = $1;
+    }
+
+compare_expression:
+    sum_expression compare_type sum_expression
+    {
+        $$ = new ExpressionItem();
+        $$->left = $1;
+        $$->right = $3;
+
+        if($2 == "==") {
+            $$->type = ExpressionItem::EQUAL_EXPRESSION;
         }
-        if($4 == "!=") {
-            $$->ifType = IfBranching::UNEQUAL;
+        if($2 == "!=") {
+            $$->type = ExpressionItem::UNEQUAL_EXPRESSION;
+        }
+        if($2 == ">") {
+            $$->type = ExpressionItem::GREATER_EXPRESSION;
+        }
+        if($2 == ">=") {
+            $$->type = ExpressionItem::GREATER_EQUAL_EXPRESSION;
         }
+        if($2 == "<") {
+            $$->type = ExpressionItem::SMALLER_EXPRESSION;
+        }
+        if($2 == "<=") {
+            $$->type = ExpressionItem::SMALLER_EQUAL_EXPRESSION;
+        }
+    }
+|
+    sum_expression
+    {
+        $$ = $1;
+    }
 
-        $$->ifContent = $8;
-        $$->elseContent = new SequentiellPart();
+sum_expression:
+    sum_expression "+" product_expression
+    {
+        $$ = new ExpressionItem();
+        $$->type = ExpressionItem::ADD_EXPRESSION;
+        $$->left = $1;
+        $$->right = $3;
+    }
+|
+    sum_expression "-" product_expression
+    {
+        $$ = new ExpressionItem();
+        $$->type = ExpressionItem::SUBTRACT_EXPRESSION;
+        $$->left = $1;
+        $$->right = $3;
+    }
+|
+    product_expression
+    {
+        $$ = $1;
+    }
+
+product_expression:
+    product_expression "*" unary_expression
+    {
+        $$ = new ExpressionItem();
+        $$->type = ExpressionItem::MULTIPLY_EXPRESSION;
+        $$->left = $1;
+        $$->right = $3;
+    }
+|
+    product_expression "/" unary_expression
+    {
+        $$ = new ExpressionItem();
+        $$->type = ExpressionItem::DIVIDE_EXPRESSION;
+        $$->left = $1;
+        $$->right = $3;
+    }
+|
+    product_expression "%" unary_expression
+    {
+        $$ = new ExpressionItem();
+        $$->type = ExpressionItem::MODULO_EXPRESSION;
+        $$->left = $1;
+        $$->right = $3;
+    }
+|
+    unary_expression
+    {
+        $$ = $1;
+    }
+
+unary_expression:
+    "!" unary_expression
+    {
+        $$ = new ExpressionItem();
+        $$->type = ExpressionItem::NOT_EXPRESSION;
+        $$->left = $2;
+    }
+|
+    value_item
+    {
+        $$ = new ExpressionItem();
+        $$->value = $1;
     }
 
 for_each_loop:
@@ -311,15 +481,16 @@ for_each_loop:
         $$->content = $9;
     }
 |
-    "parallel_for" "(" registerable_identifier ":" value_item ")" item_set "{" blossom_group_set "}"
+    "parallel_for" parallel_width "(" registerable_identifier ":" value_item ")" item_set "{" blossom_group_set "}"
     {
         $$ = new ForEachBranching();
-        $$->tempVarName = $3;
-        $$->iterateArray.insert("array", $5);
-        $$->values = *$7;
-        delete $7;
-        $$->content = $9;
+        $$->tempVarName = $4;
+        $$->iterateArray.insert("array", $6);
+        $$->values = *$8;
+        delete $8;
+        $$->content = $10;
         $$->parallel = true;
+        $$->parallelWidth = $2;
     }
 
 for_loop:
@@ -349,31 +520,51 @@ for_loop:
         $$->content = $17;
     }
 |
-    "parallel_for" "(" registerable_identifier "=" value_item ";" "identifier" "<" value_item ";" "identifier" "+" "+" ")" item_set "{" blossom_group_set "}"
+    "parallel_for" parallel_width "(" registerable_identifier "=" value_item ";" "identifier" "<" value_item ";" "identifier" "+" "+" ")" item_set "{" blossom_group_set "}"
     {
-        if($7 != $3)
+        if($8 != $4)
         {
             driver.error(yyla.location,
-                         "undefined identifier \"" + $7 + "\"",
+                         "undefined identifier \"" + $8 + "\"",
                          true);
             return 1;
         }
-        if($11 != $3)
+        if($12 != $4)
         {
             driver.error(yyla.location,
-                         "undefined identifier \"" + $11 + "\"",
+                         "undefined identifier \"" + $12 + "\"",
                          true);
             return 1;
         }
 
         $$ = new ForBranching();
-        $$->tempVarName = $3;
-        $$->start = $5;
-        $$->end = $9;
-        $$->values = *$15;
-        delete $15;
-        $$->content = $17;
+        $$->tempVarName = $4;
+        $$->start = $6;
+        $$->end = $10;
+        $$->values = *$16;
+        delete $16;
+        $$->content = $18;
         $$->parallel = true;
+        $$->parallelWidth = $2;
+    }
+
+parallel_width:
+    %empty
+    {
+        $$ = 0;
+    }
+|
+    "<" "number" ">"
+    {
+        if($2 <= 0)
+        {
+            driver.error(yyla.location,
+                         "width of a parallel loop must be greater than 0",
+                         true);
+            return 1;
+        }
+
+        $$ = static_cast<uint32_t>($2);
     }
 
 parallel:
@@ -706,6 +897,48 @@ subtree_fork:
         $$->values = *$5;
         delete $5;
     }
+|
+    "subtree" "<" "identifier" ">" "(" name_item ")" item_set
+    {
+        if($3 != "cached")
+        {
+            driver.error(yyla.location,
+                         "unknown subtree-option \"" + $3 + "\"",
+                         true);
+            return 1;
+        }
+
+        $$ = new SubtreeItem();
+        $$->nameOrPath = $6;
+        $$->values = *$8;
+        delete $8;
+        $$->isCached = true;
+    }
+|
+    "subtree" "<" "identifier" "(" "number" ")" ">" "(" name_item ")" item_set
+    {
+        if($3 != "cached")
+        {
+            driver.error(yyla.location,
+                         "unknown subtree-option \"" + $3 + "\"",
+                         true);
+            return 1;
+        }
+        if($5 <= 0)
+        {
+            driver.error(yyla.location,
+                         "time-to-live of a cached subtree must be greater than 0",
+                         true);
+            return 1;
+        }
+
+        $$ = new SubtreeItem();
+        $$->nameOrPath = $9;
+        $$->values = *$11;
+        delete $11;
+        $$->isCached = true;
+        $$->cacheTimeToLive = static_cast<uint32_t>($5);
+    }
 
 value_item_list:
     value_item_list ","  value_item
@@ -721,6 +954,14 @@ value_item_list:
     }
 
 value_item:
+    "(" expression ")"
+    {
+        ValueItem newItem;
+        newItem.item = new DataValue("");
+        newItem.expression = $2;
+        $$ = newItem;
+    }
+|
     "float"
     {
         ValueItem newItem;
@@ -884,6 +1125,48 @@ function:
         delete $4;
         $$ = newItem;
     }
+|
+    "." "identifier" "(" lambda ")"
+    {
+        FunctionItem newItem;
+        newItem.type = $2;
+        newItem.arguments.push_back($4);
+        $$ = newItem;
+    }
+|
+    "." "identifier" "(" lambda "," value_item_list ")"
+    {
+        FunctionItem newItem;
+        newItem.type = $2;
+        newItem.arguments.push_back($4);
+        newItem.arguments.insert(newItem.arguments.end(), $6->begin(), $6->end());
+        delete $6;
+        $$ = newItem;
+    }
+
+lambda:
+    "|" lambda_parameters "|" expression
+    {
+        ValueItem newItem;
+        newItem.item = new DataValue("");
+        newItem.expression = $4;
+        newItem.expression->parameters = *$2;
+        delete $2;
+        $$ = newItem;
+    }
+
+lambda_parameters:
+    lambda_parameters "," registerable_identifier
+    {
+        $1->push_back($3);
+        $$ = $1;
+    }
+|
+    registerable_identifier
+    {
+        $$ = new std::vector<std::string>();
+        $$->push_back($1);
+    }
 
 string_text:
     string_text "string"
@@ -943,6 +1226,46 @@ access:
         value.item = new DataValue(driver.removeQuotes($2));
         newItem.arguments.push_back(value);
 
+        $$ = newItem;
+    }
+|
+    "[" "number" ":" "number" "]"
+    {
+        FunctionItem newItem;
+        newItem.type = "slice";
+
+        ValueItem start;
+        start.item = new DataValue($2);
+        newItem.arguments.push_back(start);
+
+        ValueItem end;
+        end.item = new DataValue($4);
+        newItem.arguments.push_back(end);
+
+        $$ = newItem;
+    }
+|
+    "[" "number" ":" "]"
+    {
+        FunctionItem newItem;
+        newItem.type = "skip";
+
+        ValueItem start;
+        start.item = new DataValue($2);
+        newItem.arguments.push_back(start);
+
+        $$ = newItem;
+    }
+|
+    "[" ":" "number" "]"
+    {
+        FunctionItem newItem;
+        newItem.type = "take";
+
+        ValueItem end;
+        end.item = new DataValue($3);
+        newItem.arguments.push_back(end);
+
         $$ = newItem;
     }
 
@@ -26,8 +26,11 @@
 #include <thread>
 #include <chrono>
 #include <mutex>
+#include <condition_variable>
 #include <queue>
 
+#include <processing/wait_list.h>
+
 namespace Kitsunemimi
 {
 namespace Sakura
@@ -43,6 +46,7 @@ namespace Sakura
 struct ActiveCounter
 {
     std::mutex lock;
+    WaitList waitList;
     uint32_t isCounter = 0;
     uint32_t shouldCount = 0;
 
@@ -50,11 +54,29 @@ struct ActiveCounter
 
     /**
      * @brief increase the counter
+     *
+     * @param finished finish-flag of the subtree, which is set together with the counter, so the
+     *                 source-thread can't delete the subtree, before it is fully processed
      */
-    void increaseCounter()
+    void increaseCounter(bool &finished)
     {
         std::lock_guard<std::mutex> guard(lock);
+        finished = true;
         isCounter++;
+        waitList.notifyAll();
+    }
+
+    /**
+     * @brief check the finish-flag of a subtree
+     *
+     * @param finished finish-flag, which was given to increaseCounter
+     *
+     * @return true, if the subtree is finished, else false
+     */
+    bool isFinished(const bool &finished)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return finished;
     }
 
     /**
@@ -67,6 +89,39 @@ struct ActiveCounter
         std::lock_guard<std::mutex> guard(lock);
         return isCounter == shouldCount;
     }
+
+    /**
+     * @brief wait until the counter is bigger than a value
+     *
+     * @param value value to compare with
+     * @param worker worker-thread, which parks the current plan while waiting, or nullptr to
+     *               block the calling thread
+     *
+     * @return new value of the counter
+     */
+    uint32_t waitUntilAbove(const uint32_t value,
+                            SakuraThread* worker)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while(isCounter <= value) {
+            waitList.wait(guard, worker);
+        }
+        return isCounter;
+    }
+
+    /**
+     * @brief wait until the counter has reached the expected value
+     *
+     * @param worker worker-thread, which parks the current plan while waiting, or nullptr to
+     *               block the calling thread
+     */
+    void waitUntilEqual(SakuraThread* worker)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while(isCounter != shouldCount) {
+            waitList.wait(guard, worker);
+        }
+    }
 };
 
 } // namespace Sakura
@@ -0,0 +1,111 @@
+/**
+ * @file        concurrency_limit.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_CONCURRENCY_LIMIT_H
+#define KITSUNEMIMI_SAKURA_LANG_CONCURRENCY_LIMIT_H
+
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+#include <processing/wait_list.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief The ConcurrencyLimit struct is a thread-save counter for the number of running tasks of
+ *        a blossom. All instances of a blossom share the same limit, so the limit is also valid
+ *        for blossoms, which are registered by a factory.
+ */
+struct ConcurrencyLimit
+{
+    // request of a caller, which waits for a free slot
+    struct SlotRequest
+    {
+        bool granted = false;
+        WaitList waitList;
+    };
+
+    std::mutex lock;
+    std::deque<SlotRequest*> requests;
+    uint32_t activeCounter = 0;
+    uint32_t maxActive = 0;
+
+    ConcurrencyLimit(const uint32_t maxActive)
+    {
+        this->maxActive = maxActive;
+    }
+
+    /**
+     * @brief take a free slot or wait in the queue of the limit, until a slot is given to the
+     *        caller by a release
+     *
+     * @param worker worker-thread, which parks the current plan while waiting, or nullptr to
+     *               block the calling thread
+     */
+    void acquire(SakuraThread* worker)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+
+        // callers, which are already waiting, get the next free slots first
+        if(activeCounter < maxActive
+                && requests.empty())
+        {
+            activeCounter++;
+            return;
+        }
+
+        SlotRequest request;
+        requests.push_back(&request);
+        while(request.granted == false) {
+            request.waitList.wait(guard, worker);
+        }
+    }
+
+    /**
+     * @brief give back a slot. If callers are waiting, the slot is given directly to the oldest
+     *        one, so it can not be taken by another caller, before the waiting plan continues.
+     */
+    void release()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        if(requests.empty())
+        {
+            activeCounter--;
+            return;
+        }
+
+        SlotRequest* request = requests.front();
+        requests.pop_front();
+        request->granted = true;
+        request->waitList.notifyAll();
+    }
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_CONCURRENCY_LIMIT_H
@@ -1,5 +1,7 @@
 #include "growth_plan.h"
 
+#include <processing/result_cache.h>
+
 namespace Kitsunemimi
 {
 namespace Sakura
@@ -14,6 +16,10 @@ GrowthPlan::~GrowthPlan()
     }
 
     clearChilds();
+
+    if(callCache != nullptr) {
+        delete callCache;
+    }
 }
 
 void
@@ -39,5 +45,25 @@ GrowthPlan::getErrorResult()
     }
 }
 
+/**
+ * @brief get the cache for subtree-calls of the current run, which is hold by the root-plan and
+ *        created with the first request
+ */
+ResultCache*
+GrowthPlan::getCallCache()
+{
+    GrowthPlan* rootPlan = this;
+    while(rootPlan->parentPlan != nullptr) {
+        rootPlan = rootPlan->parentPlan;
+    }
+
+    std::lock_guard<std::mutex> guard(rootPlan->callCacheLock);
+    if(rootPlan->callCache == nullptr) {
+        rootPlan->callCache = new ResultCache(DEFAULT_CACHE_SIZE);
+    }
+
+    return rootPlan->callCache;
+}
+
 } // namespace Sakura
 } // namespace Kitsunemimi
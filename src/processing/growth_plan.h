@@ -1,6 +1,8 @@
 #ifndef KITSUNEMIMI_SAKURA_LANG_GROWTHPLAN_H
 #define KITSUNEMIMI_SAKURA_LANG_GROWTHPLAN_H
 
+#include <atomic>
+
 #include <items/sakura_items.h>
 #include <processing/active_counter.h>
 
@@ -9,6 +11,8 @@ namespace Kitsunemimi
 namespace Sakura
 {
 class SakuraItem;
+class ResultCache;
+class IncrementalRecord;
 
 class GrowthPlan
 {
@@ -26,6 +30,8 @@ public:
     // shared counter-instance, which will be increased after the subtree was fully processed
     ActiveCounter activeCounter;
     GrowthPlan* parentPlan = nullptr;
+    // set together with the counter of the parent, after the subtree was fully processed
+    bool finished = false;
     // current position in the processing-hirarchy for status-output
     std::vector<std::string> hirarchy;
     std::string filePath = "";
@@ -33,11 +39,22 @@ public:
     std::vector<GrowthPlan*> childPlans;
     ValueItemMap postAggregation;
 
+    // number of cached calls, which are led by this plan and not given back to the cache yet
+    std::atomic<uint32_t> numberOfLeadCalls = {0};
+
+    // results of cached subtree-calls, which are valid for the whole run (only used by the root)
+    ResultCache* callCache = nullptr;
+    std::mutex callCacheLock;
+
+    // record of the previous run, if the tree is triggered incremental
+    IncrementalRecord* incrementalRecord = nullptr;
+
     GrowthPlan();
     ~GrowthPlan();
 
     void clearChilds();
     void getErrorResult();
+    ResultCache* getCallCache();
 };
 
 } // namespace Sakura
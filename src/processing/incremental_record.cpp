@@ -0,0 +1,263 @@
+/**
+ * @file        incremental_record.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "incremental_record.h"
+
+#include <processing/result_cache.h>
+#include <items/item_methods.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief constructor
+ */
+IncrementalRecord::IncrementalRecord() {}
+
+/**
+ * @brief destructor
+ */
+IncrementalRecord::~IncrementalRecord()
+{
+    clearEntries(m_previousRun);
+    clearEntries(m_currentRun);
+
+    if(m_initialValues != nullptr) {
+        delete m_initialValues;
+    }
+    if(m_context != nullptr) {
+        delete m_context;
+    }
+}
+
+/**
+ * @brief prepare a new run by merging the changed values into the input-values of the last run.
+ *        If the context has changed since the last run, the recorded calls are dropped, because
+ *        each blossom can depend on the context.
+ *
+ * @param initialValues reference for the resulting input-values of the new run
+ * @param changedValues values, which have changed since the last run
+ * @param removedKeys keys of input-values of the last run, which are removed
+ * @param context context of the new run
+ */
+void
+IncrementalRecord::startRun(DataMap &initialValues,
+                            const DataMap &changedValues,
+                            const std::vector<std::string> &removedKeys,
+                            const DataMap &context)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    initialValues.clear();
+    if(m_initialValues != nullptr) {
+        overrideItems(initialValues, *m_initialValues, ALL);
+    }
+    for(const std::string &key : removedKeys) {
+        initialValues.remove(key);
+    }
+    overrideItems(initialValues, changedValues, ALL);
+
+    DataMap* newContext = context.copy()->toMap();
+    if(m_context != nullptr
+            && ResultCache::isEqual(m_context, newContext) == false)
+    {
+        clearEntries(m_previousRun);
+    }
+
+    if(m_context != nullptr) {
+        delete m_context;
+    }
+    m_context = newContext;
+
+    clearEntries(m_currentRun);
+    m_reusedBlossoms = 0;
+    m_executedBlossoms = 0;
+}
+
+/**
+ * @brief finish a run. After a successful run its calls replace the calls of the previous run,
+ *        so the record only grows with the size of a single run.
+ *
+ * @param initialValues input-values of the finished run
+ * @param success true, if the run was successful
+ */
+void
+IncrementalRecord::finishRun(const DataMap &initialValues,
+                             const bool success)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if(success == false)
+    {
+        clearEntries(m_currentRun);
+        return;
+    }
+
+    clearEntries(m_previousRun);
+    m_previousRun.swap(m_currentRun);
+
+    if(m_initialValues != nullptr) {
+        delete m_initialValues;
+    }
+    m_initialValues = initialValues.copy()->toMap();
+}
+
+/**
+ * @brief get the recorded output of a call of the previous run with the same input
+ *
+ * @param output reference for the recorded output-values
+ * @param callId identifier of the blossom-call within the tree
+ * @param input filled input-values of the call
+ *
+ * @return true, if the output was found, else false
+ */
+bool
+IncrementalRecord::getOutput(DataMap &output,
+                             const std::string &callId,
+                             DataMap* input)
+{
+    const std::string key = createKey(callId, input);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    std::map<std::string, RecordEntry>::iterator it;
+    it = m_previousRun.find(key);
+    if(it == m_previousRun.end()
+            || ResultCache::isEqual(it->second.input, input) == false)
+    {
+        m_executedBlossoms++;
+        return false;
+    }
+
+    overrideItems(output, *it->second.output, ALL);
+
+    // move the call into the record of the current run
+    std::map<std::string, RecordEntry>::iterator currentIt;
+    currentIt = m_currentRun.find(key);
+    if(currentIt != m_currentRun.end())
+    {
+        delete currentIt->second.input;
+        delete currentIt->second.output;
+        m_currentRun.erase(currentIt);
+    }
+    m_currentRun.insert(std::make_pair(key, it->second));
+    m_previousRun.erase(it);
+
+    m_reusedBlossoms++;
+
+    return true;
+}
+
+/**
+ * @brief record a call of the current run
+ *
+ * @param callId identifier of the blossom-call within the tree
+ * @param input filled input-values of the call, which is owned by the record afterwards
+ * @param output output-values of the call, which is owned by the record afterwards
+ */
+void
+IncrementalRecord::addOutput(const std::string &callId,
+                             DataMap* input,
+                             DataMap* output)
+{
+    const std::string key = createKey(callId, input);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    std::map<std::string, RecordEntry>::iterator it;
+    it = m_currentRun.find(key);
+    if(it != m_currentRun.end())
+    {
+        delete it->second.input;
+        delete it->second.output;
+        m_currentRun.erase(it);
+    }
+
+    RecordEntry entry;
+    entry.input = input;
+    entry.output = output;
+    m_currentRun.insert(std::make_pair(key, entry));
+}
+
+/**
+ * @brief count a call of the current run, which is executed without being recorded
+ */
+void
+IncrementalRecord::countExecution()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_executedBlossoms++;
+}
+
+/**
+ * @brief get the number of reused and executed blossoms of the last run
+ *
+ * @param statistics reference for the output
+ */
+void
+IncrementalRecord::getStatistics(IncrementalStatistics &statistics)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    statistics.reusedBlossoms = m_reusedBlossoms;
+    statistics.executedBlossoms = m_executedBlossoms;
+}
+
+/**
+ * @brief create the key of a call out of its position within the tree and the hash of its input
+ *
+ * @param callId identifier of the blossom-call within the tree
+ * @param input filled input-values of the call
+ *
+ * @return key of the call
+ */
+const std::string
+IncrementalRecord::createKey(const std::string &callId,
+                             DataMap* input)
+{
+    return callId + "|" + std::to_string(ResultCache::hashItem(input));
+}
+
+/**
+ * @brief delete all entries of a record
+ *
+ * @param entries entries to delete
+ */
+void
+IncrementalRecord::clearEntries(std::map<std::string, RecordEntry> &entries)
+{
+    std::map<std::string, RecordEntry>::const_iterator it;
+    for(it = entries.begin();
+        it != entries.end();
+        it++)
+    {
+        delete it->second.input;
+        delete it->second.output;
+    }
+
+    entries.clear();
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,95 @@
+/**
+ * @file        incremental_record.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_INCREMENTAL_RECORD_H
+#define KITSUNEMIMI_SAKURA_LANG_INCREMENTAL_RECORD_H
+
+#include <string>
+#include <map>
+#include <vector>
+#include <mutex>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+#include <libKitsunemimiSakuraLang/structs.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief Record of the blossom-calls of the last run of a tree. Each call is stored with its
+ *        filled input-values, which contain all values, the call depended on, and its output.
+ *        Calls of the next run with the same input reuse the recorded output instead of
+ *        executing the blossom again.
+ */
+class IncrementalRecord
+{
+public:
+    IncrementalRecord();
+    ~IncrementalRecord();
+
+    void startRun(DataMap &initialValues,
+                  const DataMap &changedValues,
+                  const std::vector<std::string> &removedKeys,
+                  const DataMap &context);
+    void finishRun(const DataMap &initialValues,
+                   const bool success);
+
+    bool getOutput(DataMap &output,
+                   const std::string &callId,
+                   DataMap* input);
+    void addOutput(const std::string &callId,
+                   DataMap* input,
+                   DataMap* output);
+    void countExecution();
+
+    void getStatistics(IncrementalStatistics &statistics);
+
+private:
+    struct RecordEntry
+    {
+        DataMap* input = nullptr;
+        DataMap* output = nullptr;
+    };
+
+    std::mutex m_lock;
+
+    // input-values and context of the last successful run
+    DataMap* m_initialValues = nullptr;
+    DataMap* m_context = nullptr;
+
+    std::map<std::string, RecordEntry> m_previousRun;
+    std::map<std::string, RecordEntry> m_currentRun;
+
+    uint64_t m_reusedBlossoms = 0;
+    uint64_t m_executedBlossoms = 0;
+
+    const std::string createKey(const std::string &callId,
+                                DataMap* input);
+    void clearEntries(std::map<std::string, RecordEntry> &entries);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_INCREMENTAL_RECORD_H
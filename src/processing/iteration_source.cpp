@@ -0,0 +1,238 @@
+/**
+ * @file        iteration_source.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+
+#include "iteration_source.h"
+
+#include <items/value_item_functions.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+IterationSource::IterationSource() {}
+
+IterationSource::~IterationSource() {}
+
+//==================================================================================================
+// ArraySource
+//==================================================================================================
+
+/**
+ * @brief constructor
+ *
+ * @param array array, which is owned by the loop. Its entries are moved out of the array
+ *              instead of being copied.
+ */
+ArraySource::ArraySource(DataArray* array)
+{
+    m_array = array;
+}
+
+/**
+ * @brief destructor, which removes the entries, which were moved out of the array
+ */
+ArraySource::~ArraySource()
+{
+    m_array->array.erase(m_array->array.begin(), m_array->array.begin() + m_pos);
+}
+
+/**
+ * @brief get the next entry of the array
+ *
+ * @return next entry, or nullptr, if the end of the array was reached
+ */
+DataItem*
+ArraySource::next()
+{
+    if(m_pos >= m_array->array.size()) {
+        return nullptr;
+    }
+
+    DataItem* result = m_array->array[m_pos];
+    m_array->array[m_pos] = nullptr;
+    m_pos++;
+
+    return result;
+}
+
+/**
+ * @brief check if at least two more entries follow
+ */
+bool
+ArraySource::hasMultipleEntries() const
+{
+    return m_array->array.size() >= m_pos + 2;
+}
+
+//==================================================================================================
+// RangeSource
+//==================================================================================================
+
+/**
+ * @brief constructor
+ *
+ * @param start first number
+ * @param end number behind the last number
+ */
+RangeSource::RangeSource(const uint64_t start,
+                         const uint64_t end)
+{
+    m_pos = start;
+    m_end = end;
+}
+
+RangeSource::~RangeSource() {}
+
+/**
+ * @brief get the next number of the range
+ *
+ * @return next number as int-value, or nullptr, if the end of the range was reached
+ */
+DataItem*
+RangeSource::next()
+{
+    if(m_pos >= m_end) {
+        return nullptr;
+    }
+
+    DataItem* result = new DataValue(static_cast<long>(m_pos));
+    m_pos++;
+
+    return result;
+}
+
+/**
+ * @brief check if at least two more numbers follow
+ */
+bool
+RangeSource::hasMultipleEntries() const
+{
+    return m_end > m_pos
+           && m_end - m_pos >= 2;
+}
+
+//==================================================================================================
+// SplitSource
+//==================================================================================================
+
+/**
+ * @brief constructor
+ *
+ * @param text text to split, which must exist until the end of the loop
+ * @param delimiter non-empty delimiter between the parts of the text
+ */
+SplitSource::SplitSource(const std::string_view &text,
+                         const std::string &delimiter)
+{
+    m_text = text;
+    m_delimiter = delimiter;
+}
+
+SplitSource::~SplitSource() {}
+
+/**
+ * @brief get the next part of the text. Like the split-function, a delimiter at the end of the
+ *        text doesn't create an additional empty part.
+ *
+ * @return next part as string-value, or nullptr, if the end of the text was reached
+ */
+DataItem*
+SplitSource::next()
+{
+    std::string_view part;
+    if(getNextSplitPart(part, m_pos, m_text, m_delimiter) == false) {
+        return nullptr;
+    }
+
+    return new DataValue(std::string(part));
+}
+
+/**
+ * @brief check if at least two more parts follow. This is the case, if there is a delimiter
+ *        behind the next part, which is not at the end of the text.
+ */
+bool
+SplitSource::hasMultipleEntries() const
+{
+    if(m_pos >= m_text.size()) {
+        return false;
+    }
+
+    const uint64_t found = m_text.find(m_delimiter, m_pos);
+
+    return found != std::string_view::npos
+           && found + m_delimiter.size() < m_text.size();
+}
+
+//==================================================================================================
+// ChunkSource
+//==================================================================================================
+
+/**
+ * @brief constructor
+ *
+ * @param text text to split into chunks, which must exist until the end of the loop
+ * @param chunkSize maximum size of each chunk, which must be greater than 0
+ */
+ChunkSource::ChunkSource(const std::string_view &text,
+                         const uint64_t chunkSize)
+{
+    m_text = text;
+    m_chunkSize = chunkSize;
+}
+
+ChunkSource::~ChunkSource() {}
+
+/**
+ * @brief get the next chunk of the text
+ *
+ * @return next chunk as string-value, or nullptr, if the end of the text was reached
+ */
+DataItem*
+ChunkSource::next()
+{
+    if(m_pos >= m_text.size()) {
+        return nullptr;
+    }
+
+    DataItem* result = new DataValue(std::string(m_text.substr(m_pos, m_chunkSize)));
+    m_pos += m_chunkSize;
+
+    return result;
+}
+
+/**
+ * @brief check if at least two more chunks follow
+ */
+bool
+ChunkSource::hasMultipleEntries() const
+{
+    return m_text.size() > m_pos
+           && m_text.size() - m_pos > m_chunkSize;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,140 @@
+/**
+ * @file        iteration_source.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_ITERATION_SOURCE_H
+#define KITSUNEMIMI_SAKURA_LANG_ITERATION_SOURCE_H
+
+#include <string>
+#include <string_view>
+
+namespace Kitsunemimi
+{
+class DataItem;
+class DataArray;
+
+namespace Sakura
+{
+
+/**
+ * @brief Source of the entries of a loop, which creates the entries one after another, while
+ *        the loop is running, so the entries don't have to be created all before the loop.
+ */
+class IterationSource
+{
+public:
+    IterationSource();
+    virtual ~IterationSource();
+
+    /**
+     * @brief get the next entry
+     *
+     * @return new data-item, which is owned by the caller, or nullptr, if there are no more
+     *         entries
+     */
+    virtual DataItem* next() = 0;
+
+    /**
+     * @brief check if at least two more entries follow, without creating them
+     *
+     * @return true, if there are at least two more entries, else false
+     */
+    virtual bool hasMultipleEntries() const = 0;
+};
+
+//==================================================================================================
+
+class ArraySource
+        : public IterationSource
+{
+public:
+    ArraySource(DataArray* array);
+    ~ArraySource();
+
+    DataItem* next();
+    bool hasMultipleEntries() const;
+
+private:
+    DataArray* m_array = nullptr;
+    uint64_t m_pos = 0;
+};
+
+//==================================================================================================
+
+class RangeSource
+        : public IterationSource
+{
+public:
+    RangeSource(const uint64_t start,
+                const uint64_t end);
+    ~RangeSource();
+
+    DataItem* next();
+    bool hasMultipleEntries() const;
+
+private:
+    uint64_t m_pos = 0;
+    uint64_t m_end = 0;
+};
+
+//==================================================================================================
+
+class SplitSource
+        : public IterationSource
+{
+public:
+    SplitSource(const std::string_view &text,
+                const std::string &delimiter);
+    ~SplitSource();
+
+    DataItem* next();
+    bool hasMultipleEntries() const;
+
+private:
+    std::string_view m_text;
+    std::string m_delimiter;
+    uint64_t m_pos = 0;
+};
+
+//==================================================================================================
+
+class ChunkSource
+        : public IterationSource
+{
+public:
+    ChunkSource(const std::string_view &text,
+                const uint64_t chunkSize);
+    ~ChunkSource();
+
+    DataItem* next();
+    bool hasMultipleEntries() const;
+
+private:
+    std::string_view m_text;
+    uint64_t m_chunkSize = 0;
+    uint64_t m_pos = 0;
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_ITERATION_SOURCE_H
@@ -0,0 +1,561 @@
+/**
+ * @file        result_cache.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "result_cache.h"
+
+#include <processing/sakura_thread.h>
+#include <processing/growth_plan.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief add bytes to a fnv1a-hash
+ *
+ * @param data pointer to the bytes
+ * @param size number of bytes
+ * @param hash previous hash-value
+ *
+ * @return new hash-value
+ */
+inline uint64_t
+addToHash(const void* data,
+          const uint64_t size,
+          uint64_t hash)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for(uint64_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+// number of calls, which are led by the current thread outside of a plan and not given back to
+// the cache yet
+thread_local uint32_t numberOfLeadCalls = 0;
+
+/**
+ * @brief get the plan, which is processed by the worker-thread at the moment
+ *
+ * @param worker worker-thread or nullptr
+ *
+ * @return current plan or nullptr, if the caller is not a plan
+ */
+inline GrowthPlan*
+getCurrentGrowthPlan(SakuraThread* worker)
+{
+    if(worker == nullptr
+            || worker->getCurrentPlan() == nullptr)
+    {
+        return nullptr;
+    }
+
+    return worker->getCurrentPlan()->plan;
+}
+
+/**
+ * @brief check if a plan or one of its parents leads a call, which is not finished yet. The
+ *        results of the led calls depend on the child-plans, so a child is also not allowed to
+ *        wait for other calls.
+ *
+ * @param plan plan to check or nullptr for a caller without plan
+ *
+ * @return true, if the caller leads a call, else false
+ */
+inline bool
+isLeadingCall(const GrowthPlan* plan)
+{
+    if(plan == nullptr) {
+        return numberOfLeadCalls > 0;
+    }
+
+    while(plan != nullptr)
+    {
+        if(plan->numberOfLeadCalls > 0) {
+            return true;
+        }
+        plan = plan->parentPlan;
+    }
+
+    return false;
+}
+
+/**
+ * @brief constructor
+ *
+ * @param maxEntries maximum number of entries within the cache
+ * @param timeToLive time in seconds, how long an entry is valid (0 = unlimited)
+ */
+ResultCache::ResultCache(const uint64_t maxEntries,
+                         const uint32_t timeToLive)
+    : m_timeToLive(timeToLive)
+{
+    // use less shards for small caches, so the sum of all shards is not bigger than the cache
+    m_numberOfShards = NUMBER_OF_CACHE_SHARDS;
+    if(maxEntries < NUMBER_OF_CACHE_SHARDS) {
+        m_numberOfShards = maxEntries;
+    }
+    if(m_numberOfShards == 0) {
+        m_numberOfShards = 1;
+    }
+
+    m_maxEntriesPerShard = maxEntries / m_numberOfShards;
+    if(m_maxEntriesPerShard == 0) {
+        m_maxEntriesPerShard = 1;
+    }
+}
+
+/**
+ * @brief destructor
+ */
+ResultCache::~ResultCache()
+{
+    clear();
+}
+
+/**
+ * @brief get the result for the input of the ticket. If the same input is already processed by
+ *        another call at the moment, this call waits for its result instead of running it again.
+ *
+ * @param output map, where the values of the cached result are added
+ * @param ticket ticket with the input of the call. In case of a miss, it has to be given to set
+ *               after the call is done.
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr to block
+ *               the calling thread
+ *
+ * @return true, if the result was found, else false
+ */
+bool
+ResultCache::get(DataMap &output,
+                 CacheTicket &ticket,
+                 SakuraThread* worker)
+{
+    ticket.hash = hashItem(ticket.input);
+    ticket.isLeader = false;
+    ticket.leadingPlan = getCurrentGrowthPlan(worker);
+    Shard &shard = getShard(ticket.hash);
+
+    while(true)
+    {
+        shard.lock.lock();
+
+        // search for a stored result
+        std::unordered_map<uint64_t, std::list<CacheEntry>::iterator>::iterator indexIt;
+        indexIt = shard.index.find(ticket.hash);
+        if(indexIt != shard.index.end())
+        {
+            std::list<CacheEntry>::iterator entryIt = indexIt->second;
+            if(m_timeToLive.count() > 0
+                    && std::chrono::steady_clock::now() - entryIt->timestamp > m_timeToLive)
+            {
+                removeEntry(shard, entryIt);
+            }
+            else if(isEqual(entryIt->input, ticket.input))
+            {
+                // mark as recently used
+                shard.entries.splice(shard.entries.begin(), shard.entries, entryIt);
+
+                std::map<std::string, DataItem*>::const_iterator it;
+                for(it = entryIt->output->map.begin();
+                    it != entryIt->output->map.end();
+                    it++)
+                {
+                    output.insert(it->first, it->second->copy(), true);
+                }
+
+                shard.lock.unlock();
+                m_hits++;
+                return true;
+            }
+        }
+
+        // search for a running call with the same input
+        std::unordered_map<uint64_t, std::shared_ptr<PendingCall>>::const_iterator pendingIt;
+        pendingIt = shard.pending.find(ticket.hash);
+        if(pendingIt == shard.pending.end())
+        {
+            std::shared_ptr<PendingCall> pendingCall = std::make_shared<PendingCall>();
+            pendingCall->input = ticket.input;
+            shard.pending.insert(std::make_pair(ticket.hash, pendingCall));
+            ticket.isLeader = true;
+            if(ticket.leadingPlan != nullptr) {
+                ticket.leadingPlan->numberOfLeadCalls++;
+            } else {
+                numberOfLeadCalls++;
+            }
+
+            shard.lock.unlock();
+            m_misses++;
+            return false;
+        }
+
+        // a plan, which leads other calls, doesn't wait, because the leader of the running
+        // call could wait for one of these calls. Other plans on the same worker-thread are
+        // not affected, because they are parked independently. A call with another input only
+        // has the same hash. So in both cases this call has to run itself.
+        std::shared_ptr<PendingCall> pendingCall = pendingIt->second;
+        if(isLeadingCall(ticket.leadingPlan)
+                || isEqual(pendingCall->input, ticket.input) == false)
+        {
+            shard.lock.unlock();
+            m_misses++;
+            return false;
+        }
+
+        shard.lock.unlock();
+        m_coalesced++;
+
+        // wait for the running call and try again. If the call failed, there is no result
+        // in the cache and this call becomes the new leader.
+        waitForCall(shard, *pendingCall, worker);
+    }
+}
+
+/**
+ * @brief wait until a running call is given back to the cache
+ *
+ * @param shard shard, which contains the call
+ * @param pendingCall call to wait for
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr to block
+ *               the calling thread
+ */
+void
+ResultCache::waitForCall(Shard &shard,
+                         PendingCall &pendingCall,
+                         SakuraThread* worker)
+{
+    std::unique_lock<std::mutex> lock(shard.lock);
+    while(pendingCall.finished == false) {
+        pendingCall.waitList.wait(lock, worker);
+    }
+}
+
+/**
+ * @brief get the shard for a hash
+ *
+ * @param hash hash of the input
+ *
+ * @return shard, which is responsible for the hash
+ */
+ResultCache::Shard&
+ResultCache::getShard(const uint64_t hash)
+{
+    return m_shards[hash % m_numberOfShards];
+}
+
+/**
+ * @brief store the result of a call after a miss and release all calls, which are waiting for
+ *        this result
+ *
+ * @param ticket ticket of the call, which was given to get before
+ * @param output result of the call, which is owned by the cache afterwards, or nullptr, if the
+ *               call failed
+ */
+void
+ResultCache::set(CacheTicket &ticket,
+                 DataMap* output)
+{
+    Shard &shard = getShard(ticket.hash);
+
+    shard.lock.lock();
+
+    if(ticket.isLeader)
+    {
+        std::unordered_map<uint64_t, std::shared_ptr<PendingCall>>::iterator pendingIt;
+        pendingIt = shard.pending.find(ticket.hash);
+        if(pendingIt != shard.pending.end())
+        {
+            pendingIt->second->finished = true;
+            pendingIt->second->waitList.notifyAll();
+            shard.pending.erase(pendingIt);
+        }
+        ticket.isLeader = false;
+        if(ticket.leadingPlan != nullptr) {
+            ticket.leadingPlan->numberOfLeadCalls--;
+        } else {
+            numberOfLeadCalls--;
+        }
+    }
+
+    if(output != nullptr)
+    {
+        // replace old entry with the same hash
+        std::unordered_map<uint64_t, std::list<CacheEntry>::iterator>::iterator indexIt;
+        indexIt = shard.index.find(ticket.hash);
+        if(indexIt != shard.index.end()) {
+            removeEntry(shard, indexIt->second);
+        }
+
+        CacheEntry entry;
+        entry.hash = ticket.hash;
+        entry.input = ticket.input;
+        entry.output = output;
+        entry.timestamp = std::chrono::steady_clock::now();
+        ticket.input = nullptr;
+
+        shard.entries.push_front(entry);
+        shard.index.insert(std::make_pair(entry.hash, shard.entries.begin()));
+
+        // remove least recently used entries
+        while(shard.entries.size() > m_maxEntriesPerShard)
+        {
+            removeEntry(shard, std::prev(shard.entries.end()));
+            m_evictions++;
+        }
+    }
+
+    shard.lock.unlock();
+}
+
+/**
+ * @brief remove all stored results
+ */
+void
+ResultCache::clear()
+{
+    for(Shard &shard : m_shards)
+    {
+        shard.lock.lock();
+        for(CacheEntry &entry : shard.entries)
+        {
+            delete entry.input;
+            delete entry.output;
+        }
+        shard.entries.clear();
+        shard.index.clear();
+        shard.lock.unlock();
+    }
+}
+
+/**
+ * @brief get statistics of the usage of the cache
+ *
+ * @param statistics reference for the output
+ */
+void
+ResultCache::getStatistics(CacheStatistics &statistics)
+{
+    statistics.hits = m_hits;
+    statistics.misses = m_misses;
+    statistics.coalesced = m_coalesced;
+    statistics.evictions = m_evictions;
+    statistics.numberOfEntries = 0;
+
+    for(Shard &shard : m_shards)
+    {
+        shard.lock.lock();
+        statistics.numberOfEntries += shard.entries.size();
+        shard.lock.unlock();
+    }
+}
+
+/**
+ * @brief calculate a hash over the structure and the values of a data-item, so equal items
+ *        have the same hash, independent from their position in memory
+ *
+ * @param item item to hash
+ * @param hash previous hash-value
+ *
+ * @return new hash-value
+ */
+uint64_t
+ResultCache::hashItem(DataItem* item,
+                      uint64_t hash)
+{
+    if(item == nullptr) {
+        return addToHash("", 1, hash);
+    }
+
+    const uint8_t type = static_cast<uint8_t>(item->getType());
+    hash = addToHash(&type, 1, hash);
+
+    if(item->isMap())
+    {
+        DataMap* map = item->toMap();
+        const uint64_t size = map->map.size();
+        hash = addToHash(&size, sizeof(size), hash);
+
+        // the keys are sorted, so the order of the insert doesn't change the hash
+        std::map<std::string, DataItem*>::const_iterator it;
+        for(it = map->map.begin();
+            it != map->map.end();
+            it++)
+        {
+            hash = addToHash(it->first.c_str(), it->first.size() + 1, hash);
+            hash = hashItem(it->second, hash);
+        }
+    }
+    else if(item->isArray())
+    {
+        DataArray* array = item->toArray();
+        const uint64_t size = array->array.size();
+        hash = addToHash(&size, sizeof(size), hash);
+
+        for(DataItem* entry : array->array) {
+            hash = hashItem(entry, hash);
+        }
+    }
+    else if(item->isValue())
+    {
+        DataValue* value = item->toValue();
+        const uint8_t valueType = static_cast<uint8_t>(value->getValueType());
+        hash = addToHash(&valueType, 1, hash);
+
+        if(value->isStringValue())
+        {
+            const std::string text = value->getString();
+            hash = addToHash(text.c_str(), text.size(), hash);
+        }
+        else if(value->isIntValue())
+        {
+            const long number = value->getLong();
+            hash = addToHash(&number, sizeof(number), hash);
+        }
+        else if(value->isFloatValue())
+        {
+            const double number = value->getDouble();
+            hash = addToHash(&number, sizeof(number), hash);
+        }
+        else if(value->isBoolValue())
+        {
+            const uint8_t boolValue = value->getBool();
+            hash = addToHash(&boolValue, 1, hash);
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * @brief compare two data-items by their structure and values
+ *
+ * @param left first item
+ * @param right second item
+ *
+ * @return true, if both are equal, else false
+ */
+bool
+ResultCache::isEqual(DataItem* left,
+                     DataItem* right)
+{
+    if(left == nullptr
+            || right == nullptr)
+    {
+        return left == right;
+    }
+
+    if(left->getType() != right->getType()) {
+        return false;
+    }
+
+    if(left->isMap())
+    {
+        DataMap* leftMap = left->toMap();
+        DataMap* rightMap = right->toMap();
+        if(leftMap->map.size() != rightMap->map.size()) {
+            return false;
+        }
+
+        std::map<std::string, DataItem*>::const_iterator leftIt = leftMap->map.begin();
+        std::map<std::string, DataItem*>::const_iterator rightIt = rightMap->map.begin();
+        for(; leftIt != leftMap->map.end(); leftIt++, rightIt++)
+        {
+            if(leftIt->first != rightIt->first
+                    || isEqual(leftIt->second, rightIt->second) == false)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    if(left->isArray())
+    {
+        DataArray* leftArray = left->toArray();
+        DataArray* rightArray = right->toArray();
+        if(leftArray->array.size() != rightArray->array.size()) {
+            return false;
+        }
+
+        for(uint64_t i = 0; i < leftArray->array.size(); i++)
+        {
+            if(isEqual(leftArray->array[i], rightArray->array[i]) == false) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    DataValue* leftValue = left->toValue();
+    DataValue* rightValue = right->toValue();
+    if(leftValue->getValueType() != rightValue->getValueType()) {
+        return false;
+    }
+
+    if(leftValue->isStringValue()) {
+        return leftValue->getString() == rightValue->getString();
+    }
+    if(leftValue->isIntValue()) {
+        return leftValue->getLong() == rightValue->getLong();
+    }
+    if(leftValue->isFloatValue()) {
+        return leftValue->getDouble() == rightValue->getDouble();
+    }
+    if(leftValue->isBoolValue()) {
+        return leftValue->getBool() == rightValue->getBool();
+    }
+
+    return true;
+}
+
+/**
+ * @brief remove an entry from a shard, while the lock of the shard is held
+ *
+ * @param shard shard of the entry
+ * @param entryIt iterator to the entry
+ */
+void
+ResultCache::removeEntry(Shard &shard,
+                         std::list<CacheEntry>::iterator entryIt)
+{
+    std::unordered_map<uint64_t, std::list<CacheEntry>::iterator>::iterator indexIt;
+    indexIt = shard.index.find(entryIt->hash);
+    if(indexIt != shard.index.end()
+            && indexIt->second == entryIt)
+    {
+        shard.index.erase(indexIt);
+    }
+
+    delete entryIt->input;
+    delete entryIt->output;
+    shard.entries.erase(entryIt);
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
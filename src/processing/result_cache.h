@@ -0,0 +1,176 @@
+/**
+ * @file        result_cache.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_RESULT_CACHE_H
+#define KITSUNEMIMI_SAKURA_LANG_RESULT_CACHE_H
+
+#include <string>
+#include <list>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+#include <libKitsunemimiSakuraLang/structs.h>
+#include <processing/wait_list.h>
+
+#define NUMBER_OF_CACHE_SHARDS 16
+#define DEFAULT_CACHE_SIZE 1024
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+class SakuraThread;
+class GrowthPlan;
+
+/**
+ * @brief ticket of a single request to the cache. After a miss, the ticket has to be given back
+ *        to the cache together with the result, so other callers with the same input, which are
+ *        waiting for this call, can continue. The ticket owns its input, so it can only be moved.
+ */
+struct CacheTicket
+{
+    // input of the call, which is owned by the ticket until it is stored in the cache
+    DataMap* input = nullptr;
+    uint64_t hash = 0;
+    bool isLeader = false;
+    // plan, which leads the call, or nullptr, if the call is led by a thread without plan
+    GrowthPlan* leadingPlan = nullptr;
+
+    CacheTicket() {}
+    CacheTicket(const CacheTicket &other) = delete;
+    CacheTicket& operator=(const CacheTicket &other) = delete;
+
+    CacheTicket(CacheTicket &&other)
+    {
+        input = other.input;
+        hash = other.hash;
+        isLeader = other.isLeader;
+        leadingPlan = other.leadingPlan;
+        other.input = nullptr;
+        other.isLeader = false;
+    }
+
+    CacheTicket& operator=(CacheTicket &&other)
+    {
+        if(this != &other)
+        {
+            if(input != nullptr) {
+                delete input;
+            }
+            input = other.input;
+            hash = other.hash;
+            isLeader = other.isLeader;
+            leadingPlan = other.leadingPlan;
+            other.input = nullptr;
+            other.isLeader = false;
+        }
+        return *this;
+    }
+
+    ~CacheTicket()
+    {
+        if(input != nullptr) {
+            delete input;
+        }
+    }
+};
+
+//==================================================================================================
+
+/**
+ * @brief Sharded lru-cache for the results of calls, which are identified by their input-map.
+ *        Identical calls, which run at the same time, are coalesced into one call.
+ */
+class ResultCache
+{
+public:
+    ResultCache(const uint64_t maxEntries,
+                const uint32_t timeToLive = 0);
+    ~ResultCache();
+
+    bool get(DataMap &output,
+             CacheTicket &ticket,
+             SakuraThread* worker = nullptr);
+    void set(CacheTicket &ticket,
+             DataMap* output);
+    void clear();
+
+    void getStatistics(CacheStatistics &statistics);
+
+    static uint64_t hashItem(DataItem* item,
+                             uint64_t hash = 14695981039346656037ULL);
+    static bool isEqual(DataItem* left,
+                        DataItem* right);
+
+private:
+    struct CacheEntry
+    {
+        uint64_t hash = 0;
+        DataMap* input = nullptr;
+        DataMap* output = nullptr;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    // running call, which is protected by the lock of its shard
+    struct PendingCall
+    {
+        DataMap* input = nullptr;
+        bool finished = false;
+        WaitList waitList;
+    };
+
+    struct Shard
+    {
+        std::mutex lock;
+        std::list<CacheEntry> entries;
+        std::unordered_map<uint64_t, std::list<CacheEntry>::iterator> index;
+        std::unordered_map<uint64_t, std::shared_ptr<PendingCall>> pending;
+    };
+
+    Shard m_shards[NUMBER_OF_CACHE_SHARDS];
+    uint64_t m_numberOfShards = 1;
+    uint64_t m_maxEntriesPerShard = 1;
+    std::chrono::seconds m_timeToLive;
+
+    std::atomic<uint64_t> m_hits = {0};
+    std::atomic<uint64_t> m_misses = {0};
+    std::atomic<uint64_t> m_coalesced = {0};
+    std::atomic<uint64_t> m_evictions = {0};
+
+    Shard& getShard(const uint64_t hash);
+    void waitForCall(Shard &shard,
+                     PendingCall &pendingCall,
+                     SakuraThread* worker);
+    void removeEntry(Shard &shard,
+                     std::list<CacheEntry>::iterator entryIt);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_RESULT_CACHE_H
@@ -23,31 +23,51 @@
 #include "sakura_thread.h"
 
 #include <items/item_methods.h>
+#include <items/expression_methods.h>
+#include <items/value_item_functions.h>
 #include <sakura_garden.h>
+#include <tree_optimizer.h>
 
 #include <processing/subtree_queue.h>
-#include <processing/thread_pool.h>
 #include <processing/active_counter.h>
 #include <processing/growth_plan.h>
+#include <processing/iteration_source.h>
+#include <processing/result_cache.h>
+#include <processing/incremental_record.h>
 
 #include <libKitsunemimiSakuraLang/blossom.h>
 #include <libKitsunemimiSakuraLang/sakura_lang_interface.h>
 
-#include <libKitsunemimiJinja2/jinja2_converter.h>
 #include <libKitsunemimiCommon/logger.h>
 #include <libKitsunemimiCommon/methods/file_methods.h>
 
+#include <cassert>
+#include <sys/mman.h>
+#include <unistd.h>
+
 namespace Kitsunemimi
 {
 namespace Sakura
 {
 
+// size of the own stack of each plan. The memory is only used, when it is touched, so the
+// size is the same like the default-size of the stack of a thread.
+#define PLAN_STACK_SIZE (8 * 1024 * 1024)
+
+// number of stacks of finished plans, which are kept by a worker-thread for the next plans
+#define MAX_NUMBER_OF_FREE_STACKS 16
+
+// worker-thread, which runs on the current thread, for the entry-point of the stacks
+thread_local SakuraThread* currentWorker = nullptr;
+
 /**
  * @brief constructor
  *
- * @param queue pointer to the subtree-queue, where new separated subtrees should be added
+ * @param interface pointer to the interface-object to access the queue
+ * @param threadName name of the thread
  */
-SakuraThread::SakuraThread(SakuraLangInterface* interface, const std::string &threadName)
+SakuraThread::SakuraThread(SakuraLangInterface* interface,
+                           const std::string &threadName)
     : Kitsunemimi::Thread(threadName)
 {
     m_interface = interface;
@@ -55,53 +75,307 @@ SakuraThread::SakuraThread(SakuraLangInterface* interface, const std::string &th
 
 /**
  * @brief run the main-loop of the thread and process each subtree, which can be taken from the
- *        queue
+ *        queue. Each plan runs on its own stack, so a plan, which has to wait, can be parked
+ *        and the thread continues with the next plan, instead of blocking.
  */
 void
 SakuraThread::run()
 {
     m_started = true;
+    currentWorker = this;
+
     while(m_abort == false)
     {
-        GrowthPlan* plan = m_interface->m_queue->getGrowthPlan();
+        PlanContext* planContext = getNextPlan();
+        if(planContext == nullptr)
+        {
+            // if nothing is to do, then sleep before try it again. A resumed plan ends the
+            // sleep directly.
+            std::unique_lock<std::mutex> lock(m_resumeLock);
+            if(m_resumedPlans.empty()) {
+                m_resumeCond.wait_for(lock, chronoMilliSec(10));
+            }
+            continue;
+        }
+
+        // run the plan until it is finished or parked
+        switchToPlan(planContext);
+        if(planContext->isFinished) {
+            deletePlanContext(planContext);
+        }
+    }
+
+    stopWorkerBlossoms();
+
+    for(void* stack : m_freeStacks) {
+        munmap(stack, PLAN_STACK_SIZE);
+    }
+    m_freeStacks.clear();
+}
 
-        if(plan != nullptr)
+/**
+ * @brief get the next plan to process. Resumed plans are continued before new plans are taken
+ *        from the queue, so they can finish and give back their stack.
+ *
+ * @return next plan or nullptr, if there is nothing to do
+ */
+PlanContext*
+SakuraThread::getNextPlan()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_resumeLock);
+        if(m_resumedPlans.empty() == false)
         {
-            if(plan->completeSubtree != nullptr)
-            {
-                // process input-values
-                DataMap baseItems;
-                overrideItems(baseItems, plan->completeSubtree->values, ALL);
-                overrideItems(baseItems, plan->items,                   ALL);
+            PlanContext* planContext = m_resumedPlans.front();
+            m_resumedPlans.pop_front();
+            return planContext;
+        }
+    }
 
-                // run the real task
-                const bool result = processSakuraItem(plan, plan->completeSubtree);
+    GrowthPlan* plan = m_interface->m_queue->getGrowthPlan();
+    if(plan == nullptr) {
+        return nullptr;
+    }
 
-                // handle result
-                if(plan->parentPlan != nullptr)
-                {
-                    if(result == false)
-                    {
-                        plan->parentPlan->success = false;
-                        plan->success = false;
-                    }
-                    else
-                    {
-                        plan->success = true;
-                    }
-
-                    // increase active-counter as last step, so the source subtree can check, if all
-                    // spawned subtrees are finished
-                    plan->parentPlan->activeCounter.increaseCounter();
-                }
-            }
+    return createPlanContext(plan);
+}
+
+/**
+ * @brief create a new context with its own stack for a plan
+ *
+ * @param plan plan, which should be processed within the context
+ *
+ * @return new context
+ */
+PlanContext*
+SakuraThread::createPlanContext(GrowthPlan* plan)
+{
+    PlanContext* planContext = new PlanContext();
+    planContext->plan = plan;
+    planContext->worker = this;
+
+    // reuse the stack of a finished plan
+    if(m_freeStacks.size() > 0)
+    {
+        planContext->stack = m_freeStacks.back();
+        m_freeStacks.pop_back();
+    }
+    else
+    {
+        planContext->stack = mmap(nullptr,
+                                  PLAN_STACK_SIZE,
+                                  PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK,
+                                  -1,
+                                  0);
+        assert(planContext->stack != MAP_FAILED);
+
+        // the lowest page stays protected, so an overflow of the stack crashs directly instead
+        // of overwriting other memory
+        mprotect(planContext->stack, sysconf(_SC_PAGESIZE), PROT_NONE);
+    }
+
+    getcontext(&planContext->context);
+    planContext->context.uc_stack.ss_sp = planContext->stack;
+    planContext->context.uc_stack.ss_size = PLAN_STACK_SIZE;
+    planContext->context.uc_link = nullptr;
+    makecontext(&planContext->context, &SakuraThread::runPlanContext, 0);
+
+    return planContext;
+}
+
+/**
+ * @brief delete the context of a finished plan and keep its stack for the next plans
+ *
+ * @param planContext context to delete
+ */
+void
+SakuraThread::deletePlanContext(PlanContext* planContext)
+{
+    if(m_freeStacks.size() < MAX_NUMBER_OF_FREE_STACKS) {
+        m_freeStacks.push_back(planContext->stack);
+    } else {
+        munmap(planContext->stack, PLAN_STACK_SIZE);
+    }
+
+    delete planContext;
+}
+
+/**
+ * @brief continue a plan on its own stack until it is finished or parked
+ *
+ * @param planContext context of the plan
+ */
+void
+SakuraThread::switchToPlan(PlanContext* planContext)
+{
+    m_currentPlan = planContext;
+    swapcontext(&m_mainContext, &planContext->context);
+    m_currentPlan = nullptr;
+}
+
+/**
+ * @brief entry-point of the stack of a new plan
+ */
+void
+SakuraThread::runPlanContext()
+{
+    SakuraThread* worker = currentWorker;
+    PlanContext* planContext = worker->m_currentPlan;
+
+    worker->processPlan(planContext->plan);
+
+    // go back to the main-loop, which deletes the context, so this stack is never used again
+    planContext->isFinished = true;
+    swapcontext(&planContext->context, &worker->m_mainContext);
+}
+
+/**
+ * @brief process a subtree, which was taken from the queue
+ *
+ * @param plan plan with all information of the subtree
+ */
+void
+SakuraThread::processPlan(GrowthPlan* plan)
+{
+    if(plan->completeSubtree == nullptr) {
+        return;
+    }
+
+    // process input-values
+    DataMap baseItems;
+    overrideItems(baseItems, plan->completeSubtree->values, ALL);
+    overrideItems(baseItems, plan->items,                   ALL);
+
+    // run the real task
+    const bool result = processSakuraItem(plan, plan->completeSubtree);
+
+    // handle result
+    if(plan->parentPlan != nullptr)
+    {
+        if(result == false)
+        {
+            plan->parentPlan->success = false;
+            plan->success = false;
         }
         else
         {
-            // if no tree was in the queue, then sleep before try it again
-            std::this_thread::sleep_for(chronoMilliSec(10));
+            plan->success = true;
+        }
+
+        // increase active-counter as last step, so the source subtree can check, if all
+        // spawned subtrees are finished
+        plan->parentPlan->activeCounter.increaseCounter(plan->finished);
+    }
+}
+
+/**
+ * @brief get the plan, which is processed by this thread at the moment
+ *
+ * @return context of the plan, or nullptr, if the thread doesn't process a plan at the moment
+ */
+PlanContext*
+SakuraThread::getCurrentPlan()
+{
+    return m_currentPlan;
+}
+
+/**
+ * @brief park the current plan, like at the end of spawned subtrees, of the task of an
+ *        asynchronous blossom or of a cached call with the same input, or for a free slot of a
+ *        limited blossom. The thread continues with other plans, until the plan is given to
+ *        resume. The plan has to be registered for this, before the lock is released.
+ *
+ * @param lock locked lock, which protects the condition, the plan waits for. It is released
+ *             while the plan is parked and locked again, before the plan continues.
+ */
+void
+SakuraThread::park(std::unique_lock<std::mutex> &lock)
+{
+    PlanContext* planContext = m_currentPlan;
+
+    // the plan can only be continued by this thread, so it can not be resumed, before the
+    // switch back to the main-loop is done
+    lock.unlock();
+    swapcontext(&planContext->context, &m_mainContext);
+    lock.lock();
+}
+
+/**
+ * @brief give a parked plan back to this thread, so it is continued by the main-loop. This can
+ *        be called by any thread.
+ *
+ * @param planContext context of the parked plan
+ */
+void
+SakuraThread::resume(PlanContext* planContext)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_resumeLock);
+        m_resumedPlans.push_back(planContext);
+    }
+    m_resumeCond.notify_one();
+}
+
+/**
+ * @brief get the blossom for this thread. If the blossom was registered by a factory, the thread
+ *        creates its own instance at the first call, else the shared instance is used.
+ *
+ * @param groupName group-identifier of the blossom
+ * @param itemName item-identifier of the blossom
+ *
+ * @return pointer to the blossom or nullptr, if not found
+ */
+Blossom*
+SakuraThread::getWorkerBlossom(const std::string &groupName,
+                               const std::string &itemName)
+{
+    // search in the blossoms, which were already used by this thread
+    std::map<std::string, std::map<std::string, Blossom*>>::const_iterator groupIt;
+    groupIt = m_blossoms.find(groupName);
+    if(groupIt != m_blossoms.end())
+    {
+        std::map<std::string, Blossom*>::const_iterator itemIt;
+        itemIt = groupIt->second.find(itemName);
+        if(itemIt != groupIt->second.end()) {
+            return itemIt->second;
+        }
+    }
+
+    Blossom* blossom = m_interface->createWorkerBlossom(groupName, itemName);
+    if(blossom != nullptr)
+    {
+        blossom->onWorkerStart();
+        m_ownBlossoms.push_back(blossom);
+    }
+    else
+    {
+        blossom = m_interface->getBlossom(groupName, itemName);
+        if(blossom == nullptr) {
+            return nullptr;
         }
     }
+
+    m_blossoms[groupName].insert(std::make_pair(itemName, blossom));
+
+    return blossom;
+}
+
+/**
+ * @brief give the own blossom-instances of the thread the possibility to clear their state and
+ *        delete them
+ */
+void
+SakuraThread::stopWorkerBlossoms()
+{
+    for(Blossom* blossom : m_ownBlossoms)
+    {
+        blossom->onWorkerStop();
+        delete blossom;
+    }
+
+    m_ownBlossoms.clear();
+    m_blossoms.clear();
 }
 
 /**
@@ -191,7 +465,8 @@ SakuraThread::processSakuraItem(GrowthPlan* plan,
 }
 
 /**
- * @brief process single blossom
+ * @brief process single blossom. If the tree is triggered incremental and the input of the
+ *        blossom has not changed since the previous run, the recorded output is used instead.
  *
  * @param plan plan with all information of the current process
  * @param blossomItem item with all information for the blossom
@@ -202,55 +477,161 @@ bool
 SakuraThread::processBlossom(GrowthPlan* plan,
                              BlossomItem &blossomItem)
 {
-    // only debug-output
-    LOG_DEBUG("process blossom:");
-    LOG_DEBUG("    name: " + blossomItem.blossomName);
+    // get and prcess the requested blossom
+    Blossom* blossom = getBlossom(plan, blossomItem);
+    if(blossom == nullptr) {
+        return false;
+    }
 
-    // process values by filling with information of the parent-object
-    const bool result = fillInputValueItemMap(blossomItem.values, plan->items, plan->error);
-    if(result == false)
+    BlossomIO blossomIO;
+    if(prepareBlossom(plan, blossomItem, blossomIO) == false) {
+        return false;
+    }
+
+    // identify the call by the blossom and its position within the tree. Only pure blossoms
+    // are recorded, because the input-values don't contain the parent-values and the
+    // side-effects of a blossom.
+    IncrementalRecord* record = plan->incrementalRecord;
+    std::string callId = "";
+    DataMap* recordedInput = nullptr;
+    if(record != nullptr
+            && blossom->isPure == false)
     {
-        createError(blossomItem, plan->filePath, "processing", plan->error);
-        plan->error.addMeesage("error while processing blossom items");
+        record->countExecution();
+        record = nullptr;
+    }
+
+    if(record != nullptr)
+    {
+        callId = blossomItem.blossomGroupType + "/" + blossomItem.blossomType;
+        for(const std::string &name : blossomIO.nameHirarchie) {
+            callId += "|" + name;
+        }
+
+        DataMap* input = blossomIO.input.getItemContent()->toMap();
+        if(record->getOutput(*blossomIO.output.getItemContent()->toMap(), callId, input)) {
+            return finishBlossom(plan, blossomItem, blossomIO);
+        }
+
+        // the input is changed by the blossom, so it has to be copied before
+        recordedInput = input->copy()->toMap();
+    }
+
+    // process blossom
+    if(blossom->growBlossom(blossomIO,
+                            plan->context,
+                            plan->status,
+                            plan->error,
+                            this) == false)
+    {
+        if(recordedInput != nullptr) {
+            delete recordedInput;
+        }
         return false;
     }
 
-    LOG_DEBUG("    values:\n" + blossomItem.values.toString());
+    if(record != nullptr)
+    {
+        record->addOutput(callId,
+                          recordedInput,
+                          blossomIO.output.getItemContent()->copy()->toMap());
+    }
 
-    // get and prcess the requested blossom
-    Blossom* blossom = m_interface->getBlossom(blossomItem.blossomGroupType,
-                                               blossomItem.blossomType);
+    return finishBlossom(plan, blossomItem, blossomIO);
+}
+
+/**
+ * @brief get the registered blossom of a blossom-item
+ *
+ * @param plan plan with all information of the current process
+ * @param blossomItem item with all information for the blossom
+ *
+ * @return requested blossom or nullptr, if not found
+ */
+Blossom*
+SakuraThread::getBlossom(GrowthPlan* plan,
+                         BlossomItem &blossomItem)
+{
+    Blossom* blossom = getWorkerBlossom(blossomItem.blossomGroupType,
+                                        blossomItem.blossomType);
     if(blossom == nullptr)
     {
         createError(blossomItem, plan->filePath, "processing", plan->error);
         plan->error.addMeesage("unknow blossom-type\n"
                                "    group: " + blossomItem.blossomGroupType +
                                "    type: " + blossomItem.blossomType);
+    }
+
+    return blossom;
+}
+
+/**
+ * @brief fill the values of a blossom-item and move them into the input of the blossom
+ *
+ * @param plan plan with all information of the current process
+ * @param blossomItem item with all information for the blossom
+ * @param blossomIO leaf-object, which should be prepared
+ *
+ * @return true if successful, else false
+ */
+bool
+SakuraThread::prepareBlossom(GrowthPlan* plan,
+                             BlossomItem &blossomItem,
+                             BlossomIO &blossomIO)
+{
+    // only debug-output
+    LOG_DEBUG("process blossom:");
+    LOG_DEBUG("    name: " + blossomItem.blossomName);
+
+    // process values by filling with information of the parent-object
+    const bool result = fillInputValueItemMap(blossomItem.values, plan->items, plan->error);
+    if(result == false)
+    {
+        createError(blossomItem, plan->filePath, "processing", plan->error);
+        plan->error.addMeesage("error while processing blossom items");
         return false;
     }
 
+    LOG_DEBUG("    values:\n" + blossomItem.values.toString());
+
     // update blossom-leaf for processing
-    BlossomIO blossomIO;
     blossomIO.blossomPath = plan->filePath;
     blossomIO.nameHirarchie = plan->hirarchy;
     blossomIO.parentValues = &plan->items;
     blossomIO.nameHirarchie.push_back("BLOSSOM: " + blossomItem.blossomName);
 
-    convertValueMap(*blossomIO.input.getItemContent()->toMap(), blossomItem.values);
+    // the blossom-item is only a temporary copy, so its values can be moved into the input
+    // instead of being copied
+    moveValueMap(*blossomIO.input.getItemContent()->toMap(), blossomItem.values);
 
-    // process blossom
-    if(blossom->growBlossom(blossomIO, plan->context, plan->status, plan->error) == false) {
-        return false;
-    }
+    return true;
+}
 
+/**
+ * @brief print the output of a processed blossom and write its outputs back to the parent
+ *
+ * @param plan plan with all information of the current process
+ * @param blossomItem item with all information for the blossom
+ * @param blossomIO leaf-object of the processed blossom
+ *
+ * @return true if successful, else false
+ */
+bool
+SakuraThread::finishBlossom(GrowthPlan* plan,
+                            BlossomItem &blossomItem,
+                            BlossomIO &blossomIO)
+{
     // send result to root
     m_interface->printOutput(blossomIO);
 
-    // write processing result back to parent
-    fillOutputValueItemMap(blossomItem.values, *blossomIO.output.getItemContent()->toMap());
-
-    // TODO: override only with the output-values to avoid unnecessary conflicts
-    overrideItems(plan->items, blossomItem.values, ONLY_EXISTING);
+    // write only the declared outputs back to the parent
+    DataMap* output = blossomIO.output.getItemContent()->toMap();
+    if(moveOutputItems(plan->items, blossomItem.values, *output) == false)
+    {
+        createError(blossomItem, plan->filePath, "processing", plan->error);
+        plan->error.addMeesage("blossom doesn't have all declared output-values");
+        return false;
+    }
 
     return true;
 }
@@ -267,36 +648,27 @@ bool
 SakuraThread::processBlossomGroup(GrowthPlan* plan,
                                   BlossomGroupItem &blossomGroupItem)
 {
-    // convert name as jinja2-string
-    std::string convertResult = "";
-    Jinja2::Jinja2Converter* converter = Jinja2::Jinja2Converter::getInstance();
-    const bool ret = converter->convert(convertResult,
-                                        blossomGroupItem.id,
-                                        &plan->items,
-                                        plan->error);
-    if(ret == false)
-    {
-        plan->error.addMeesage("error while jinja2-converting");
+    if(prepareBlossomGroup(plan, blossomGroupItem) == false) {
         return false;
     }
 
-    LOG_DEBUG("process blossom group: " + convertResult);
-
-    // print blossom-group
-    blossomGroupItem.id = convertResult;
-    blossomGroupItem.nameHirarchie = plan->hirarchy;
-    blossomGroupItem.nameHirarchie.push_back("BLOSSOM-GROUP: " + blossomGroupItem.id);
-    m_interface->printOutput(blossomGroupItem);
-
     // iterate over all blossoms of the group and process one after another
     for(BlossomItem* blossomItem : blossomGroupItem.blossoms)
     {
         // handle special-cass of a ressource-call
-        TreeItem* tempItem = m_interface->m_garden->getRessource(blossomItem->blossomType);
-        if(tempItem != nullptr)
+        if(blossomItem->linkedResource != nullptr)
         {
+            TreeItem* tempItem = dynamic_cast<TreeItem*>(blossomItem->linkedResource->copy());
             LOG_DEBUG("process resouces: " + tempItem->id);
 
+            // fill values
+            if(fillInputValueItemMap(blossomGroupItem.values, plan->items, plan->error) == false)
+            {
+                plan->error.addMeesage("error while processing subtree-call");
+                delete tempItem;
+                return false;
+            }
+
             const bool ret = runSubtreeCall(plan, tempItem, blossomGroupItem.values);
             delete tempItem;
 
@@ -322,6 +694,41 @@ SakuraThread::processBlossomGroup(GrowthPlan* plan,
     return true;
 }
 
+/**
+ * @brief convert the name of a blossom-group and print the group
+ *
+ * @param plan plan with all information of the current process
+ * @param blossomGroupItem object, which should be prepared
+ *
+ * @return true if successful, else false
+ */
+bool
+SakuraThread::prepareBlossomGroup(GrowthPlan* plan,
+                                  BlossomGroupItem &blossomGroupItem)
+{
+    // convert name as jinja2-string
+    std::string convertResult = "";
+    const bool ret = convertJinja2Template(convertResult,
+                                           blossomGroupItem.id,
+                                           plan->items,
+                                           plan->error);
+    if(ret == false)
+    {
+        plan->error.addMeesage("error while jinja2-converting");
+        return false;
+    }
+
+    LOG_DEBUG("process blossom group: " + convertResult);
+
+    // print blossom-group
+    blossomGroupItem.id = convertResult;
+    blossomGroupItem.nameHirarchie = plan->hirarchy;
+    blossomGroupItem.nameHirarchie.push_back("BLOSSOM-GROUP: " + blossomGroupItem.id);
+    m_interface->printOutput(blossomGroupItem);
+
+    return true;
+}
+
 /**
  * @brief process a new tree
  *
@@ -372,19 +779,37 @@ bool
 SakuraThread::processSubtree(GrowthPlan* plan,
                              SubtreeItem* subtreeItem)
 {
-    // get sakura-file based on the required path
-    Kitsunemimi::Sakura::SakuraGarden* garden = m_interface->m_garden;
-    const std::filesystem::path relPath = garden->getRelativePath(plan->filePath,
-                                                                  subtreeItem->nameOrPath);
-
-    // get and check tree
-    TreeItem* newSubtree = garden->getTree(relPath.string());
-    if(newSubtree == nullptr)
+    // get tree, which was already resolved by the linking of the garden
+    if(subtreeItem->linkedTree == nullptr)
     {
         plan->error.addMeesage("subtree doesn't exist: " + subtreeItem->nameOrPath);
         return false;
     }
 
+    // values, which were fixed by a specialization of the tree, can not be overridden anymore
+    for(const std::string &fixedKey : subtreeItem->linkedTree->fixedKeys)
+    {
+        if(subtreeItem->values.contains(fixedKey))
+        {
+            plan->error.addMeesage("value '" + fixedKey + "' is fixed in the subtree "
+                                   + subtreeItem->nameOrPath);
+            return false;
+        }
+    }
+
+    // fill values
+    if(fillInputValueItemMap(subtreeItem->values, plan->items, plan->error) == false)
+    {
+        plan->error.addMeesage("error while processing subtree-call");
+        return false;
+    }
+
+    if(subtreeItem->isCached) {
+        return runCachedSubtreeCall(plan, subtreeItem);
+    }
+
+    TreeItem* newSubtree = dynamic_cast<TreeItem*>(subtreeItem->linkedTree->copy());
+
     LOG_DEBUG("process subtree: " + newSubtree->id + " in path " + newSubtree->relativePath);
 
     const bool ret = runSubtreeCall(plan,
@@ -396,56 +821,114 @@ SakuraThread::processSubtree(GrowthPlan* plan,
 }
 
 /**
- * @brief process a if-else-condition
+ * @brief process a subtree-call, which is marked as cached. If the same subtree was already
+ *        called with the same input-values within the same run or, if a time-to-live is set,
+ *        within a previous run with the same context, the result is reused instead of
+ *        processing the subtree again. Identical calls, which run at the same time, share one
+ *        execution. Their plans are parked, while waiting, so the worker-thread continues with
+ *        other plans in the meantime.
  *
  * @param plan plan with all information of the current process
- * @param ifCondition object, which should be processed
+ * @param subtreeItem subtree-call with already filled input-values
  *
  * @return true if successful, else false
  */
 bool
-SakuraThread::processIf(GrowthPlan* plan,
-                        IfBranching* ifCondition)
+SakuraThread::runCachedSubtreeCall(GrowthPlan* plan,
+                                   SubtreeItem* subtreeItem)
 {
-    // initialize
-    bool ifMatch = false;
-    ValueItem valueItem;
+    ResultCache* cache = nullptr;
+    if(subtreeItem->cacheTimeToLive > 0)
+    {
+        cache = m_interface->getSubtreeCache(subtreeItem->linkedId,
+                                             subtreeItem->cacheTimeToLive);
+    }
+    else
+    {
+        cache = plan->getCallCache();
+    }
 
-    // get left side of the comparism
-    if(fillValueItem(ifCondition->leftSide, plan->items, plan->error) == false)
+    // create key out of the called tree and the input-values
+    CacheTicket ticket;
+    DataMap* inputValues = new DataMap();
+    overrideItems(*inputValues, subtreeItem->values, ALL);
+    ticket.input = new DataMap();
+    ticket.input->insert("tree", new DataValue(subtreeItem->linkedId));
+    ticket.input->insert("values", inputValues);
+
+    // results, which are kept across runs, also depend on the context of the run. If the called
+    // tree is cacheable, only its selected context-values are used, like for triggerTree.
+    if(subtreeItem->cacheTimeToLive > 0
+            && plan->context != nullptr)
     {
-        plan->error.addMeesage("error processing if-condition");
-        return false;
+        DataMap* selectedContext = new DataMap();
+        if(subtreeItem->linkedTree->cacheSize > 0)
+        {
+            for(const std::string &key : subtreeItem->linkedTree->cacheContextKeys)
+            {
+                DataItem* value = plan->context->get(key);
+                if(value != nullptr) {
+                    selectedContext->insert(key, value->copy());
+                }
+            }
+        }
+        else
+        {
+            overrideItems(*selectedContext, *plan->context, ALL);
+        }
+        ticket.input->insert("context", selectedContext);
     }
 
-    // get right side of the comparism
-    if(fillValueItem(ifCondition->rightSide, plan->items, plan->error) == false)
+    DataMap cachedValues;
+    if(cache->get(cachedValues, ticket, this))
     {
-        plan->error.addMeesage("error processing if-condition");
-        return false;
+        overrideItems(plan->items, cachedValues, ONLY_EXISTING);
+        return true;
     }
 
-    // convert values into strings
-    const std::string leftSide = ifCondition->leftSide.item->toString();
-    const std::string rightSide = ifCondition->rightSide.item->toString();
+    TreeItem* newSubtree = dynamic_cast<TreeItem*>(subtreeItem->linkedTree->copy());
 
-    // compare based on the compare-type
-    switch(ifCondition->ifType)
+    LOG_DEBUG("process cached subtree: " + newSubtree->id);
+
+    const bool ret = runSubtreeCall(plan,
+                                    newSubtree,
+                                    subtreeItem->values);
+    if(ret)
     {
-        case IfBranching::EQUAL:
-            {
-                ifMatch = leftSide == rightSide;
-                break;
-            }
-        case IfBranching::UNEQUAL:
-            {
-                ifMatch = leftSide != rightSide;
-                break;
-            }
-        default:
-            // not implemented
-            assert(false);
-            break;
+        DataMap* resultValues = new DataMap();
+        overrideItems(*resultValues, newSubtree->values, ALL);
+        cache->set(ticket, resultValues);
+    }
+    else
+    {
+        cache->set(ticket, nullptr);
+    }
+
+    delete newSubtree;
+
+    return ret;
+}
+
+/**
+ * @brief process a if-else-condition
+ *
+ * @param plan plan with all information of the current process
+ * @param ifCondition object, which should be processed
+ *
+ * @return true if successful, else false
+ */
+bool
+SakuraThread::processIf(GrowthPlan* plan,
+                        IfBranching* ifCondition)
+{
+    bool ifMatch = false;
+
+    // evaluate the condition, where the operands of and- and or-expressions are only evaluated
+    // if necessary
+    if(evaluateCondition(ifMatch, ifCondition->condition, plan->items, plan->error) == false)
+    {
+        plan->error.addMeesage("error processing if-condition");
+        return false;
     }
 
     // based on the result, process the if-subtree or the else-subtree
@@ -468,25 +951,53 @@ bool
 SakuraThread::processForEach(GrowthPlan* plan,
                              ForEachBranching* forEachItem)
 {
-    // initialize the array, over twhich the loop should iterate
-    if(fillInputValueItemMap(forEachItem->iterateArray, plan->items, plan->error) == false)
+    // create the source of the entries, over which the loop should iterate
+    std::string text = "";
+    ValueItem &iterateItem = forEachItem->iterateArray.m_valueMap["array"];
+    IterationSource* source = createIterationSource(plan, iterateItem, text);
+    if(source == nullptr)
     {
         plan->error.addMeesage("error processing for-each-loop");
         return false;
     }
 
-    DataArray* array = forEachItem->iterateArray.get("array")->toArray();
+    // evaluate values, which are the same in all iterations, only once before the loop, if the
+    // content runs at least twice
+    if(forEachItem->isAnalyzed
+            && source->hasMultipleEntries())
+    {
+        m_interface->m_optimizer->hoistLoopInvariants(forEachItem->content,
+                                                      forEachItem->variantValues,
+                                                      plan->items);
+    }
 
-    // process content normal or parallel via worker-threads
+    // process content normal, in batches or parallel via worker-threads
     bool result = false;
-    if(forEachItem->parallel == false)
+    Blossom* batchBlossom = nullptr;
+    if(forEachItem->parallel == false
+            && forEachItem->isAnalyzed)
+    {
+        batchBlossom = getBatchBlossom(forEachItem->content,
+                                       forEachItem->tempVarName,
+                                       forEachItem->variantValues);
+    }
+
+    if(batchBlossom != nullptr)
+    {
+        result = runBatchLoop(plan,
+                              forEachItem->content,
+                              forEachItem->values,
+                              forEachItem->tempVarName,
+                              source,
+                              batchBlossom);
+    }
+    else if(forEachItem->parallel == false)
     {
         result = runLoop(plan,
                          forEachItem->content,
                          forEachItem->values,
                          forEachItem->tempVarName,
-                         array,
-                         array->size());
+                         source);
     }
     else
     {
@@ -494,10 +1005,13 @@ SakuraThread::processForEach(GrowthPlan* plan,
         result = m_interface->m_queue->spawnParallelSubtreesLoop(plan,
                                                                  forEachItem->content,
                                                                  forEachItem->tempVarName,
-                                                                 array,
-                                                                 array->size());
+                                                                 source,
+                                                                 forEachItem->parallelWidth,
+                                                                 this);
     }
 
+    delete source;
+
     return result;
 }
 
@@ -531,17 +1045,46 @@ SakuraThread::processFor(GrowthPlan* plan,
     const uint64_t startValue = static_cast<uint64_t>(forItem->start.item->toValue()->getLong());
     const uint64_t endValue = static_cast<uint64_t>(forItem->end.item->toValue()->getLong());
 
-    // process content normal or parallel via worker-threads
+    // the counter-values are created while iterating
+    RangeSource source(startValue, endValue);
+
+    // evaluate values, which are the same in all iterations, only once before the loop, if the
+    // content runs at least twice
+    if(forItem->isAnalyzed
+            && source.hasMultipleEntries())
+    {
+        m_interface->m_optimizer->hoistLoopInvariants(forItem->content,
+                                                      forItem->variantValues,
+                                                      plan->items);
+    }
+
+    // process content normal, in batches or parallel via worker-threads
     bool result = false;
-    if(forItem->parallel == false)
+    Blossom* batchBlossom = nullptr;
+    if(forItem->parallel == false
+            && forItem->isAnalyzed)
+    {
+        batchBlossom = getBatchBlossom(forItem->content,
+                                       forItem->tempVarName,
+                                       forItem->variantValues);
+    }
+
+    if(batchBlossom != nullptr)
+    {
+        result = runBatchLoop(plan,
+                              forItem->content,
+                              forItem->values,
+                              forItem->tempVarName,
+                              &source,
+                              batchBlossom);
+    }
+    else if(forItem->parallel == false)
     {
         result = runLoop(plan,
                          forItem->content,
                          forItem->values,
                          forItem->tempVarName,
-                         nullptr,
-                         endValue,
-                         startValue);
+                         &source);
     }
     else
     {
@@ -549,9 +1092,9 @@ SakuraThread::processFor(GrowthPlan* plan,
         result = m_interface->m_queue->spawnParallelSubtreesLoop(plan,
                                                                  forItem->content,
                                                                  forItem->tempVarName,
-                                                                 nullptr,
-                                                                 endValue,
-                                                                 startValue);
+                                                                 &source,
+                                                                 forItem->parallelWidth,
+                                                                 this);
     }
 
     return result;
@@ -592,7 +1135,7 @@ SakuraThread::processParallelPart(GrowthPlan* plan,
                                   ParallelPart* parallelPart)
 {
     SequentiellPart* parts = dynamic_cast<SequentiellPart*>(parallelPart->childs);
-    return m_interface->m_queue->spawnParallelSubtrees(plan, parts->childs);
+    return m_interface->m_queue->spawnParallelSubtrees(plan, parts->childs, this);
 }
 
 /**
@@ -600,7 +1143,7 @@ SakuraThread::processParallelPart(GrowthPlan* plan,
  *
  * @param plan plan with all information of the current process
  * @param newSubtree tree-item to call
- * @param values input-values
+ * @param values already filled input-values
  *
  * @return true, if check successful, else false
  */
@@ -609,13 +1152,6 @@ SakuraThread::runSubtreeCall(GrowthPlan* plan,
                              SakuraItem* newSubtree,
                              ValueItemMap &values)
 {
-    // fill values
-    if(fillInputValueItemMap(values, plan->items, plan->error) == false)
-    {
-        plan->error.addMeesage("error while processing subtree-call");
-        return false;
-    }
-
     // backup and reset parent
     DataMap parentBackup = plan->items;
     plan->items.clear();
@@ -641,6 +1177,108 @@ SakuraThread::runSubtreeCall(GrowthPlan* plan,
     return true;
 }
 
+/**
+ * @brief create the source of the entries of a for-each-loop. If the last function of the
+ *        value is a split, file_lines or file_chunks, the parts are created lazy while
+ *        iterating, instead of creating the complete array before the loop.
+ *
+ * @param plan plan with all information of the current process
+ * @param iterateItem value-item of the loop, which is filled by this function
+ * @param text buffer for a string, which is splitted and must exist until the end of the loop
+ *
+ * @return new iteration-source or nullptr, if something went wrong
+ */
+IterationSource*
+SakuraThread::createIterationSource(GrowthPlan* plan,
+                                    ValueItem &iterateItem,
+                                    std::string &text)
+{
+    if(iterateItem.isConstant == false
+            && iterateItem.expression == nullptr
+            && iterateItem.functions.size() > 0)
+    {
+        const std::string type = iterateItem.functions.back().type;
+        const FunctionItem::SpecialType specialType = iterateItem.functions.back().specialType;
+        if(specialType == FunctionItem::SPLIT_TYPE
+                || specialType == FunctionItem::FILE_LINES_TYPE
+                || specialType == FunctionItem::FILE_CHUNKS_TYPE)
+        {
+            // fill the value and the arguments of the last function separately
+            std::vector<ValueItem> arguments = iterateItem.functions.back().arguments;
+            iterateItem.functions.pop_back();
+            if(fillValueItem(iterateItem, plan->items, plan->error) == false) {
+                return nullptr;
+            }
+            for(ValueItem &argument : arguments)
+            {
+                if(fillValueItem(argument, plan->items, plan->error) == false) {
+                    return nullptr;
+                }
+            }
+
+            if(iterateItem.item->isStringValue() == false)
+            {
+                plan->error.addMeesage(type + "-function is called on a value "
+                                       "with invalid type");
+                return nullptr;
+            }
+
+            //--------------------------------------------------------------------------------------
+            if(specialType == FunctionItem::SPLIT_TYPE)
+            {
+                std::string delimiter = "";
+                if(arguments.size() != 1
+                        || arguments.at(0).item->isValue() == false
+                        || getSplitDelimiter(delimiter, arguments.at(0).item->toValue()) == false)
+                {
+                    plan->error.addMeesage("invalid delimiter for the split-function");
+                    return nullptr;
+                }
+
+                text = iterateItem.item->toValue()->getString();
+                return new SplitSource(text, delimiter);
+            }
+            //--------------------------------------------------------------------------------------
+            std::string_view fileText;
+            if(getFileText(fileText, iterateItem.item->toValue(), plan->error) == false) {
+                return nullptr;
+            }
+            //--------------------------------------------------------------------------------------
+            if(specialType == FunctionItem::FILE_LINES_TYPE) {
+                return new SplitSource(fileText, "\n");
+            }
+            //--------------------------------------------------------------------------------------
+            uint64_t chunkSize = 0;
+            if(arguments.size() != 1
+                    || arguments.at(0).item->isValue() == false)
+            {
+                plan->error.addMeesage("invalid chunk-size for the file_chunks-function");
+                return nullptr;
+            }
+            if(getChunkSize(chunkSize, arguments.at(0).item->toValue(), plan->error) == false)
+            {
+                return nullptr;
+            }
+
+            return new ChunkSource(fileText, chunkSize);
+            //--------------------------------------------------------------------------------------
+        }
+    }
+
+    // iterate over a complete array
+    if(fillValueItem(iterateItem, plan->items, plan->error) == false) {
+        return nullptr;
+    }
+
+    if(iterateItem.item->isArray() == false)
+    {
+        plan->error.addMeesage("value of a for-each-loop is not an array");
+        return nullptr;
+    }
+
+    return new ArraySource(iterateItem.item->toArray());
+}
+
 /**
  * @brief run a normal loop
  *
@@ -649,9 +1287,7 @@ SakuraThread::runSubtreeCall(GrowthPlan* plan,
  * @param values input-values
  * @param tempVarName temporary variable name for usage within the loop to forward the object
  *                    over which is generated of the counter-variable
- * @param array nullptr if iterate over a range or pointer to array-item to iterate over this array
- * @param endPos start-position in the array or of the counter
- * @param startPos start-position in the array or of the counter
+ * @param source source of the entries of the loop
  *
  * @return true, if check successful, else false
  */
@@ -660,22 +1296,17 @@ SakuraThread::runLoop(GrowthPlan* plan,
                       SakuraItem* loopContent,
                       const ValueItemMap &values,
                       const std::string &tempVarName,
-                      DataArray* array,
-                      const uint64_t endPos,
-                      const uint64_t startPos)
+                      IterationSource* source)
 {
     // backup the parent-values to avoid permanent merging with loop-internal values
     DataMap preBalueBackup = plan->items;
     overrideItems(plan->items, values, ALL);
 
-    for(uint64_t i = startPos; i < endPos; i++)
+    DataItem* entry = source->next();
+    while(entry != nullptr)
     {
-        // add the counter-variable as new value to be accessable within the loop
-        if(array != nullptr) {
-            plan->items.insert(tempVarName, array->get(i)->copy(), true);
-        } else {
-            plan->items.insert(tempVarName, new DataValue(static_cast<long>(i)), true);
-        }
+        // add the entry as new value to be accessable within the loop
+        plan->items.insert(tempVarName, entry, true);
 
         // process content
         SakuraItem* tempItem = loopContent->copy();
@@ -683,6 +1314,157 @@ SakuraThread::runLoop(GrowthPlan* plan,
             return false;
         }
         delete tempItem;
+
+        entry = source->next();
+    }
+
+    // restore the old parent values and update only the existing values with the one form the
+    // loop. That way, variables like the counter-variable are not added to the parent.
+    DataMap postBalueBackup = plan->items;
+    plan->items = preBalueBackup;
+    overrideItems(plan->items, postBalueBackup, ONLY_EXISTING);
+
+    return true;
+}
+
+/**
+ * @brief get the blossom of a loop, which only calls a single blossom, whose calls can be given
+ *        together to the blossom
+ *
+ * @param loopContent content of the loop
+ * @param tempVarName loop-internal variable
+ * @param variantValues names of the values, which can change between the iterations
+ *
+ * @return blossom, if the loop can be processed in batches, else nullptr
+ */
+Blossom*
+SakuraThread::getBatchBlossom(SakuraItem* loopContent,
+                              const std::string &tempVarName,
+                              const std::vector<std::string> &variantValues)
+{
+    BlossomGroupItem* blossomGroupItem = m_interface->m_optimizer->getBatchBlossomGroup(
+                loopContent,
+                tempVarName,
+                variantValues);
+    if(blossomGroupItem == nullptr) {
+        return nullptr;
+    }
+
+    // the group-type of the blossom is set by the group while processing
+    Blossom* blossom = getWorkerBlossom(blossomGroupItem->blossomGroupType,
+                                        blossomGroupItem->blossoms.front()->blossomType);
+    if(blossom == nullptr
+            || blossom->maxBatchSize <= 1)
+    {
+        return nullptr;
+    }
+
+    return blossom;
+}
+
+/**
+ * @brief run a loop, which only calls a single blossom, by collecting the inputs of multiple
+ *        iterations and give them together to the blossom. The outputs are written back in
+ *        the order of the iterations.
+ *
+ * @param plan plan with all information of the current process
+ * @param loopContent content of the loop, which contains only the blossom
+ * @param values input-values
+ * @param tempVarName loop-internal variable
+ * @param source source of the entries of the loop
+ * @param blossom blossom, which is called by the loop
+ *
+ * @return true, if successful, else false
+ */
+bool
+SakuraThread::runBatchLoop(GrowthPlan* plan,
+                           SakuraItem* loopContent,
+                           const ValueItemMap &values,
+                           const std::string &tempVarName,
+                           IterationSource* source,
+                           Blossom* blossom)
+{
+    // backup the parent-values to avoid permanent merging with loop-internal values
+    DataMap preBalueBackup = plan->items;
+    overrideItems(plan->items, values, ALL);
+
+    std::vector<SakuraItem*> contents;
+    std::vector<BlossomIO> blossomIOs;
+    contents.reserve(blossom->maxBatchSize);
+    blossomIOs.reserve(blossom->maxBatchSize);
+
+    bool result = true;
+    DataItem* entry = source->next();
+    while(entry != nullptr
+          && result)
+    {
+        // collect the inputs of multiple iterations
+        while(entry != nullptr
+              && result
+              && contents.size() < blossom->maxBatchSize)
+        {
+            plan->items.insert(tempVarName, entry, true);
+            entry = nullptr;
+
+            SakuraItem* tempItem = loopContent->copy();
+            contents.push_back(tempItem);
+            BlossomGroupItem* blossomGroupItem =
+                    m_interface->m_optimizer->getSingleBlossomGroup(tempItem);
+            BlossomItem* blossomItem = blossomGroupItem->blossoms.front();
+
+            // update blossom-item with group-values like in a normal blossom-group
+            if(prepareBlossomGroup(plan, *blossomGroupItem) == false)
+            {
+                result = false;
+                break;
+            }
+            blossomItem->blossomGroupType = blossomGroupItem->blossomGroupType;
+            blossomItem->blossomName = blossomGroupItem->id;
+            overrideItems(blossomItem->values,
+                          blossomGroupItem->values,
+                          ONLY_NON_EXISTING);
+
+            blossomIOs.emplace_back();
+            result = prepareBlossom(plan, *blossomItem, blossomIOs.back());
+            if(result) {
+                entry = source->next();
+            }
+        }
+
+        // process all collected iterations together
+        if(result) {
+            result = blossom->growBlossomBatch(blossomIOs,
+                                               plan->context,
+                                               plan->status,
+                                               plan->error,
+                                               this);
+        }
+
+        // write the outputs back in the order of the iterations
+        for(uint64_t i = 0; i < contents.size(); i++)
+        {
+            if(result)
+            {
+                BlossomGroupItem* blossomGroupItem =
+                        m_interface->m_optimizer->getSingleBlossomGroup(contents.at(i));
+                result = finishBlossom(plan,
+                                       *blossomGroupItem->blossoms.front(),
+                                       blossomIOs.at(i));
+            }
+            delete contents.at(i);
+        }
+
+        contents.clear();
+        blossomIOs.clear();
+    }
+
+    if(result == false)
+    {
+        // entry, which was taken from the source, but not used anymore
+        if(entry != nullptr) {
+            delete entry;
+        }
+        return false;
     }
 
     // restore the old parent values and update only the existing values with the one form the
@@ -26,6 +26,11 @@
 #include <thread>
 #include <string>
 #include <vector>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <ucontext.h>
 
 #include <processing/subtree_queue.h>
 #include <items/sakura_items.h>
@@ -38,6 +43,24 @@ namespace Kitsunemimi
 namespace Sakura
 {
 class SakuraLangInterface;
+class IterationSource;
+class Blossom;
+class SakuraThread;
+
+/**
+ * @brief The PlanContext struct is the own stack of a plan, which was taken from the queue by a
+ *        worker-thread. A plan, which has to wait, is parked with its stack, so the worker-thread
+ *        can process other plans in the meantime. The plan is always resumed by the same
+ *        worker-thread, because the plan uses the blossom-instances of this thread.
+ */
+struct PlanContext
+{
+    ucontext_t context;
+    void* stack = nullptr;
+    GrowthPlan* plan = nullptr;
+    SakuraThread* worker = nullptr;
+    bool isFinished = false;
+};
 
 class SakuraThread
         : public Kitsunemimi::Thread
@@ -46,19 +69,57 @@ public:
     SakuraThread(SakuraLangInterface* interface,
                  const std::string &threadName);
 
+    PlanContext* getCurrentPlan();
+    void park(std::unique_lock<std::mutex> &lock);
+    void resume(PlanContext* planContext);
+
 private:
     bool m_started = false;
     SakuraLangInterface* m_interface;
 
+    // context of the main-loop and the plan, which is processed at the moment
+    ucontext_t m_mainContext;
+    PlanContext* m_currentPlan = nullptr;
+
+    // parked plans, which can be continued, and stacks of finished plans for the next plans
+    std::mutex m_resumeLock;
+    std::condition_variable m_resumeCond;
+    std::deque<PlanContext*> m_resumedPlans;
+    std::vector<void*> m_freeStacks;
+
+    // blossoms, which are used by this thread, and the own instances of blossoms, which were
+    // registered by a factory
+    std::map<std::string, std::map<std::string, Blossom*>> m_blossoms;
+    std::vector<Blossom*> m_ownBlossoms;
+
     void run();
+    PlanContext* getNextPlan();
+    PlanContext* createPlanContext(GrowthPlan* plan);
+    void deletePlanContext(PlanContext* planContext);
+    void switchToPlan(PlanContext* planContext);
+    static void runPlanContext();
+    void processPlan(GrowthPlan* plan);
+    Blossom* getWorkerBlossom(const std::string &groupName,
+                              const std::string &itemName);
+    void stopWorkerBlossoms();
 
     bool processSakuraItem(GrowthPlan* plan,
                            SakuraItem* sakuraItem);
 
     bool processBlossom(GrowthPlan* plan,
                         BlossomItem &blossomItem);
+    Blossom* getBlossom(GrowthPlan* plan,
+                        BlossomItem &blossomItem);
+    bool prepareBlossom(GrowthPlan* plan,
+                        BlossomItem &blossomItem,
+                        BlossomIO &blossomIO);
+    bool finishBlossom(GrowthPlan* plan,
+                       BlossomItem &blossomItem,
+                       BlossomIO &blossomIO);
     bool processBlossomGroup(GrowthPlan* plan,
                              BlossomGroupItem &blossomGroupItem);
+    bool prepareBlossomGroup(GrowthPlan* plan,
+                             BlossomGroupItem &blossomGroupItem);
     bool processTree(GrowthPlan* plan,
                      TreeItem* treeItem);
     bool processSubtree(GrowthPlan* plan,
@@ -74,6 +135,8 @@ private:
     bool processParallelPart(GrowthPlan* plan,
                              ParallelPart* parallelPart);
 
+    bool runCachedSubtreeCall(GrowthPlan* plan,
+                              SubtreeItem* subtreeItem);
     bool runSubtreeCall(GrowthPlan* plan,
                         SakuraItem* newSubtree,
                         ValueItemMap &values);
@@ -81,9 +144,19 @@ private:
                  SakuraItem* loopContent,
                  const ValueItemMap &values,
                  const std::string &tempVarName,
-                 DataArray* array,
-                 const uint64_t endPos,
-                 const uint64_t startPos = 0);
+                 IterationSource* source);
+    Blossom* getBatchBlossom(SakuraItem* loopContent,
+                             const std::string &tempVarName,
+                             const std::vector<std::string> &variantValues);
+    bool runBatchLoop(GrowthPlan* plan,
+                      SakuraItem* loopContent,
+                      const ValueItemMap &values,
+                      const std::string &tempVarName,
+                      IterationSource* source,
+                      Blossom* blossom);
+    IterationSource* createIterationSource(GrowthPlan* plan,
+                                           ValueItem &iterateItem,
+                                           std::string &text);
 };
 
 } // namespace Sakura
@@ -25,6 +25,8 @@
 #include <items/item_methods.h>
 #include <processing/active_counter.h>
 #include <processing/growth_plan.h>
+#include <processing/iteration_source.h>
+#include <processing/sakura_thread.h>
 #include <libKitsunemimiCommon/logger.h>
 
 namespace Kitsunemimi
@@ -34,8 +36,18 @@ namespace Sakura
 
 /**
  * @brief constructor
+ *
+ * @param numberOfThreads number of worker-threads, which process the queue
  */
-SubtreeQueue::SubtreeQueue() {}
+SubtreeQueue::SubtreeQueue(const uint32_t numberOfThreads)
+{
+    // keep enough subtrees of a loop in the queue to give all threads work, but don't create
+    // all iterations of a big loop at once
+    m_loopWindowSize = 2 * numberOfThreads;
+    if(m_loopWindowSize == 0) {
+        m_loopWindowSize = 1;
+    }
+}
 
 /**
  * @brief add a new subtree-object to the queue
@@ -50,14 +62,18 @@ SubtreeQueue::addGrowthPlan(GrowthPlan* newObject)
 }
 
 /**
- * @brief run a parallel loop
+ * @brief run a parallel loop. The entries are taken from the source within a sliding window, so
+ *        only a limited number of subtrees run at the same time and a new subtree is started,
+ *        whenever one of the running subtrees is finished. The remaining entries are held back
+ *        in the source, so the worker-threads can process other subtrees in the meantime.
  *
  * @param plan plan with all information of the current process
  * @param subtree subtree, which should be executed multiple times by multiple threads
  * @param tempVarName loop-internal variable
- * @param array data-array in case of an iterator-loop, else nullptr
- * @param endPos end position in array or counter end
- * @param startPos start position in array or counter start
+ * @param source source of the entries of the loop
+ * @param width maximum number of subtrees of the loop, which run at the same time
+ *              (0 = default-width of the window)
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr
  *
  * @return true, if successful, else false
  */
@@ -65,59 +81,85 @@ bool
 SubtreeQueue::spawnParallelSubtreesLoop(GrowthPlan* plan,
                                         SakuraItem* subtreeItem,
                                         const std::string &tempVarName,
-                                        DataArray* array,
-                                        uint64_t endPos,
-                                        const uint64_t startPos)
+                                        IterationSource* source,
+                                        const uint32_t width,
+                                        SakuraThread* worker)
 {
-    plan->activeCounter.shouldCount = static_cast<uint32_t>(endPos - startPos);
+    uint64_t windowSize = m_loopWindowSize;
+    if(width > 0) {
+        windowSize = width;
+    }
 
-    for(uint64_t i = startPos; i < endPos; i++)
+    plan->activeCounter.isCounter = 0;
+    uint32_t numberOfStarted = 0;
+    uint32_t numberOfFinished = 0;
+
+    DataItem* entry = source->next();
+    while(true)
     {
-        // encapsulate the content of the loop together with the values and the counter-object
-        // as an subtree-object and add it to the subtree-queue
-        GrowthPlan* childPlan = new GrowthPlan();
-        childPlan->completeSubtree = subtreeItem->copy();
-        childPlan->items = plan->items;
-        childPlan->hirarchy = plan->hirarchy;
-        childPlan->parentPlan = plan;
-        childPlan->filePath = plan->filePath;
-        childPlan->context = plan->context;
+        // start new subtrees, as long as the window has free places
+        while(entry != nullptr
+              && plan->success
+              && numberOfStarted - numberOfFinished < windowSize)
+        {
+            // encapsulate the content of the loop together with the values and the counter-object
+            // as an subtree-object and add it to the subtree-queue
+            GrowthPlan* childPlan = new GrowthPlan();
+            childPlan->completeSubtree = subtreeItem->copy();
+            childPlan->items = plan->items;
+            childPlan->hirarchy = plan->hirarchy;
+            childPlan->parentPlan = plan;
+            childPlan->filePath = plan->filePath;
+            childPlan->context = plan->context;
+            childPlan->incrementalRecord = plan->incrementalRecord;
 
-        // add the counter-variable as new value to be accessable within the loop
-        if(array != nullptr) {
-            childPlan->items.insert(tempVarName, array->get(i)->copy(), true);
-        } else {
-            childPlan->items.insert(tempVarName, new DataValue(static_cast<long>(i)), true);
+            // add the entry as new value to be accessable within the loop
+            childPlan->items.insert(tempVarName, entry, true);
+
+            plan->childPlans.push_back(childPlan);
+            numberOfStarted++;
+            addGrowthPlan(childPlan);
+            entry = source->next();
         }
 
-        addGrowthPlan(childPlan);
-        plan->childPlans.push_back(childPlan);
-    }
+        if(plan->childPlans.size() == 0) {
+            break;
+        }
 
-    waitUntilFinish(&plan->activeCounter);
+        numberOfFinished = waitForNextFinish(&plan->activeCounter, numberOfFinished, worker);
 
-    if(plan->success)
-    {
-        // post-processing and cleanup
-        GrowthPlan* parent = nullptr;
-        for(GrowthPlan* child : plan->childPlans)
+        // post-processing of the finished subtrees in the order of the loop
+        while(plan->childPlans.size() > 0
+              && plan->activeCounter.isFinished(plan->childPlans.front()->finished))
         {
-            parent = child->parentPlan;
-            if(fillInputValueItemMap(parent->postAggregation, child->items, plan->error) == false) {
+            GrowthPlan* child = plan->childPlans.front();
+            if(child->success == false)
+            {
+                plan->error = child->error;
+                plan->status = child->status;
+                plan->success = false;
+            }
+            else if(plan->success
+                    && fillInputValueItemMap(plan->postAggregation,
+                                             child->items,
+                                             plan->error) == false)
+            {
                 plan->success = false;
             }
-        }
 
-        if(parent != nullptr) {
-            overrideItems(parent->items, parent->postAggregation, ONLY_EXISTING);
+            delete child;
+            plan->childPlans.erase(plan->childPlans.begin());
         }
     }
-    else
-    {
-        plan->getErrorResult();
+
+    // entries, which were not used anymore, because of an error
+    if(entry != nullptr) {
+        delete entry;
     }
 
-    plan->clearChilds();
+    if(plan->success) {
+        overrideItems(plan->items, plan->postAggregation, ONLY_EXISTING);
+    }
 
     return plan->success;
 }
@@ -127,15 +169,18 @@ SubtreeQueue::spawnParallelSubtreesLoop(GrowthPlan* plan,
  *
  * @param plan plan with all information of the current process
  * @param childs vector with subtrees, where each subtree should be executed by another thread
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr
  *
  * @return true, if successful, else false
  */
 bool
 SubtreeQueue::spawnParallelSubtrees(GrowthPlan* plan,
-                                    const std::vector<SakuraItem*> &childs)
+                                    const std::vector<SakuraItem*> &childs,
+                                    SakuraThread* worker)
 {
     LOG_DEBUG("spawnParallelSubtrees");
 
+    plan->activeCounter.isCounter = 0;
     plan->activeCounter.shouldCount = static_cast<uint32_t>(childs.size());
 
     // encapsulate each subtree of the paralle part as subtree-object and add it to the
@@ -149,18 +194,20 @@ SubtreeQueue::spawnParallelSubtrees(GrowthPlan* plan,
         childPlan->parentPlan = plan;
         childPlan->filePath = plan->filePath;
         childPlan->context = plan->context;
+        childPlan->incrementalRecord = plan->incrementalRecord;
 
         addGrowthPlan(childPlan);
         plan->childPlans.push_back(childPlan);
     }
 
-    waitUntilFinish(&plan->activeCounter);
+    waitUntilFinish(&plan->activeCounter, worker);
 
-    // write result back for output
+    // write result back for output. The child-plans are deleted afterwards, so their values
+    // can be moved instead of copied.
     if(plan->success)
     {
         for(GrowthPlan* child : plan->childPlans) {
-            overrideItems(plan->items, child->items, ALL);
+            moveItems(plan->items, child->items);
         }
     }
     else
@@ -196,19 +243,35 @@ SubtreeQueue::getGrowthPlan()
 }
 
 /**
- * @brief wait until all spawned tasks are finished
+ * @brief wait until one more spawned task is finished
  *
  * @param activeCounter pointer to the active-counter, which was given each spawned thread
+ * @param numberOfFinished number of finished tasks, which are already known
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr
  *
- * @return true, if successful, else false
+ * @return new number of finished tasks
+ */
+uint32_t
+SubtreeQueue::waitForNextFinish(ActiveCounter* activeCounter,
+                                const uint32_t numberOfFinished,
+                                SakuraThread* worker)
+{
+    return activeCounter->waitUntilAbove(numberOfFinished, worker);
+}
+
+/**
+ * @brief wait until all spawned tasks are finished
+ *
+ * @param activeCounter pointer to the active-counter, which was given each spawned thread
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr
  */
 void
-SubtreeQueue::waitUntilFinish(ActiveCounter* activeCounter)
+SubtreeQueue::waitUntilFinish(ActiveCounter* activeCounter,
+                              SakuraThread* worker)
 {
-    // wait until the created subtree was fully processed by the worker-threads
-    while(activeCounter->isEqual() == false) {
-        std::this_thread::sleep_for(chronoMilliSec(10));
-    }
+    // a worker-thread parks the current plan and processes other ones, because otherwise the
+    // spawned subtrees could wait for a free worker-thread forever
+    activeCounter->waitUntilEqual(worker);
 }
 
 } // namespace Sakura
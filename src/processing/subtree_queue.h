@@ -36,6 +36,8 @@ namespace Sakura
 {
 class SakuraItem;
 class GrowthPlan;
+class IterationSource;
+class SakuraThread;
 struct ActiveCounter;
 
 typedef std::chrono::microseconds chronoMicroSec;
@@ -48,26 +50,32 @@ typedef std::chrono::high_resolution_clock chronoClock;
 class SubtreeQueue
 {
 public:
-    SubtreeQueue();
+    SubtreeQueue(const uint32_t numberOfThreads = 1);
 
     void addGrowthPlan(GrowthPlan* newObject);
 
     bool spawnParallelSubtrees(GrowthPlan* plan,
-                               const std::vector<SakuraItem*> &childs);
+                               const std::vector<SakuraItem*> &childs,
+                               SakuraThread* worker = nullptr);
     bool spawnParallelSubtreesLoop(GrowthPlan* plan,
                                    SakuraItem* subtreeItem,
                                    const std::string &tempVarName,
-                                   DataArray* array,
-                                   uint64_t endPos,
-                                   const uint64_t startPos = 0);
+                                   IterationSource* source,
+                                   const uint32_t width = 0,
+                                   SakuraThread* worker = nullptr);
 
     GrowthPlan* getGrowthPlan();
 
 private:
     std::mutex m_lock;
     std::queue<GrowthPlan*> m_queue;
+    uint64_t m_loopWindowSize = 1;
 
-    void waitUntilFinish(ActiveCounter* activeCounter);
+    uint32_t waitForNextFinish(ActiveCounter* activeCounter,
+                               const uint32_t numberOfFinished,
+                               SakuraThread* worker);
+    void waitUntilFinish(ActiveCounter* activeCounter,
+                         SakuraThread* worker);
 };
 
 } // namespace Sakura
@@ -0,0 +1,90 @@
+/**
+ * @file        wait_list.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "wait_list.h"
+
+#include <processing/sakura_thread.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief wait for the next notify. The lock is released while waiting and the caller has to
+ *        check its condition again afterwards.
+ *
+ * @param lock locked lock of the owner of the list
+ * @param worker worker-thread, which parks the current plan while waiting, or nullptr to block
+ */
+void
+WaitList::wait(std::unique_lock<std::mutex> &lock,
+               SakuraThread* worker)
+{
+    PlanContext* planContext = nullptr;
+    if(worker != nullptr) {
+        planContext = worker->getCurrentPlan();
+    }
+
+    if(planContext == nullptr)
+    {
+        cond.wait(lock);
+        return;
+    }
+
+    parkedPlans.push_back(planContext);
+    worker->park(lock);
+}
+
+/**
+ * @brief wake up one waiting caller. The lock of the owner of the list must be held.
+ */
+void
+WaitList::notifyOne()
+{
+    if(parkedPlans.empty())
+    {
+        cond.notify_one();
+        return;
+    }
+
+    PlanContext* planContext = parkedPlans.front();
+    parkedPlans.pop_front();
+    planContext->worker->resume(planContext);
+}
+
+/**
+ * @brief wake up all waiting callers. The lock of the owner of the list must be held.
+ */
+void
+WaitList::notifyAll()
+{
+    cond.notify_all();
+
+    for(PlanContext* planContext : parkedPlans) {
+        planContext->worker->resume(planContext);
+    }
+    parkedPlans.clear();
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,57 @@
+/**
+ * @file        wait_list.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_WAIT_LIST_H
+#define KITSUNEMIMI_SAKURA_LANG_WAIT_LIST_H
+
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+class SakuraThread;
+struct PlanContext;
+
+/**
+ * @brief The WaitList struct holds all callers, which wait for a condition, which is protected
+ *        by the lock of the owner of the list. Threads outside of the thread-pool block on the
+ *        condition-variable. Worker-threads don't block, but park the plan, which waits, and
+ *        process other plans, until the parked plan is resumed by a notify.
+ */
+struct WaitList
+{
+    std::condition_variable cond;
+    std::deque<PlanContext*> parkedPlans;
+
+    void wait(std::unique_lock<std::mutex> &lock,
+              SakuraThread* worker);
+    void notifyOne();
+    void notifyAll();
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_WAIT_LIST_H
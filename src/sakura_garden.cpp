@@ -23,12 +23,15 @@
 #include "sakura_garden.h"
 
 #include <items/sakura_items.h>
+#include <tree_optimizer.h>
 
 #include <libKitsunemimiCommon/methods/string_methods.h>
 
 #include <libKitsunemimiCommon/logger.h>
 #include <libKitsunemimiCommon/methods/file_methods.h>
 
+#include <cassert>
+
 namespace Kitsunemimi
 {
 namespace Sakura
@@ -74,18 +77,31 @@ SakuraGarden::getRelativePath(const std::filesystem::path &blossomFilePath,
  *
  * @param id id of the new tree
  * @param tree new tree
+ * @param replace true to replace an already existing tree with the same id
  *
- * @return false, if id already exist, else true
+ * @return false, if id already exist and replace is false, else true
  */
 bool
 SakuraGarden::addTree(const std::string &id,
-                      TreeItem* tree)
+                      TreeItem* tree,
+                      const bool replace)
 {
     // check if already exist
-    std::map<std::string, TreeItem*>::const_iterator it;
+    std::map<std::string, TreeItem*>::iterator it;
     it = m_trees.find(id);
-    if(it != m_trees.end()) {
-        return false;
+    if(it != m_trees.end())
+    {
+        if(replace == false) {
+            return false;
+        }
+
+        // replace old tree. other trees can still link to the old object until the next
+        // linking, so it is deleted by the linking and not here
+        LOG_DEBUG("replace tree with id: " + id);
+        m_retiredItems.push_back(it->second);
+        it->second = tree;
+
+        return true;
     }
 
     // add
@@ -100,18 +116,31 @@ SakuraGarden::addTree(const std::string &id,
  *
  * @param id id of the new resource
  * @param resource new resource
+ * @param replace true to replace an already existing resource with the same id
  *
- * @return false, if id already exist, else true
+ * @return false, if id already exist and replace is false, else true
  */
 bool
 SakuraGarden::addResource(const std::string &id,
-                          TreeItem* resource)
+                          TreeItem* resource,
+                          const bool replace)
 {
     // check if already exist
-    std::map<std::string, TreeItem*>::const_iterator it;
+    std::map<std::string, TreeItem*>::iterator it;
     it = m_resources.find(id);
-    if(it != m_resources.end()) {
-        return false;
+    if(it != m_resources.end())
+    {
+        if(replace == false) {
+            return false;
+        }
+
+        // replace old resource. other trees can still link to the old object until the next
+        // linking, so it is deleted by the linking and not here
+        LOG_DEBUG("replace ressource with id: " + id);
+        m_retiredItems.push_back(it->second);
+        it->second = resource;
+
+        return true;
     }
 
     // add
@@ -281,5 +310,230 @@ SakuraGarden::getFile(const std::string &id)
     return nullptr;
 }
 
+/**
+ * @brief resolve all subtree-calls and resource-calls of all registered trees and resources to
+ *        direct references and rebuild the call-graph. Has to be called again after the content
+ *        of the garden was changed.
+ *
+ * @param error reference for error-output
+ *
+ * @return false, if at least one reference could not be resolved, else true
+ */
+bool
+SakuraGarden::linkTrees(ErrorContainer &error)
+{
+    std::vector<std::string> brokenLinks;
+    m_callGraph.clear();
+
+    // link trees
+    std::map<std::string, TreeItem*>::const_iterator it;
+    for(it = m_trees.begin();
+        it != m_trees.end();
+        it++)
+    {
+        std::vector<std::string> callees;
+        linkSakuraItem(it->second, "", callees, brokenLinks);
+        m_callGraph.insert(std::make_pair(it->first, callees));
+    }
+
+    // link resources
+    for(it = m_resources.begin();
+        it != m_resources.end();
+        it++)
+    {
+        std::vector<std::string> callees;
+        linkSakuraItem(it->second, "", callees, brokenLinks);
+        m_callGraph.insert(std::make_pair(it->first, callees));
+    }
+
+    // all links were set again, also the broken ones, so nothing points to replaced items anymore
+    for(TreeItem* retiredItem : m_retiredItems) {
+        delete retiredItem;
+    }
+    m_retiredItems.clear();
+
+    if(brokenLinks.size() > 0)
+    {
+        std::string message = "Following references could not be resolved:\n";
+        for(const std::string& brokenLink : brokenLinks) {
+            message += "    " + brokenLink + "\n";
+        }
+        error.addMeesage(message);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief get the call-graph, which was created by the last linking
+ *
+ * @return map with the id of each tree and resource and the ids of the trees and resources,
+ *         which are called by them
+ */
+const std::map<std::string, std::vector<std::string>>&
+SakuraGarden::getCallGraph() const
+{
+    return m_callGraph;
+}
+
+/**
+ * @brief link all subtree- and resource-calls within a sakura-item
+ *
+ * @param sakuraItem item to link
+ * @param filePath path of the file, which contains the item
+ * @param callees reference for the ids of all called trees and resources
+ * @param brokenLinks reference for the description of all unresolved references
+ *
+ * @return false, if at least one reference could not be resolved, else true
+ */
+bool
+SakuraGarden::linkSakuraItem(SakuraItem* sakuraItem,
+                             const std::string &filePath,
+                             std::vector<std::string> &callees,
+                             std::vector<std::string> &brokenLinks)
+{
+    if(sakuraItem == nullptr) {
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::SEQUENTIELL_ITEM)
+    {
+        SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(sakuraItem);
+        bool result = true;
+        for(SakuraItem* item : sequential->childs) {
+            result = linkSakuraItem(item, filePath, callees, brokenLinks) && result;
+        }
+        return result;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::TREE_ITEM)
+    {
+        TreeItem* treeItem = dynamic_cast<TreeItem*>(sakuraItem);
+        const std::string completePath = treeItem->rootPath + "/" + treeItem->relativePath;
+        return linkSakuraItem(treeItem->childs, completePath, callees, brokenLinks);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::SUBTREE_ITEM)
+    {
+        SubtreeItem* subtreeItem = dynamic_cast<SubtreeItem*>(sakuraItem);
+
+        // resolve path only once here instead of each call while processing
+        std::string relPath = getRelativePath(filePath, subtreeItem->nameOrPath).string();
+        if(relPath == "") {
+            relPath = "root.sakura";
+        }
+
+        subtreeItem->linkedTree = getTree(relPath, false);
+        subtreeItem->linkedId = relPath;
+        if(subtreeItem->linkedTree == nullptr)
+        {
+            brokenLinks.push_back("subtree '" + subtreeItem->nameOrPath + "' "
+                                  "called in '" + filePath + "'");
+            return false;
+        }
+
+        addCallee(callees, relPath);
+        return true;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::BLOSSOM_ITEM)
+    {
+        BlossomItem* blossomItem = dynamic_cast<BlossomItem*>(sakuraItem);
+
+        // blossom-types, which are not registered as resource, are normal blossoms
+        std::map<std::string, TreeItem*>::const_iterator it;
+        it = m_resources.find(blossomItem->blossomType);
+        if(it != m_resources.end())
+        {
+            blossomItem->linkedResource = it->second;
+            addCallee(callees, it->first);
+        }
+        else
+        {
+            blossomItem->linkedResource = nullptr;
+        }
+
+        return true;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::BLOSSOM_GROUP_ITEM)
+    {
+        BlossomGroupItem* blossomGroupItem = dynamic_cast<BlossomGroupItem*>(sakuraItem);
+        bool result = true;
+        for(BlossomItem* blossomItem : blossomGroupItem->blossoms) {
+            result = linkSakuraItem(blossomItem, filePath, callees, brokenLinks) && result;
+        }
+        return result;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::IF_ITEM)
+    {
+        IfBranching* ifBranching = dynamic_cast<IfBranching*>(sakuraItem);
+        bool result = linkSakuraItem(ifBranching->ifContent, filePath, callees, brokenLinks);
+        result = linkSakuraItem(ifBranching->elseContent, filePath, callees, brokenLinks) && result;
+        return result;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::FOR_EACH_ITEM)
+    {
+        ForEachBranching* forEachBranching = dynamic_cast<ForEachBranching*>(sakuraItem);
+        const bool result = linkSakuraItem(forEachBranching->content, filePath, callees, brokenLinks);
+
+        // the def-use-analysis of the loop requires the linked subtrees
+        TreeOptimizer optimizer;
+        optimizer.analyzeLoop(forEachBranching);
+
+        return result;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::FOR_ITEM)
+    {
+        ForBranching* forBranching = dynamic_cast<ForBranching*>(sakuraItem);
+        const bool result = linkSakuraItem(forBranching->content, filePath, callees, brokenLinks);
+
+        // the def-use-analysis of the loop requires the linked subtrees
+        TreeOptimizer optimizer;
+        optimizer.analyzeLoop(forBranching);
+
+        return result;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::PARALLEL_ITEM)
+    {
+        ParallelPart* parallel = dynamic_cast<ParallelPart*>(sakuraItem);
+        return linkSakuraItem(parallel->childs, filePath, callees, brokenLinks);
+    }
+    //----------------------------------------------------------------------------------------------
+
+    // This case should never appear. It can't be produced by the parser at the moment,
+    // so if this assert is called, there so something totally wrong in the implementation
+    assert(false);
+
+    return false;
+}
+
+/**
+ * @brief add id to the list of callees, if not already in the list
+ *
+ * @param callees list of callees
+ * @param calleeId id of the called tree or resource
+ */
+void
+SakuraGarden::addCallee(std::vector<std::string> &callees,
+                        const std::string &calleeId)
+{
+    for(const std::string &callee : callees)
+    {
+        if(callee == calleeId) {
+            return;
+        }
+    }
+
+    callees.push_back(calleeId);
+}
+
 } // namespace Sakura
 } // namespace Kitsunemimi
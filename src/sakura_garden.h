@@ -27,6 +27,7 @@
 #include <string>
 #include <map>
 #include <filesystem>
+#include <libKitsunemimiCommon/logger.h>
 
 namespace Kitsunemimi
 {
@@ -34,6 +35,7 @@ struct DataBuffer;
 
 namespace Sakura
 {
+class SakuraItem;
 class TreeItem;
 class InitialValidator;
 
@@ -46,8 +48,12 @@ public:
     const std::filesystem::path getRelativePath(const std::filesystem::path &blossomFilePath,
                                                const std::filesystem::path &blossomInternalRelPath);
     // add
-    bool addTree(const std::string &id, TreeItem* tree);
-    bool addResource(const std::string &id, TreeItem* resource);
+    bool addTree(const std::string &id,
+                 TreeItem* tree,
+                 const bool replace = false);
+    bool addResource(const std::string &id,
+                     TreeItem* resource,
+                     const bool replace = false);
     bool addTemplate(const std::string &id, const std::string &templateContent);
     bool addFile(const std::string &id, Kitsunemimi::DataBuffer* fileContent);
 
@@ -60,6 +66,10 @@ public:
     const std::string getTemplate(const std::string &id);
     DataBuffer* getFile(const std::string &id);
 
+    // linking
+    bool linkTrees(ErrorContainer &error);
+    const std::map<std::string, std::vector<std::string>>& getCallGraph() const;
+
     // object-handling
     std::string rootPath = "";
 
@@ -70,6 +80,16 @@ private:
     std::map<std::string, TreeItem*> m_resources;
     std::map<std::string, std::string> m_templates;
     std::map<std::string, Kitsunemimi::DataBuffer*> m_files;
+    std::vector<TreeItem*> m_retiredItems;
+
+    std::map<std::string, std::vector<std::string>> m_callGraph;
+
+    bool linkSakuraItem(SakuraItem* sakuraItem,
+                        const std::string &filePath,
+                        std::vector<std::string> &callees,
+                        std::vector<std::string> &brokenLinks);
+    void addCallee(std::vector<std::string> &callees,
+                   const std::string &calleeId);
 };
 
 } // namespace Sakura
@@ -25,15 +25,20 @@
 
 #include <sakura_garden.h>
 #include <initial_validator.h>
+#include <tree_optimizer.h>
 #include <sakura_file_collector.h>
 #include <runtime_validation.h>
 #include <parsing/sakura_parser_interface.h>
 
 #include <processing/subtree_queue.h>
 #include <processing/thread_pool.h>
+#include <processing/concurrency_limit.h>
+#include <processing/result_cache.h>
+#include <processing/incremental_record.h>
 #include <processing/growth_plan.h>
 
 #include <items/item_methods.h>
+#include <items/value_function_registry.h>
 
 #include <libKitsunemimiJinja2/jinja2_converter.h>
 
@@ -54,10 +59,11 @@ SakuraLangInterface::SakuraLangInterface(const uint16_t numberOfThreads,
                                          const bool enableDebug)
 {
     m_validator = new InitialValidator();
+    m_optimizer = new TreeOptimizer();
     m_fileCollector = new SakuraFileCollector(this);
     m_parser = new SakuraParserInterface(enableDebug);
     m_garden = new SakuraGarden();
-    m_queue = new SubtreeQueue();
+    m_queue = new SubtreeQueue(numberOfThreads);
     m_threadPoos = new ThreadPool(numberOfThreads, this);
 }
 
@@ -81,13 +87,28 @@ SakuraLangInterface::getInstance()
  */
 SakuraLangInterface::~SakuraLangInterface()
 {
+    // stop the worker-threads first, because they access the queue until they are stopped
+    delete m_threadPoos;
     delete m_garden;
     delete m_queue;
-    delete m_threadPoos;
+
+    if(m_instance == this) {
+        m_instance = nullptr;
+    }
+
+    for(ConcurrencyLimit* limit : m_concurrencyLimits) {
+        delete limit;
+    }
+    for(ResultCache* cache : m_resultCaches) {
+        delete cache;
+    }
+    clearTreeCaches();
 }
 
 /**
- * @brief trigger existing tree
+ * @brief trigger existing tree. If the tree is marked as cacheable, the result of a previous call
+ *        with the same input-values and the same selected context-values is returned without
+ *        processing the tree again.
  *
  * @param map with resulting items
  * @param id id of the tree to trigger
@@ -109,6 +130,121 @@ SakuraLangInterface::triggerTree(DataMap &result,
 
     std::lock_guard<std::mutex> guard(m_lock);
 
+    ResultCache* cache = getTreeCache(id);
+    if(cache == nullptr) {
+        return runTree(result, id, context, initialValues, status, error);
+    }
+
+    // create key out of the input-values and the selected values of the context
+    TreeItem* tree = m_garden->getTree(id, false);
+    DataMap* selectedContext = new DataMap();
+    for(const std::string &key : tree->cacheContextKeys)
+    {
+        DataItem* value = context.get(key);
+        if(value != nullptr) {
+            selectedContext->insert(key, value->copy());
+        }
+    }
+
+    CacheTicket ticket;
+    ticket.input = new DataMap();
+    ticket.input->insert("values", initialValues.copy());
+    ticket.input->insert("context", selectedContext);
+
+    result.clear();
+    if(cache->get(result, ticket)) {
+        return true;
+    }
+
+    if(runTree(result, id, context, initialValues, status, error) == false)
+    {
+        cache->set(ticket, nullptr);
+        return false;
+    }
+
+    cache->set(ticket, result.copy()->toMap());
+
+    return true;
+}
+
+/**
+ * @brief trigger existing tree incremental. The changed values are merged into the input-values
+ *        of the previous incremental run of the tree. Pure blossoms, whose input has not changed
+ *        by this, reuse their output of the previous run. All other blossoms are executed again.
+ *
+ * @param map with resulting items
+ * @param id id of the tree to trigger
+ * @param changedValues input-values, which have changed since the previous run, or all
+ *                      input-values for the first run
+ * @param status reference for status-output
+ * @param error reference for error-output
+ * @param removedKeys keys of input-values of the previous run, which are not used anymore
+ *
+ * @return true, if successfule, else false
+ */
+bool
+SakuraLangInterface::triggerTreeIncremental(DataMap &result,
+                                            const std::string &id,
+                                            const DataMap &context,
+                                            const DataMap &changedValues,
+                                            BlossomStatus &status,
+                                            ErrorContainer &error,
+                                            const std::vector<std::string> &removedKeys)
+{
+    LOG_DEBUG("trigger tree incremental");
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if(m_garden->getTree(id, false) == nullptr)
+    {
+        error.addMeesage("No tree found for the input-path " + id);
+        LOG_ERROR(error);
+        return false;
+    }
+
+    // get record of the previous run
+    IncrementalRecord* record = nullptr;
+    std::map<std::string, IncrementalRecord*>::const_iterator it;
+    it = m_incrementalRecords.find(id);
+    if(it != m_incrementalRecords.end())
+    {
+        record = it->second;
+    }
+    else
+    {
+        record = new IncrementalRecord();
+        m_incrementalRecords.insert(std::make_pair(id, record));
+    }
+
+    DataMap initialValues;
+    record->startRun(initialValues, changedValues, removedKeys, context);
+    const bool ret = runTree(result, id, context, initialValues, status, error, record);
+    record->finishRun(initialValues, ret);
+
+    return ret;
+}
+
+/**
+ * @brief process a tree
+ *
+ * @param map with resulting items
+ * @param id id of the tree to trigger
+ * @param initialValues input-values for the tree
+ * @param status reference for status-output
+ * @param error reference for error-output
+ * @param record record of the previous run, if the tree is triggered incremental, else nullptr
+ *
+ * @return true, if successfule, else false
+ */
+bool
+SakuraLangInterface::runTree(DataMap &result,
+                             const std::string &id,
+                             const DataMap &context,
+                             const DataMap &initialValues,
+                             BlossomStatus &status,
+                             ErrorContainer &error,
+                             IncrementalRecord* record)
+{
     // get initial tree-item
     TreeItem* tree = m_garden->getTree(id);
     if(tree == nullptr)
@@ -118,10 +254,23 @@ SakuraLangInterface::triggerTree(DataMap &result,
         return false;
     }
 
+    // values, which were fixed by a specialization of the tree, can not be overridden anymore
+    for(const std::string &fixedKey : tree->fixedKeys)
+    {
+        if(initialValues.contains(fixedKey))
+        {
+            error.addMeesage("value '" + fixedKey + "' is fixed in the tree " + id);
+            LOG_ERROR(error);
+            delete tree;
+            return false;
+        }
+    }
+
     // prepare
     GrowthPlan growthPlan;
     growthPlan.items = initialValues;
     growthPlan.context = &context;
+    growthPlan.incrementalRecord = record;
     overrideItems(growthPlan.items, tree->values, ONLY_NON_EXISTING);
     result.clear();
 
@@ -233,9 +382,9 @@ SakuraLangInterface::triggerBlossom(DataMap &result,
         return false;
     }
 
-    // TODO: override only with the output-values to avoid unnecessary conflicts
+    // the output is not used anymore, so its values are moved instead of copied
     result.clear();
-    overrideItems(result, *output, ALL);
+    result.map.swap(output->map);
 
     return true;
 }
@@ -274,6 +423,8 @@ SakuraLangInterface::doesBlossomExist(const std::string &groupName,
  * @param groupName group-identifier of the blossom
  * @param itemName item-identifier of the blossom
  * @param newBlossom pointer to the new blossom
+ * @param maxConcurrency maximum number of tasks of the blossom, which can run at the same time.
+ *                       Further calls wait until a task is finished. 0 disables the limit.
  *
  * @return true, if blossom was registered or false, if the group- and item-name are already
  *         registered
@@ -281,7 +432,8 @@ SakuraLangInterface::doesBlossomExist(const std::string &groupName,
 bool
 SakuraLangInterface::addBlossom(const std::string &groupName,
                                 const std::string &itemName,
-                                Blossom* newBlossom)
+                                Blossom* newBlossom,
+                                const uint32_t maxConcurrency)
 {
     // check if already used
     if(doesBlossomExist(groupName, itemName) == true) {
@@ -298,6 +450,25 @@ SakuraLangInterface::addBlossom(const std::string &groupName,
         m_registeredBlossoms.insert(std::make_pair(groupName, newMap));
     }
 
+    // add limit, which is shared with all instances of the blossom
+    if(maxConcurrency > 0)
+    {
+        newBlossom->m_concurrencyLimit = new ConcurrencyLimit(maxConcurrency);
+        m_concurrencyLimits.push_back(newBlossom->m_concurrencyLimit);
+    }
+
+    // add cache, if the blossom declared itself as pure
+    if(newBlossom->isPure)
+    {
+        uint64_t cacheSize = newBlossom->cacheSize;
+        if(cacheSize == 0) {
+            cacheSize = DEFAULT_CACHE_SIZE;
+        }
+
+        newBlossom->m_resultCache = new ResultCache(cacheSize, newBlossom->cacheTimeToLive);
+        m_resultCaches.push_back(newBlossom->m_resultCache);
+    }
+
     // add item to group
     groupIt = m_registeredBlossoms.find(groupName);
     groupIt->second.insert(std::make_pair(itemName, newBlossom));
@@ -305,6 +476,76 @@ SakuraLangInterface::addBlossom(const std::string &groupName,
     return true;
 }
 
+/**
+ * @brief register a blossom by a factory. One instance is created directly for the validation
+ *        and for triggerBlossom and each worker-thread creates its own instance with the
+ *        factory, when it calls the blossom the first time. The instances of the workers get
+ *        the onWorkerStart- and onWorkerStop-calls.
+ *
+ * @param groupName group-identifier of the blossom
+ * @param itemName item-identifier of the blossom
+ * @param factory function to create a new instance of the blossom
+ * @param maxConcurrency maximum number of tasks over all instances of the blossom, which can run
+ *                       at the same time. 0 disables the limit.
+ *
+ * @return false, if the group- and item-name are already registered or the factory is invalid,
+ *         else true
+ */
+bool
+SakuraLangInterface::addBlossomFactory(const std::string &groupName,
+                                       const std::string &itemName,
+                                       BlossomFactory factory,
+                                       const uint32_t maxConcurrency)
+{
+    // check if already used
+    if(factory == nullptr
+            || doesBlossomExist(groupName, itemName) == true)
+    {
+        return false;
+    }
+
+    Blossom* newBlossom = factory();
+    if(newBlossom == nullptr) {
+        return false;
+    }
+
+    // register the factory before the blossom itself, so no worker-thread can use the shared
+    // instance of the blossom instead of an own one
+    m_factoryLock.lock();
+    m_blossomFactories[groupName].insert(std::make_pair(itemName, factory));
+    m_factoryLock.unlock();
+
+    return addBlossom(groupName, itemName, newBlossom, maxConcurrency);
+}
+
+/**
+ * @brief register a new native function, which can be called on values within sakura-files,
+ *        like value.name(arg1, arg2). The function has to be registered before the trees, which
+ *        are using it, are added.
+ *
+ * @param name name of the function
+ * @param function pointer to the function
+ * @param inputType expected type of the value, where the function is called on
+ * @param argumentTypes expected types of the arguments, which also defines the number of arguments
+ *
+ * @return false, if name is already registered or the function-pointer is invalid, else true
+ */
+bool
+SakuraLangInterface::addValueFunction(const std::string &name,
+                                      ValueFunction function,
+                                      const FieldType inputType,
+                                      const std::vector<FieldType> &argumentTypes)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    ValueFunctionDef definition;
+    definition.function = function;
+    definition.inputType = inputType;
+    definition.argumentTypes = argumentTypes;
+
+    return ValueFunctionRegistry::getInstance()->addFunction(name, definition);
+}
+
 /**
  * @brief request a registered blossom
  *
@@ -336,6 +577,223 @@ SakuraLangInterface::getBlossom(const std::string &groupName,
     return nullptr;
 }
 
+/**
+ * @brief get the statistics of the result-cache of a blossom
+ *
+ * @param statistics reference for the output
+ * @param groupName group-identifier of the blossom
+ * @param itemName item-identifier of the blossom
+ *
+ * @return false, if the blossom doesn't exist or is not pure, else true
+ */
+bool
+SakuraLangInterface::getBlossomCacheStatistics(CacheStatistics &statistics,
+                                               const std::string &groupName,
+                                               const std::string &itemName)
+{
+    Blossom* blossom = getBlossom(groupName, itemName);
+    if(blossom == nullptr
+            || blossom->m_resultCache == nullptr)
+    {
+        return false;
+    }
+
+    blossom->m_resultCache->getStatistics(statistics);
+
+    return true;
+}
+
+/**
+ * @brief get the statistics of the result-cache of a tree
+ *
+ * @param statistics reference for the output
+ * @param id id of the tree
+ *
+ * @return false, if the tree doesn't exist or is not cacheable, else true
+ */
+bool
+SakuraLangInterface::getTreeCacheStatistics(CacheStatistics &statistics,
+                                            const std::string &id)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    ResultCache* cache = getTreeCache(id);
+    if(cache == nullptr) {
+        return false;
+    }
+
+    cache->getStatistics(statistics);
+
+    return true;
+}
+
+/**
+ * @brief get the number of reused and executed blossoms of the last incremental run of a tree
+ *
+ * @param statistics reference for the output
+ * @param id id of the tree
+ *
+ * @return false, if the tree was not triggered incremental yet, else true
+ */
+bool
+SakuraLangInterface::getIncrementalStatistics(IncrementalStatistics &statistics,
+                                              const std::string &id)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    std::map<std::string, IncrementalRecord*>::const_iterator it;
+    it = m_incrementalRecords.find(id);
+    if(it == m_incrementalRecords.end()) {
+        return false;
+    }
+
+    it->second->getStatistics(statistics);
+
+    return true;
+}
+
+/**
+ * @brief get the result-cache of a tree and create it, if not exist yet
+ *
+ * @param id id of the tree
+ *
+ * @return pointer to the cache or nullptr, if the tree doesn't exist or is not cacheable
+ */
+ResultCache*
+SakuraLangInterface::getTreeCache(const std::string &id)
+{
+    std::map<std::string, ResultCache*>::const_iterator it;
+    it = m_treeCaches.find(id);
+    if(it != m_treeCaches.end()) {
+        return it->second;
+    }
+
+    TreeItem* tree = m_garden->getTree(id, false);
+    if(tree == nullptr
+            || tree->cacheSize == 0)
+    {
+        return nullptr;
+    }
+
+    ResultCache* cache = new ResultCache(tree->cacheSize);
+    m_treeCaches.insert(std::make_pair(id, cache));
+
+    return cache;
+}
+
+/**
+ * @brief get the result-cache for cached subtree-calls with a time-to-live and create it, if not
+ *        exist yet
+ *
+ * @param id id of the called tree within the garden
+ * @param timeToLive time in seconds, how long a result is valid
+ *
+ * @return pointer to the cache
+ */
+ResultCache*
+SakuraLangInterface::getSubtreeCache(const std::string &id,
+                                     const uint32_t timeToLive)
+{
+    std::lock_guard<std::mutex> guard(m_subtreeCacheLock);
+
+    // calls with different time-to-live use different caches
+    const std::string cacheId = id + "|" + std::to_string(timeToLive);
+
+    std::map<std::string, ResultCache*>::const_iterator it;
+    it = m_subtreeCaches.find(cacheId);
+    if(it != m_subtreeCaches.end()) {
+        return it->second;
+    }
+
+    ResultCache* cache = new ResultCache(DEFAULT_CACHE_SIZE, timeToLive);
+    m_subtreeCaches.insert(std::make_pair(cacheId, cache));
+
+    return cache;
+}
+
+/**
+ * @brief remove the cached results of all trees and subtree-calls and the records of the
+ *        incremental runs. The result of a tree can change with each change of the garden,
+ *        because of the called subtrees, resources and templates.
+ */
+void
+SakuraLangInterface::clearTreeCaches()
+{
+    std::map<std::string, ResultCache*>::const_iterator it;
+    for(it = m_treeCaches.begin();
+        it != m_treeCaches.end();
+        it++)
+    {
+        delete it->second;
+    }
+    m_treeCaches.clear();
+
+    std::lock_guard<std::mutex> guard(m_subtreeCacheLock);
+    for(it = m_subtreeCaches.begin();
+        it != m_subtreeCaches.end();
+        it++)
+    {
+        delete it->second;
+    }
+    m_subtreeCaches.clear();
+
+    std::map<std::string, IncrementalRecord*>::const_iterator recordIt;
+    for(recordIt = m_incrementalRecords.begin();
+        recordIt != m_incrementalRecords.end();
+        recordIt++)
+    {
+        delete recordIt->second;
+    }
+    m_incrementalRecords.clear();
+}
+
+/**
+ * @brief create a new instance of a blossom for a worker-thread
+ *
+ * @param groupName group-identifier of the blossom
+ * @param itemName item-identifier of the blossom
+ *
+ * @return new instance or nullptr, if the blossom was not registered by a factory
+ */
+Blossom*
+SakuraLangInterface::createWorkerBlossom(const std::string &groupName,
+                                         const std::string &itemName)
+{
+    BlossomFactory factory = nullptr;
+
+    m_factoryLock.lock();
+    std::map<std::string, std::map<std::string, BlossomFactory>>::const_iterator groupIt;
+    groupIt = m_blossomFactories.find(groupName);
+    if(groupIt != m_blossomFactories.end())
+    {
+        std::map<std::string, BlossomFactory>::const_iterator itemIt;
+        itemIt = groupIt->second.find(itemName);
+        if(itemIt != groupIt->second.end()) {
+            factory = itemIt->second;
+        }
+    }
+    m_factoryLock.unlock();
+
+    if(factory == nullptr) {
+        return nullptr;
+    }
+
+    Blossom* newBlossom = factory();
+    if(newBlossom == nullptr) {
+        return nullptr;
+    }
+
+    // use the same limit and cache like the registered instance
+    Blossom* registeredBlossom = getBlossom(groupName, itemName);
+    if(registeredBlossom != nullptr)
+    {
+        newBlossom->m_concurrencyLimit = registeredBlossom->m_concurrencyLimit;
+        newBlossom->m_resultCache = registeredBlossom->m_resultCache;
+    }
+
+    return newBlossom;
+}
+
 /**
  * @brief getter for the comment of a tree-item
  *
@@ -384,13 +842,15 @@ SakuraLangInterface::getTreeValidMap(std::map<std::string, FieldDef> &validation
  * @param id id of the new tree
  * @param treeContent content of the new tree, which should be parsed
  * @param error reference for error-output
+ * @param replace true to replace an already existing tree with the same id
  *
  * @return true, if successfule, else false
  */
 bool
 SakuraLangInterface::addTree(std::string id,
                              const std::string &treeContent,
-                             ErrorContainer &error)
+                             ErrorContainer &error,
+                             const bool replace)
 {
     std::lock_guard<std::mutex> guard(m_lock);
 
@@ -405,11 +865,28 @@ SakuraLangInterface::addTree(std::string id,
         return false;
     }
 
+    // resolve all function-calls of values, so this is not necessary at runtime anymore
+    if(m_optimizer->resolveFunctions(tree, error) == false)
+    {
+        delete tree;
+        return false;
+    }
+
+    m_optimizer->optimizeTree(tree);
+
     if(id == "") {
         id = tree->id;
     }
 
-    return m_garden->addTree(id, tree);
+    if(m_garden->addTree(id, tree, replace) == false)
+    {
+        delete tree;
+        return false;
+    }
+
+    relink();
+
+    return true;
 }
 
 /**
@@ -425,6 +902,7 @@ SakuraLangInterface::addTemplate(const std::string &id,
                                  const std::string &templateContent)
 {
     std::lock_guard<std::mutex> guard(m_lock);
+    clearTreeCaches();
     return m_garden->addTemplate(id, templateContent);
 }
 
@@ -441,6 +919,7 @@ SakuraLangInterface::addFile(const std::string &id,
                              DataBuffer* data)
 {
     std::lock_guard<std::mutex> guard(m_lock);
+    clearTreeCaches();
     return m_garden->addFile(id, data);
 }
 
@@ -450,13 +929,15 @@ SakuraLangInterface::addFile(const std::string &id,
  * @param id id of the new ressource
  * @param content content of the new ressource, which should be parsed
  * @param error reference for error-output
+ * @param replace true to replace an already existing ressource with the same id
  *
  * @return true, if successfule, else false
  */
 bool
 SakuraLangInterface::addResource(std::string id,
                                  const std::string &content,
-                                 ErrorContainer &error)
+                                 ErrorContainer &error,
+                                 const bool replace)
 {
     std::lock_guard<std::mutex> guard(m_lock);
 
@@ -473,11 +954,136 @@ SakuraLangInterface::addResource(std::string id,
         return false;
     }
 
+    // resolve all function-calls of values, so this is not necessary at runtime anymore
+    if(m_optimizer->resolveFunctions(ressource, error) == false)
+    {
+        delete ressource;
+        return false;
+    }
+
+    m_optimizer->optimizeTree(ressource);
+
     if(id == "") {
         id = ressource->id;
     }
 
-    return m_garden->addResource(id, ressource);
+    if(m_garden->addResource(id, ressource, replace) == false)
+    {
+        delete ressource;
+        return false;
+    }
+
+    relink();
+
+    return true;
+}
+
+/**
+ * @brief create a specialized copy of an existing tree, where a subset of the input-values is
+ *        fixed. All references to these values are replaced by the fixed values and
+ *        conditions, which become constant by this, are already resolved.
+ *
+ * @param newId id of the new specialized tree
+ * @param id id of the tree, which should be specialized
+ * @param fixedValues input-values, which should be fixed
+ * @param error reference for error-output
+ *
+ * @return true, if successfule, else false
+ */
+bool
+SakuraLangInterface::specializeTree(const std::string &newId,
+                                    const std::string &id,
+                                    const DataMap &fixedValues,
+                                    ErrorContainer &error)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    TreeItem* tree = m_garden->getTree(id);
+    if(tree == nullptr)
+    {
+        error.addMeesage("No tree found for the input-path " + id);
+        return false;
+    }
+
+    if(m_optimizer->specializeTree(tree, fixedValues, error) == false)
+    {
+        error.addMeesage("Failed to specialize tree " + id);
+        delete tree;
+        return false;
+    }
+
+    tree->id = newId;
+    if(m_garden->addTree(newId, tree) == false)
+    {
+        error.addMeesage("tree with id " + newId + " already exist");
+        delete tree;
+        return false;
+    }
+
+    relink();
+
+    return true;
+}
+
+/**
+ * @brief resolve all subtree- and resource-calls of the registered trees and check, that all of
+ *        them could be resolved
+ *
+ * @param error reference for error-output
+ *
+ * @return false, if there are broken references, else true
+ */
+bool
+SakuraLangInterface::linkTrees(ErrorContainer &error)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_garden->linkTrees(error);
+}
+
+/**
+ * @brief get the call-graph of all registered trees and resources
+ *
+ * @param callGraph reference for the resulting call-graph, which maps the id of each tree and
+ *                  resource to the ids of the trees and resources, which are called by it
+ */
+void
+SakuraLangInterface::getCallGraph(std::map<std::string, std::vector<std::string>> &callGraph)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    callGraph = m_garden->getCallGraph();
+}
+
+/**
+ * @brief update the links between the trees after the content of the garden was changed
+ */
+void
+SakuraLangInterface::relink()
+{
+    clearTreeCaches();
+
+    // while reading a directory, the trees are linked only once after all files were added
+    if(m_deferLinking) {
+        return;
+    }
+
+    // broken references are not an error at this point, because the referenced trees could be
+    // added later. They are reported by linkTrees and at runtime.
+    ErrorContainer linkError;
+    if(m_garden->linkTrees(linkError) == false) {
+        LOG_DEBUG(linkError.toString());
+    }
+}
+
+/**
+ * @brief enable or disable the linking of the trees after each change of the garden
+ *
+ * @param defer true to skip the linking until it is disabled again
+ */
+void
+SakuraLangInterface::setDeferLinking(const bool defer)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_deferLinking = defer;
 }
 
 /**
@@ -492,7 +1098,22 @@ bool
 SakuraLangInterface::readFilesInDir(const std::string &directoryPath,
                                     ErrorContainer &error)
 {
-    return m_fileCollector->readFilesInDir(directoryPath, error);
+    setDeferLinking(true);
+    const bool ret = m_fileCollector->readFilesInDir(directoryPath, error);
+    setDeferLinking(false);
+    if(ret == false) {
+        return false;
+    }
+
+    // report broken references already while loading instead of at runtime
+    if(linkTrees(error) == false)
+    {
+        error.addMeesage("linking of sakura-files failed");
+        LOG_ERROR(error);
+        return false;
+    }
+
+    return true;
 }
 
 /**
@@ -558,15 +1179,21 @@ SakuraLangInterface::runProcess(DataMap &result,
         return false;
     }
 
-    // collect relevant output-values
-    std::map<std::string, DataItem*>::const_iterator it;
-    for(it = plan->items.map.begin();
-        it != plan->items.map.end();
-        it++)
+    // collect relevant output-values, which are moved, because the plan is not used anymore
+    std::map<std::string, DataItem*>::iterator it = plan->items.map.begin();
+    while(it != plan->items.map.end())
     {
-        const ValueItem item = tree->values.getValueItem(it->first);
-        if(item.type == ValueItem::OUTPUT_PAIR_TYPE) {
-            result.insert(it->first, it->second->copy());
+        std::map<std::string, ValueItem>::const_iterator valueIt;
+        valueIt = tree->values.m_valueMap.find(it->first);
+        if(valueIt != tree->values.m_valueMap.end()
+                && valueIt->second.type == ValueItem::OUTPUT_PAIR_TYPE)
+        {
+            result.insert(it->first, it->second);
+            it = plan->items.map.erase(it);
+        }
+        else
+        {
+            it++;
         }
     }
 
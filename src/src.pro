@@ -30,15 +30,26 @@ HEADERS += \
     ../include/libKitsunemimiSakuraLang/structs.h \
     initial_validator.h \
     processing/active_counter.h \
+    processing/concurrency_limit.h \
+    processing/wait_list.h \
+    processing/result_cache.h \
+    processing/incremental_record.h \
+    processing/iteration_source.h \
     processing/growth_plan.h \
     runtime_validation.h \
     sakura_file_collector.h \
     sakura_garden.h \
+    tree_optimizer.h \
     items/sakura_items.h \
     items/value_item_map.h \
     items/value_items.h \
+    items/typed_array.h \
+    items/json_reader.h \
     items/item_methods.h \
+    items/expression_methods.h \
     items/value_item_functions.h \
+    items/value_function_registry.h \
+    items/template_cache.h \
     parsing/sakura_parser_interface.h \
     processing/sakura_thread.h \
     processing/subtree_queue.h \
@@ -47,12 +58,22 @@ HEADERS += \
 SOURCES += \
     initial_validator.cpp \
     items/item_methods.cpp \
+    items/expression_methods.cpp \
     processing/growth_plan.cpp \
+    processing/iteration_source.cpp \
+    processing/result_cache.cpp \
+    processing/wait_list.cpp \
+    processing/incremental_record.cpp \
     runtime_validation.cpp \
     sakura_file_collector.cpp \
     sakura_garden.cpp \
+    tree_optimizer.cpp \
     items/sakura_items.cpp \
     items/value_item_functions.cpp \
+    items/typed_array.cpp \
+    items/json_reader.cpp \
+    items/value_function_registry.cpp \
+    items/template_cache.cpp \
     items/value_item_map.cpp \
     parsing/sakura_parser_interface.cpp \
     blossom.cpp \
@@ -0,0 +1,1103 @@
+/**
+ * @file        tree_optimizer.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "tree_optimizer.h"
+
+#include <items/sakura_items.h>
+#include <items/item_methods.h>
+#include <items/expression_methods.h>
+#include <items/value_function_registry.h>
+#include <items/value_item_functions.h>
+#include <runtime_validation.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+#include <cassert>
+#include <algorithm>
+#include <cctype>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief constructor
+ */
+TreeOptimizer::TreeOptimizer() {}
+
+/**
+ * @brief destructor
+ */
+TreeOptimizer::~TreeOptimizer() {}
+
+/**
+ * @brief resolve all function-calls of the values within a tree and check their number of
+ *        arguments
+ *
+ * @param tree tree to process
+ * @param error reference for error-output
+ *
+ * @return false, if at least one function-call can not be resolved, else true
+ */
+bool
+TreeOptimizer::resolveFunctions(TreeItem* tree,
+                                ErrorContainer &error)
+{
+    ValueFunctionRegistry* registry = ValueFunctionRegistry::getInstance();
+    bool result = true;
+
+    processValueItems(tree->values, [&](ValueItem &valueItem) {
+        result = result && registry->resolveFunctions(valueItem, error);
+    });
+    processValueItems(tree->childs, [&](ValueItem &valueItem) {
+        result = result && registry->resolveFunctions(valueItem, error);
+    });
+
+    return result;
+}
+
+/**
+ * @brief optimize a parsed tree by marking all values, which never change, as constant and
+ *        removing all branches, which can never be executed
+ *
+ * @param tree tree to optimize
+ */
+void
+TreeOptimizer::optimizeTree(TreeItem* tree)
+{
+    tree->childs = optimizeSakuraItem(tree->childs);
+}
+
+/**
+ * @brief specialize a tree for a fixed set of input-values. All references to these values are
+ *        replaced by the fixed values and the tree is optimized again afterwards. The fixed
+ *        values can not be overridden by the caller of the tree anymore.
+ *
+ * @param tree tree to specialize
+ * @param fixedValues input-values, which should be fixed
+ * @param error reference for error-output
+ *
+ * @return false, if a value doesn't exist, has the wrong type or is changed within the tree,
+ *         else true
+ */
+bool
+TreeOptimizer::specializeTree(TreeItem* tree,
+                              const DataMap &fixedValues,
+                              ErrorContainer &error)
+{
+    // check that only input-values of the tree should be fixed
+    std::map<std::string, DataItem*>::const_iterator it;
+    for(it = fixedValues.map.begin();
+        it != fixedValues.map.end();
+        it++)
+    {
+        std::map<std::string, ValueItem>::const_iterator valueIt;
+        valueIt = tree->values.m_valueMap.find(it->first);
+        if(valueIt == tree->values.m_valueMap.end()
+                || valueIt->second.type != ValueItem::INPUT_PAIR_TYPE)
+        {
+            error.addMeesage("'" + it->first + "' is not an input-value "
+                             "of the tree '" + tree->id + "'");
+            return false;
+        }
+    }
+
+    // check types of the fixed values
+    if(checkTreeValues(tree->values, fixedValues, ValueItem::INPUT_PAIR_TYPE, error) == false) {
+        return false;
+    }
+
+    // values, which are changed while processing the tree, can not be fixed
+    std::set<std::string> writtenValues;
+    if(collectWrittenValues(tree->childs, writtenValues) == false)
+    {
+        error.addMeesage("tree '" + tree->id + "' contains unresolved subtree-calls");
+        return false;
+    }
+
+    for(it = fixedValues.map.begin();
+        it != fixedValues.map.end();
+        it++)
+    {
+        if(writtenValues.find(it->first) != writtenValues.end())
+        {
+            error.addMeesage("value '" + it->first + "' is changed within "
+                             "the tree '" + tree->id + "' and can not be fixed");
+            return false;
+        }
+    }
+
+    // fix values of the tree
+    for(it = fixedValues.map.begin();
+        it != fixedValues.map.end();
+        it++)
+    {
+        ValueItem* valueItem = &tree->values.m_valueMap[it->first];
+        delete valueItem->item;
+        valueItem->item = it->second->copy();
+        valueItem->isConstant = true;
+        tree->fixedKeys.push_back(it->first);
+    }
+
+    processValueItems(tree->childs, [&](ValueItem &valueItem) {
+        substituteValue(valueItem, fixedValues);
+    });
+    optimizeTree(tree);
+
+    return true;
+}
+
+/**
+ * @brief collect the names of all values, which can be changed while processing a sakura-item
+ *
+ * @param sakuraItem item to check
+ * @param writtenValues reference for the resulting names
+ *
+ * @return false, if the item contains unresolved subtree-calls, else true
+ */
+bool
+TreeOptimizer::collectWrittenValues(SakuraItem* sakuraItem,
+                                    std::set<std::string> &writtenValues)
+{
+    if(sakuraItem == nullptr) {
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::SEQUENTIELL_ITEM)
+    {
+        SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(sakuraItem);
+        for(SakuraItem* item : sequential->childs)
+        {
+            if(collectWrittenValues(item, writtenValues) == false) {
+                return false;
+            }
+        }
+        return true;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::TREE_ITEM)
+    {
+        TreeItem* treeItem = dynamic_cast<TreeItem*>(sakuraItem);
+        return collectWrittenValues(treeItem->childs, writtenValues);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::SUBTREE_ITEM)
+    {
+        // all values of the call and of the called tree are written back to the caller
+        SubtreeItem* subtreeItem = dynamic_cast<SubtreeItem*>(sakuraItem);
+        if(subtreeItem->linkedTree == nullptr) {
+            return false;
+        }
+
+        addKeys(subtreeItem->values, writtenValues);
+
+        // values of the called tree, which are not set by the call, are written back with
+        // their default-value
+        std::map<std::string, ValueItem>::const_iterator it;
+        for(it = subtreeItem->linkedTree->values.m_valueMap.begin();
+            it != subtreeItem->linkedTree->values.m_valueMap.end();
+            it++)
+        {
+            if(subtreeItem->values.contains(it->first) == false) {
+                writtenValues.insert(it->first);
+            }
+        }
+
+        return true;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::BLOSSOM_ITEM)
+    {
+        // all values of a blossom are written back after the blossom was processed
+        BlossomItem* blossomItem = dynamic_cast<BlossomItem*>(sakuraItem);
+        addKeys(blossomItem->values, writtenValues);
+        if(blossomItem->linkedResource != nullptr) {
+            addKeys(blossomItem->linkedResource->values, writtenValues);
+        }
+        return true;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::BLOSSOM_GROUP_ITEM)
+    {
+        BlossomGroupItem* blossomGroupItem = dynamic_cast<BlossomGroupItem*>(sakuraItem);
+        addKeys(blossomGroupItem->values, writtenValues);
+        for(BlossomItem* blossomItem : blossomGroupItem->blossoms) {
+            collectWrittenValues(blossomItem, writtenValues);
+        }
+        return true;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::IF_ITEM)
+    {
+        IfBranching* ifBranching = dynamic_cast<IfBranching*>(sakuraItem);
+        if(collectWrittenValues(ifBranching->ifContent, writtenValues) == false) {
+            return false;
+        }
+        return collectWrittenValues(ifBranching->elseContent, writtenValues);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::FOR_EACH_ITEM)
+    {
+        ForEachBranching* forEachBranching = dynamic_cast<ForEachBranching*>(sakuraItem);
+        writtenValues.insert(forEachBranching->tempVarName);
+        addKeys(forEachBranching->values, writtenValues);
+        return collectWrittenValues(forEachBranching->content, writtenValues);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::FOR_ITEM)
+    {
+        ForBranching* forBranching = dynamic_cast<ForBranching*>(sakuraItem);
+        writtenValues.insert(forBranching->tempVarName);
+        addKeys(forBranching->values, writtenValues);
+        return collectWrittenValues(forBranching->content, writtenValues);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::PARALLEL_ITEM)
+    {
+        ParallelPart* parallel = dynamic_cast<ParallelPart*>(sakuraItem);
+        return collectWrittenValues(parallel->childs, writtenValues);
+    }
+    //----------------------------------------------------------------------------------------------
+
+    // This case should never appear. It can't be produced by the parser at the moment,
+    // so if this assert is called, there so something totally wrong in the implementation
+    assert(false);
+
+    return false;
+}
+
+/**
+ * @brief def-use-analysis of a loop to find all values, which can change between the
+ *        iterations of the loop. The result is stored within the loop-item.
+ *
+ * @param loopItem for- or for-each-loop to analyze
+ */
+void
+TreeOptimizer::analyzeLoop(SakuraItem* loopItem)
+{
+    std::set<std::string> writtenValues;
+    const bool isAnalyzed = collectWrittenValues(loopItem, writtenValues);
+
+    if(loopItem->getType() == SakuraItem::FOR_EACH_ITEM)
+    {
+        ForEachBranching* forEachBranching = dynamic_cast<ForEachBranching*>(loopItem);
+        forEachBranching->variantValues.assign(writtenValues.begin(), writtenValues.end());
+        forEachBranching->isAnalyzed = isAnalyzed;
+    }
+
+    if(loopItem->getType() == SakuraItem::FOR_ITEM)
+    {
+        ForBranching* forBranching = dynamic_cast<ForBranching*>(loopItem);
+        forBranching->variantValues.assign(writtenValues.begin(), writtenValues.end());
+        forBranching->isAnalyzed = isAnalyzed;
+    }
+}
+
+/**
+ * @brief evaluate all values within the content of a loop, which don't depend on any value,
+ *        which can change between the iterations, so they are evaluated only once before the
+ *        loop instead of in each iteration. Values, which can not be evaluated at this point,
+ *        are evaluated normally within the iterations.
+ *
+ * @param loopContent content of the loop, which will be copied for each iteration
+ * @param variantValues names of the values, which can change between the iterations
+ * @param items values of the parent before the loop
+ */
+void
+TreeOptimizer::hoistLoopInvariants(SakuraItem* loopContent,
+                                   const std::vector<std::string> &variantValues,
+                                   DataMap &items)
+{
+    processValueItems(loopContent, [&](ValueItem &valueItem)
+    {
+        if(valueItem.isConstant
+                || valueItem.type == ValueItem::OUTPUT_PAIR_TYPE)
+        {
+            return;
+        }
+
+        // check dependencies of the value
+        std::vector<std::string> readValues;
+        collectReadValues(valueItem, readValues);
+        for(const std::string &readValue : readValues)
+        {
+            if(std::find(variantValues.begin(), variantValues.end(), readValue)
+                    != variantValues.end())
+            {
+                indexInvariantArray(valueItem, variantValues, items);
+                return;
+            }
+        }
+
+        ValueItem filledItem = valueItem;
+        ErrorContainer hoistError;
+        if(fillValueItem(filledItem, items, hoistError) == false) {
+            return;
+        }
+
+        filledItem.functions.clear();
+        filledItem.isIdentifier = false;
+        filledItem.isConstant = true;
+        valueItem = filledItem;
+    });
+}
+
+/**
+ * @brief get the blossom-group of a loop-content, which contains only a single blossom-group
+ *        with a single blossom
+ *
+ * @param loopContent content of the loop
+ *
+ * @return blossom-group or nullptr, if the content has another structure
+ */
+BlossomGroupItem*
+TreeOptimizer::getSingleBlossomGroup(SakuraItem* loopContent)
+{
+    SakuraItem* item = loopContent;
+    while(item != nullptr
+          && item->getType() == SakuraItem::SEQUENTIELL_ITEM)
+    {
+        SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(item);
+        if(sequential->childs.size() != 1) {
+            return nullptr;
+        }
+        item = sequential->childs.front();
+    }
+
+    if(item == nullptr
+            || item->getType() != SakuraItem::BLOSSOM_GROUP_ITEM)
+    {
+        return nullptr;
+    }
+
+    BlossomGroupItem* blossomGroupItem = dynamic_cast<BlossomGroupItem*>(item);
+    if(blossomGroupItem->blossoms.size() != 1
+            || blossomGroupItem->blossoms.front()->linkedResource != nullptr)
+    {
+        return nullptr;
+    }
+
+    return blossomGroupItem;
+}
+
+/**
+ * @brief check if the iterations of a loop can be given together to a blossom. This is only
+ *        possible, if the content of the loop is a single blossom, whose inputs don't depend on
+ *        the outputs of the previous iterations.
+ *
+ * @param loopContent content of the loop
+ * @param tempVarName name of the loop-internal variable
+ * @param variantValues names of the values, which can change between the iterations
+ *
+ * @return blossom-group of the loop-content, if batchable, else nullptr
+ */
+BlossomGroupItem*
+TreeOptimizer::getBatchBlossomGroup(SakuraItem* loopContent,
+                                    const std::string &tempVarName,
+                                    const std::vector<std::string> &variantValues)
+{
+    BlossomGroupItem* blossomGroupItem = getSingleBlossomGroup(loopContent);
+    if(blossomGroupItem == nullptr) {
+        return nullptr;
+    }
+
+    // check dependencies of the inputs and the name of the group
+    std::vector<std::string> readValues;
+    collectTemplateIdentifiers(blossomGroupItem->id, readValues);
+    processValueItems(blossomGroupItem, [&](ValueItem &valueItem)
+    {
+        if(valueItem.type != ValueItem::OUTPUT_PAIR_TYPE) {
+            collectReadValues(valueItem, readValues);
+        }
+    });
+
+    for(const std::string &readValue : readValues)
+    {
+        if(readValue != tempVarName
+                && std::find(variantValues.begin(), variantValues.end(), readValue)
+                   != variantValues.end())
+        {
+            return nullptr;
+        }
+    }
+
+    return blossomGroupItem;
+}
+
+/**
+ * @brief create an index for a contains-call on an array, which doesn't change within the loop,
+ *        while the searched value changes in each cycle
+ *
+ * @param valueItem value-item to check
+ * @param variantValues names of all values, which are changed within the loop
+ * @param items data-map with the values at the start of the loop
+ */
+void
+TreeOptimizer::indexInvariantArray(ValueItem &valueItem,
+                                   const std::vector<std::string> &variantValues,
+                                   DataMap &items)
+{
+    if(valueItem.isIdentifier == false
+            || valueItem.expression != nullptr
+            || valueItem.functions.size() == 0
+            || valueItem.functions.front().specialType != FunctionItem::CONTAINS_TYPE
+            || valueItem.functions.front().arguments.size() != 1)
+    {
+        return;
+    }
+
+    const std::string name = valueItem.item->toString();
+    if(std::find(variantValues.begin(), variantValues.end(), name) != variantValues.end()) {
+        return;
+    }
+
+    DataItem* array = items.get(name);
+    if(array == nullptr
+            || array->isArray() == false)
+    {
+        return;
+    }
+
+    ContainsIndex* index = new ContainsIndex();
+    buildContainsIndex(*index, array->toArray());
+    valueItem.containsIndex.reset(index);
+}
+
+/**
+ * @brief optimize a sakura-item and all of its childs
+ *
+ * @param sakuraItem item to optimize
+ *
+ * @return item, which should be used instead of the original item. If this is not the original
+ *         item, the original item was already deleted.
+ */
+SakuraItem*
+TreeOptimizer::optimizeSakuraItem(SakuraItem* sakuraItem)
+{
+    if(sakuraItem == nullptr) {
+        return nullptr;
+    }
+
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::SEQUENTIELL_ITEM)
+    {
+        SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(sakuraItem);
+        for(uint32_t i = 0; i < sequential->childs.size(); i++) {
+            sequential->childs[i] = optimizeSakuraItem(sequential->childs.at(i));
+        }
+        return sakuraItem;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::TREE_ITEM)
+    {
+        TreeItem* treeItem = dynamic_cast<TreeItem*>(sakuraItem);
+        optimizeTree(treeItem);
+        return sakuraItem;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::SUBTREE_ITEM)
+    {
+        markConstants(sakuraItem->values);
+        return sakuraItem;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::BLOSSOM_ITEM)
+    {
+        markConstants(sakuraItem->values);
+        return sakuraItem;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::BLOSSOM_GROUP_ITEM)
+    {
+        BlossomGroupItem* blossomGroupItem = dynamic_cast<BlossomGroupItem*>(sakuraItem);
+        markConstants(blossomGroupItem->values);
+        for(BlossomItem* blossomItem : blossomGroupItem->blossoms) {
+            markConstants(blossomItem->values);
+        }
+        return sakuraItem;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::IF_ITEM)
+    {
+        IfBranching* ifBranching = dynamic_cast<IfBranching*>(sakuraItem);
+        processValueItems(ifBranching->condition,
+                          [this](ValueItem &valueItem) { markConstant(valueItem); });
+        ifBranching->ifContent = optimizeSakuraItem(ifBranching->ifContent);
+        ifBranching->elseContent = optimizeSakuraItem(ifBranching->elseContent);
+
+        // keep condition, if it can not be evaluated while loading
+        bool isConstant = true;
+        processValueItems(ifBranching->condition,
+                          [&isConstant](ValueItem &valueItem) {
+                              isConstant = isConstant && valueItem.isConstant;
+                          });
+        if(isConstant == false) {
+            return sakuraItem;
+        }
+
+        // evaluate condition in the same way like while processing, but on a copy to keep the
+        // original condition in case of an error, which has to be reported at runtime
+        bool ifMatch = false;
+        DataMap emptyValues;
+        ErrorContainer scratchError;
+        ExpressionItem condition = ifBranching->condition;
+        if(evaluateCondition(ifMatch, condition, emptyValues, scratchError) == false) {
+            return sakuraItem;
+        }
+
+        // replace the condition by the branch, which is always executed
+        SakuraItem* result = nullptr;
+        if(ifMatch)
+        {
+            result = ifBranching->ifContent;
+            ifBranching->ifContent = nullptr;
+        }
+        else
+        {
+            result = ifBranching->elseContent;
+            ifBranching->elseContent = nullptr;
+        }
+        delete ifBranching;
+
+        if(result == nullptr) {
+            result = new SequentiellPart();
+        }
+
+        return result;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::FOR_EACH_ITEM)
+    {
+        ForEachBranching* forEachBranching = dynamic_cast<ForEachBranching*>(sakuraItem);
+        markConstants(forEachBranching->iterateArray);
+        markConstants(forEachBranching->values);
+        forEachBranching->content = optimizeSakuraItem(forEachBranching->content);
+
+        // remove loops over constant empty arrays, but only if they have no values, because
+        // these would be written into the parent even if the loop has no iterations
+        std::map<std::string, ValueItem>::const_iterator it;
+        it = forEachBranching->iterateArray.m_valueMap.find("array");
+        if(it != forEachBranching->iterateArray.m_valueMap.end()
+                && it->second.isConstant
+                && it->second.item->isArray()
+                && it->second.item->size() == 0
+                && forEachBranching->values.size() == 0)
+        {
+            delete forEachBranching;
+            return new SequentiellPart();
+        }
+
+        return sakuraItem;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::FOR_ITEM)
+    {
+        ForBranching* forBranching = dynamic_cast<ForBranching*>(sakuraItem);
+        markConstant(forBranching->start);
+        markConstant(forBranching->end);
+        markConstants(forBranching->values);
+        forBranching->content = optimizeSakuraItem(forBranching->content);
+
+        // remove loops with a constant empty range
+        if(forBranching->start.isConstant
+                && forBranching->end.isConstant
+                && forBranching->start.item->isIntValue()
+                && forBranching->end.item->isIntValue()
+                && forBranching->start.item->toValue()->getLong()
+                   >= forBranching->end.item->toValue()->getLong()
+                && forBranching->values.size() == 0)
+        {
+            delete forBranching;
+            return new SequentiellPart();
+        }
+
+        return sakuraItem;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(sakuraItem->getType() == SakuraItem::PARALLEL_ITEM)
+    {
+        ParallelPart* parallel = dynamic_cast<ParallelPart*>(sakuraItem);
+        parallel->childs = optimizeSakuraItem(parallel->childs);
+        return sakuraItem;
+    }
+    //----------------------------------------------------------------------------------------------
+
+    // This case should never appear. It can't be produced by the parser at the moment,
+    // so if this assert is called, there so something totally wrong in the implementation
+    assert(false);
+
+    return sakuraItem;
+}
+
+/**
+ * @brief mark all constant values of a value-item-map
+ *
+ * @param values value-item-map to check
+ */
+void
+TreeOptimizer::markConstants(ValueItemMap &values)
+{
+    std::map<std::string, ValueItem>::iterator it;
+    for(it = values.m_valueMap.begin();
+        it != values.m_valueMap.end();
+        it++)
+    {
+        markConstant(it->second);
+    }
+
+    std::map<std::string, ValueItemMap*>::iterator itChild;
+    for(itChild = values.m_childMaps.begin();
+        itChild != values.m_childMaps.end();
+        itChild++)
+    {
+        markConstants(*itChild->second);
+    }
+}
+
+/**
+ * @brief mark a value as constant, if it is a literal, which doesn't have to be processed
+ *        anymore while processing the tree
+ *
+ * @param valueItem value-item to check
+ */
+void
+TreeOptimizer::markConstant(ValueItem &valueItem)
+{
+    // arguments of function-calls are processed each time the function is called
+    for(FunctionItem &functionItem : valueItem.functions)
+    {
+        for(ValueItem &argument : functionItem.arguments) {
+            markConstant(argument);
+        }
+    }
+
+    // expressions are evaluated while loading, if all of their operands are constant
+    if(valueItem.expression != nullptr)
+    {
+        bool isConstant = true;
+        processValueItems(*valueItem.expression, [&](ValueItem &operand) {
+            markConstant(operand);
+            isConstant = isConstant && operand.isConstant;
+        });
+
+        // lambdas are evaluated by their function, so they can not be replaced by their result
+        if(isConstant == false
+                || valueItem.expression->parameters.size() > 0)
+        {
+            return;
+        }
+
+        ValueItem constantItem = valueItem;
+        DataMap noValues;
+        ErrorContainer foldError;
+        if(fillValueItem(constantItem, noValues, foldError) == false) {
+            return;
+        }
+
+        constantItem.functions.clear();
+        constantItem.isConstant = true;
+        valueItem = constantItem;
+        return;
+    }
+
+    if(valueItem.item == nullptr
+            || valueItem.isIdentifier
+            || valueItem.type == ValueItem::OUTPUT_PAIR_TYPE
+            || valueItem.functions.size() > 0)
+    {
+        return;
+    }
+
+    // strings are interpreted as jinja2-templates, so they are only constant, if they don't
+    // contain any jinja2-markers
+    if(valueItem.item->isStringValue()
+            && isJinja2Template(valueItem.item->toValue()->content.stringValue))
+    {
+        return;
+    }
+
+    valueItem.isConstant = true;
+}
+
+/**
+ * @brief call a callback for each value-item, which is processed while processing a sakura-item
+ *
+ * @param sakuraItem item to iterate over
+ * @param callback callback, which is called for each value-item
+ */
+void
+TreeOptimizer::processValueItems(SakuraItem* sakuraItem,
+                                 const std::function<void(ValueItem&)> &callback)
+{
+    if(sakuraItem == nullptr) {
+        return;
+    }
+
+    switch(sakuraItem->getType())
+    {
+        case SakuraItem::SEQUENTIELL_ITEM:
+        {
+            SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(sakuraItem);
+            for(SakuraItem* item : sequential->childs) {
+                processValueItems(item, callback);
+            }
+            break;
+        }
+        case SakuraItem::BLOSSOM_GROUP_ITEM:
+        {
+            BlossomGroupItem* blossomGroupItem = dynamic_cast<BlossomGroupItem*>(sakuraItem);
+            processValueItems(blossomGroupItem->values, callback);
+            for(BlossomItem* blossomItem : blossomGroupItem->blossoms) {
+                processValueItems(blossomItem->values, callback);
+            }
+            break;
+        }
+        case SakuraItem::BLOSSOM_ITEM:
+        case SakuraItem::SUBTREE_ITEM:
+        {
+            processValueItems(sakuraItem->values, callback);
+            break;
+        }
+        case SakuraItem::IF_ITEM:
+        {
+            IfBranching* ifBranching = dynamic_cast<IfBranching*>(sakuraItem);
+            processValueItems(ifBranching->condition, callback);
+            processValueItems(ifBranching->ifContent, callback);
+            processValueItems(ifBranching->elseContent, callback);
+            break;
+        }
+        case SakuraItem::FOR_EACH_ITEM:
+        {
+            ForEachBranching* forEachBranching = dynamic_cast<ForEachBranching*>(sakuraItem);
+            processValueItems(forEachBranching->iterateArray, callback);
+            processValueItems(forEachBranching->values, callback);
+            processValueItems(forEachBranching->content, callback);
+            break;
+        }
+        case SakuraItem::FOR_ITEM:
+        {
+            ForBranching* forBranching = dynamic_cast<ForBranching*>(sakuraItem);
+            callback(forBranching->start);
+            callback(forBranching->end);
+            processValueItems(forBranching->values, callback);
+            processValueItems(forBranching->content, callback);
+            break;
+        }
+        case SakuraItem::PARALLEL_ITEM:
+        {
+            ParallelPart* parallel = dynamic_cast<ParallelPart*>(sakuraItem);
+            processValueItems(parallel->childs, callback);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief call a callback for each value-item of a value-item-map
+ *
+ * @param values value-item-map to iterate over
+ * @param callback callback, which is called for each value-item
+ */
+void
+TreeOptimizer::processValueItems(ValueItemMap &values,
+                                 const std::function<void(ValueItem&)> &callback)
+{
+    std::map<std::string, ValueItem>::iterator it;
+    for(it = values.m_valueMap.begin();
+        it != values.m_valueMap.end();
+        it++)
+    {
+        callback(it->second);
+    }
+
+    std::map<std::string, ValueItemMap*>::iterator itChild;
+    for(itChild = values.m_childMaps.begin();
+        itChild != values.m_childMaps.end();
+        itChild++)
+    {
+        processValueItems(*itChild->second, callback);
+    }
+}
+
+/**
+ * @brief call a callback for each value-item within the operands of an expression
+ *
+ * @param expression expression to iterate over
+ * @param callback callback, which is called for each value-item
+ */
+void
+TreeOptimizer::processValueItems(ExpressionItem &expression,
+                                 const std::function<void(ValueItem&)> &callback)
+{
+    if(expression.type == ExpressionItem::VALUE_EXPRESSION)
+    {
+        callback(expression.value);
+        return;
+    }
+
+    if(expression.left != nullptr) {
+        processValueItems(*expression.left, callback);
+    }
+    if(expression.right != nullptr) {
+        processValueItems(*expression.right, callback);
+    }
+}
+
+/**
+ * @brief replace a reference to a fixed value by the value itself and process its
+ *        function-calls, if possible
+ *
+ * @param valueItem value-item to process
+ * @param fixedValues fixed values
+ */
+void
+TreeOptimizer::substituteValue(ValueItem &valueItem,
+                               const DataMap &fixedValues)
+{
+    for(FunctionItem &functionItem : valueItem.functions)
+    {
+        for(ValueItem &argument : functionItem.arguments) {
+            substituteValue(argument, fixedValues);
+        }
+    }
+
+    if(valueItem.expression != nullptr)
+    {
+        // parameters of lambdas hide fixed values with the same name
+        const std::vector<std::string> &parameters = valueItem.expression->parameters;
+        processValueItems(*valueItem.expression, [&](ValueItem &operand)
+        {
+            if(operand.isIdentifier
+                    && std::find(parameters.begin(),
+                                 parameters.end(),
+                                 operand.item->toString()) != parameters.end())
+            {
+                return;
+            }
+            substituteValue(operand, fixedValues);
+        });
+        return;
+    }
+
+    if(valueItem.isIdentifier == false
+            || valueItem.type == ValueItem::OUTPUT_PAIR_TYPE)
+    {
+        return;
+    }
+
+    DataItem* fixedItem = fixedValues.get(valueItem.item->toString());
+    if(fixedItem == nullptr) {
+        return;
+    }
+
+    // process the function-calls on the fixed value. If this is not possible, because they
+    // depend on other values, the identifier is resolved normally while processing
+    ValueItem constantItem = valueItem;
+    delete constantItem.item;
+    constantItem.item = fixedItem->copy();
+    constantItem.isIdentifier = false;
+
+    DataMap noValues;
+    ErrorContainer foldError;
+    if(getProcessedItem(constantItem, noValues, foldError) == false) {
+        return;
+    }
+
+    constantItem.functions.clear();
+    constantItem.isConstant = true;
+    valueItem = constantItem;
+}
+
+/**
+ * @brief collect the names of all values, which are read, when a value-item is filled
+ *
+ * @param valueItem value-item to check
+ * @param readValues reference for the resulting names
+ */
+void
+TreeOptimizer::collectReadValues(const ValueItem &valueItem,
+                                 std::vector<std::string> &readValues)
+{
+    for(const FunctionItem &functionItem : valueItem.functions)
+    {
+        for(const ValueItem &argument : functionItem.arguments) {
+            collectReadValues(argument, readValues);
+        }
+    }
+
+    if(valueItem.isConstant
+            || valueItem.item == nullptr)
+    {
+        return;
+    }
+
+    if(valueItem.expression != nullptr)
+    {
+        // parameters of lambdas are not read from the values
+        std::vector<std::string> expressionValues;
+        collectReadValues(*valueItem.expression, expressionValues);
+        const std::vector<std::string> &parameters = valueItem.expression->parameters;
+        for(const std::string &name : expressionValues)
+        {
+            if(std::find(parameters.begin(), parameters.end(), name) == parameters.end()) {
+                readValues.push_back(name);
+            }
+        }
+    }
+    else if(valueItem.isIdentifier)
+    {
+        readValues.push_back(valueItem.item->toString());
+    }
+    else if(valueItem.item->isStringValue())
+    {
+        collectTemplateIdentifiers(valueItem.item->toValue()->getString(), readValues);
+    }
+}
+
+/**
+ * @brief collect the names of all values, which are read, when an expression is evaluated
+ *
+ * @param expression expression to check
+ * @param readValues reference for the resulting names
+ */
+void
+TreeOptimizer::collectReadValues(const ExpressionItem &expression,
+                                 std::vector<std::string> &readValues)
+{
+    if(expression.type == ExpressionItem::VALUE_EXPRESSION)
+    {
+        collectReadValues(expression.value, readValues);
+        return;
+    }
+
+    if(expression.left != nullptr) {
+        collectReadValues(*expression.left, readValues);
+    }
+    if(expression.right != nullptr) {
+        collectReadValues(*expression.right, readValues);
+    }
+}
+
+/**
+ * @brief collect all identifiers within the expressions and statements of a jinja2-template.
+ *        This is a superset of the values, which are read by the template.
+ *
+ * @param templateString jinja2-template to check
+ * @param readValues reference for the resulting names
+ */
+void
+TreeOptimizer::collectTemplateIdentifiers(const std::string &templateString,
+                                          std::vector<std::string> &readValues)
+{
+    uint64_t pos = 0;
+    while(pos < templateString.size())
+    {
+        // search begin of the next expression or statement
+        const uint64_t start = templateString.find('{', pos);
+        if(start == std::string::npos
+                || start + 1 >= templateString.size())
+        {
+            return;
+        }
+
+        const char marker = templateString.at(start + 1);
+        if(marker != '{'
+                && marker != '%')
+        {
+            pos = start + 1;
+            continue;
+        }
+
+        // search end of the expression or statement
+        const std::string endMarker = marker == '{' ? "}}" : "%}";
+        uint64_t end = templateString.find(endMarker, start + 2);
+        if(end == std::string::npos) {
+            end = templateString.size();
+        }
+
+        // split block into identifiers
+        std::string identifier = "";
+        for(uint64_t i = start + 2; i <= end; i++)
+        {
+            const char c = i < end ? templateString.at(i) : ' ';
+            if(std::isalnum(static_cast<unsigned char>(c)) || c == '_')
+            {
+                identifier.push_back(c);
+                continue;
+            }
+
+            if(identifier.size() > 0
+                    && std::isdigit(static_cast<unsigned char>(identifier.at(0))) == false)
+            {
+                readValues.push_back(identifier);
+            }
+            identifier.clear();
+        }
+
+        pos = end + 2;
+    }
+}
+
+/**
+ * @brief add all keys of a value-item-map, which are changed by writing the map back into the
+ *        parent-values, to a set of names
+ *
+ * @param values value-item-map with the keys to add
+ * @param writtenValues set, where the keys should be added
+ */
+void
+TreeOptimizer::addKeys(const ValueItemMap &values,
+                       std::set<std::string> &writtenValues)
+{
+    std::map<std::string, ValueItem>::const_iterator it;
+    for(it = values.m_valueMap.begin();
+        it != values.m_valueMap.end();
+        it++)
+    {
+        // values like '- input = input' write back the same value, which they have read
+        const ValueItem &valueItem = it->second;
+        if(valueItem.isIdentifier
+                && valueItem.type == ValueItem::INPUT_PAIR_TYPE
+                && valueItem.functions.size() == 0
+                && valueItem.item->toString() == it->first)
+        {
+            continue;
+        }
+
+        writtenValues.insert(it->first);
+    }
+
+    std::map<std::string, ValueItemMap*>::const_iterator itChild;
+    for(itChild = values.m_childMaps.begin();
+        itChild != values.m_childMaps.end();
+        itChild++)
+    {
+        writtenValues.insert(itChild->first);
+    }
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,102 @@
+/**
+ * @file        tree_optimizer.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_TREE_OPTIMIZER_H
+#define KITSUNEMIMI_SAKURA_LANG_TREE_OPTIMIZER_H
+
+#include <string>
+#include <set>
+#include <vector>
+#include <functional>
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class DataMap;
+
+namespace Sakura
+{
+class SakuraItem;
+class TreeItem;
+class BlossomGroupItem;
+class ValueItemMap;
+struct ValueItem;
+struct ExpressionItem;
+
+class TreeOptimizer
+{
+public:
+    TreeOptimizer();
+    ~TreeOptimizer();
+
+    bool resolveFunctions(TreeItem* tree,
+                          ErrorContainer &error);
+    void optimizeTree(TreeItem* tree);
+    bool specializeTree(TreeItem* tree,
+                        const DataMap &fixedValues,
+                        ErrorContainer &error);
+
+    bool collectWrittenValues(SakuraItem* sakuraItem,
+                              std::set<std::string> &writtenValues);
+    void analyzeLoop(SakuraItem* loopItem);
+    void hoistLoopInvariants(SakuraItem* loopContent,
+                             const std::vector<std::string> &variantValues,
+                             DataMap &items);
+    BlossomGroupItem* getSingleBlossomGroup(SakuraItem* loopContent);
+    BlossomGroupItem* getBatchBlossomGroup(SakuraItem* loopContent,
+                                           const std::string &tempVarName,
+                                           const std::vector<std::string> &variantValues);
+
+private:
+    SakuraItem* optimizeSakuraItem(SakuraItem* sakuraItem);
+
+    void markConstants(ValueItemMap &values);
+    void markConstant(ValueItem &valueItem);
+
+    void processValueItems(SakuraItem* sakuraItem,
+                           const std::function<void(ValueItem&)> &callback);
+    void processValueItems(ValueItemMap &values,
+                           const std::function<void(ValueItem&)> &callback);
+    void processValueItems(ExpressionItem &expression,
+                           const std::function<void(ValueItem&)> &callback);
+
+    void indexInvariantArray(ValueItem &valueItem,
+                             const std::vector<std::string> &variantValues,
+                             DataMap &items);
+
+    void substituteValue(ValueItem &valueItem,
+                         const DataMap &fixedValues);
+
+    void addKeys(const ValueItemMap &values,
+                 std::set<std::string> &writtenValues);
+    void collectReadValues(const ValueItem &valueItem,
+                           std::vector<std::string> &readValues);
+    void collectReadValues(const ExpressionItem &expression,
+                           std::vector<std::string> &readValues);
+    void collectTemplateIdentifiers(const std::string &templateString,
+                                    std::vector<std::string> &readValues);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_TREE_OPTIMIZER_H
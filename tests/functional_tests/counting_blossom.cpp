@@ -0,0 +1,145 @@
+#include "counting_blossom.h"
+
+#include <thread>
+#include <chrono>
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief blossom, which returns its input as output and counts its calls
+ *
+ * @param counter counter, which is shared between all instances of the blossom
+ * @param batchSize maximum number of loop-iterations, which are processed together
+ */
+CountingBlossom::CountingBlossom(BlossomCounter* counter,
+                                 const uint32_t batchSize,
+                                 const bool async,
+                                 const uint64_t cacheSize,
+                                 const bool pure)
+    : Blossom("")
+{
+    m_counter = counter;
+    m_counter->instances++;
+    m_async = async;
+    allowUnmatched = true;
+    maxBatchSize = batchSize;
+    this->cacheSize = cacheSize;
+    isPure = pure;
+    registerInputField("sleep", SAKURA_INT_TYPE, false, "time to wait in milliseconds");
+    registerInputField("fail", SAKURA_BOOL_TYPE, false, "let the task fail");
+}
+
+bool
+CountingBlossom::runTask(BlossomIO &blossomIO,
+                         const DataMap &,
+                         BlossomStatus &,
+                         ErrorContainer &)
+{
+    LOG_DEBUG("CountingBlossom");
+    m_counter->calls++;
+
+    // update the maximum number of parallel calls
+    const uint32_t active = ++m_counter->active;
+    uint32_t maxActive = m_counter->maxActive;
+    while(active > maxActive
+          && m_counter->maxActive.compare_exchange_weak(maxActive, active) == false) {}
+
+    DataMap* input = blossomIO.input.getItemContent()->toMap();
+    DataItem* sleepTime = input->get("sleep");
+    if(sleepTime != nullptr) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime->toValue()->getLong()));
+    }
+
+    DataItem* value = input->get("input");
+    if(value != nullptr)
+    {
+        if(value->isIntValue()) {
+            m_counter->sum += value->toValue()->getLong();
+        }
+        blossomIO.output.getItemContent()->toMap()->insert("output", value->copy());
+    }
+
+    m_counter->active--;
+
+    DataItem* fail = input->get("fail");
+    if(fail != nullptr
+            && fail->toValue()->getBool())
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool
+CountingBlossom::runTaskBatch(std::vector<BlossomIO> &blossomIOs,
+                              const DataMap &context,
+                              BlossomStatus &status,
+                              ErrorContainer &error)
+{
+    m_counter->batches++;
+    return Blossom::runTaskBatch(blossomIOs, context, status, error);
+}
+
+bool
+CountingBlossom::runTaskAsync(BlossomIO &blossomIO,
+                              const DataMap &context,
+                              BlossomStatus &status,
+                              ErrorContainer &error,
+                              BlossomCompletion &completion)
+{
+    // an instance of a worker is only used by its own worker-thread
+    if(m_workerStarts > 0
+            && m_workerId != std::this_thread::get_id())
+    {
+        m_counter->invalidHooks++;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_counter->threadLock);
+        m_counter->taskThreads.insert(std::this_thread::get_id());
+    }
+
+    if(m_async == false) {
+        return Blossom::runTaskAsync(blossomIO, context, status, error, completion);
+    }
+
+    // run the task in its own thread, like a blossom, which waits for io
+    m_counter->asyncTasks++;
+    std::thread task([&]() {
+        completion.finish(runTask(blossomIO, context, status, error));
+    });
+    task.detach();
+
+    return true;
+}
+
+void
+CountingBlossom::onWorkerStart()
+{
+    m_counter->workerStarts++;
+    if(m_workerStarts > 0) {
+        m_counter->invalidHooks++;
+    }
+
+    m_workerStarts++;
+    m_workerId = std::this_thread::get_id();
+}
+
+void
+CountingBlossom::onWorkerStop()
+{
+    m_counter->workerStops++;
+    if(m_workerStarts != 1
+            || m_workerId != std::this_thread::get_id())
+    {
+        m_counter->invalidHooks++;
+    }
+}
+
+}
+}
@@ -0,0 +1,91 @@
+#ifndef COUNTING_BLOSSOM_H
+#define COUNTING_BLOSSOM_H
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <set>
+#include <libKitsunemimiSakuraLang/blossom.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+struct BlossomCounter
+{
+    std::atomic<uint32_t> calls = {0};
+    std::atomic<uint32_t> active = {0};
+    std::atomic<uint32_t> maxActive = {0};
+    std::atomic<uint32_t> batches = {0};
+    std::atomic<uint32_t> asyncTasks = {0};
+    std::atomic<long> sum = {0};
+
+    // instances of the blossom and calls of their worker-hooks
+    std::atomic<uint32_t> instances = {0};
+    std::atomic<uint32_t> workerStarts = {0};
+    std::atomic<uint32_t> workerStops = {0};
+    std::atomic<uint32_t> invalidHooks = {0};
+
+    // threads, which started the tasks
+    std::mutex threadLock;
+    std::set<std::thread::id> taskThreads;
+
+    void reset()
+    {
+        calls = 0;
+        active = 0;
+        maxActive = 0;
+        batches = 0;
+        asyncTasks = 0;
+        sum = 0;
+        instances = 0;
+        workerStarts = 0;
+        workerStops = 0;
+        invalidHooks = 0;
+
+        std::lock_guard<std::mutex> guard(threadLock);
+        taskThreads.clear();
+    }
+};
+
+class CountingBlossom
+        : public Blossom
+{
+public:
+    CountingBlossom(BlossomCounter* counter,
+                    const uint32_t batchSize = 0,
+                    const bool async = false,
+                    const uint64_t cacheSize = 0,
+                    const bool pure = false);
+
+protected:
+    bool runTask(BlossomIO &blossomIO,
+                 const DataMap &context,
+                 BlossomStatus &status,
+                 ErrorContainer &error);
+    bool runTaskBatch(std::vector<BlossomIO> &blossomIOs,
+                      const DataMap &context,
+                      BlossomStatus &status,
+                      ErrorContainer &error);
+    bool runTaskAsync(BlossomIO &blossomIO,
+                      const DataMap &context,
+                      BlossomStatus &status,
+                      ErrorContainer &error,
+                      BlossomCompletion &completion);
+    void onWorkerStart();
+    void onWorkerStop();
+
+private:
+    BlossomCounter* m_counter = nullptr;
+    bool m_async = false;
+
+    // worker-thread, which owns the instance, if created by a factory
+    uint32_t m_workerStarts = 0;
+    std::thread::id m_workerId;
+};
+
+}
+}
+
+#endif // COUNTING_BLOSSOM_H
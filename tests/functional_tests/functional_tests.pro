@@ -27,10 +27,12 @@ INCLUDEPATH += ../../../libKitsunemimiJson/include
 SOURCES += \
     main.cpp \
     standalone_blossom.cpp \
+    counting_blossom.cpp \
     test_blossom.cpp \
     interface_test.cpp
 
 HEADERS += \
     standalone_blossom.h \
+    counting_blossom.h \
     test_blossom.h \
     interface_test.h
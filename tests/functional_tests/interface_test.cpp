@@ -31,11 +31,39 @@
 #include <libKitsunemimiCommon/files/text_file.h>
 #include <libKitsunemimiCommon/buffer/data_buffer.h>
 
+#include <climits>
+#include <cmath>
+
 namespace Kitsunemimi
 {
 namespace Sakura
 {
 
+/**
+ * @brief value-function for the test of user-defined value-functions
+ */
+DataItem*
+increaseValue(DataItem* item,
+              const std::vector<DataItem*> &,
+              ErrorContainer &)
+{
+    return new DataValue(item->toValue()->getLong() + 1);
+}
+
+std::atomic<uint32_t> numberOfCountedCalls = {0};
+
+/**
+ * @brief value-function, which counts how often it is evaluated
+ */
+DataItem*
+countCall(DataItem* item,
+          const std::vector<DataItem*> &,
+          ErrorContainer &)
+{
+    numberOfCountedCalls++;
+    return item->copy();
+}
+
 /**
  * @brief Interface_Test::Interface_Test
  */
@@ -44,8 +72,25 @@ Interface_Test::Interface_Test() :
 {
     blossomMethods_test();
     addAndGet_test();
+    linkTrees_test();
     runAndTriggerTree_test();
+    specializeTree_test();
+    conditions_test();
+    valueFunctions_test();
+    collectionFunctions_test();
+    splitAndContains_test();
+    containsIndex_test();
+    typedArrayFunctions_test();
+    fileFunctions_test();
+    jsonFunctions_test();
+    loops_test();
+    blossomOutputs_test();
+    parallelTemplates_test();
+    asyncBlossoms_test();
+    concurrencyLimits_test();
+    resultCache_test();
     runAndTriggerBlossom_test();
+    workerBlossoms_test();
 }
 
 /**
@@ -63,6 +108,28 @@ Interface_Test::blossomMethods_test()
     TEST_EQUAL(interface->addBlossom("test1", "test2", testBlossom), false);
     TEST_EQUAL(interface->addBlossom("-", "standalone", standaloneBlossom), true);
 
+    // test addBlossomFactory
+    BlossomFactory factory = [this]() { return new TestBlossom(this); };
+    TEST_EQUAL(interface->addBlossomFactory("test1", "factory", factory), true);
+    TEST_EQUAL(interface->addBlossomFactory("test1", "factory", factory), false);
+    TEST_EQUAL(interface->addBlossomFactory("test1", "test2", factory), false);
+    TEST_EQUAL(interface->doesBlossomExist("test1", "factory"), true);
+
+    // test blossoms, which count their calls
+    TEST_EQUAL(interface->addBlossom("test1", "count", new CountingBlossom(&m_counter)), true);
+    TEST_EQUAL(interface->addBlossom("test1", "batch", new CountingBlossom(&m_counter, 4)), true);
+    CountingBlossom* asyncBlossom = new CountingBlossom(&m_counter, 0, true);
+    TEST_EQUAL(interface->addBlossom("test1", "async", asyncBlossom), true);
+
+    // test blossom with limited concurrency
+    TEST_EQUAL(interface->addBlossom("test1", "limited", new TestBlossom(this), 4), true);
+    TEST_EQUAL(interface->addBlossomFactory("test1", "limited_factory", factory, 4), true);
+
+    // test getBlossomCacheStatistics
+    CacheStatistics statistics;
+    TEST_EQUAL(interface->getBlossomCacheStatistics(statistics, "test1", "test2"), false);
+    TEST_EQUAL(interface->getBlossomCacheStatistics(statistics, "test1", "fail"), false);
+
     // test doesBlossomExist
     TEST_EQUAL(interface->doesBlossomExist("test1", "test2"), true);
     TEST_EQUAL(interface->doesBlossomExist("test1", "fail"), false);
@@ -122,6 +189,54 @@ Interface_Test::addAndGet_test()
     TEST_EQUAL(returnBuffer->usedBufferSize, getTestFile()->usedBufferSize);
 }
 
+/**
+ * @brief Interface_Test::linkTrees_test
+ */
+void
+Interface_Test::linkTrees_test()
+{
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    ErrorContainer error;
+
+    // test broken reference
+    TEST_EQUAL(interface->addTree("link-parent", getTestParentTree(), error), true);
+    TEST_EQUAL(interface->linkTrees(error), false);
+
+    // test resolved reference
+    error._errorMessages.clear();
+    TEST_EQUAL(interface->addTree("link-child", getTestTree(), error), true);
+    TEST_EQUAL(interface->linkTrees(error), true);
+
+    // test getCallGraph
+    std::map<std::string, std::vector<std::string>> callGraph;
+    interface->getCallGraph(callGraph);
+    TEST_EQUAL(callGraph["link-parent"].size(), 1);
+    if(callGraph["link-parent"].size() == 1) {
+        TEST_EQUAL(callGraph["link-parent"].at(0), "link-child");
+    }
+    TEST_EQUAL(callGraph["link-child"].size(), 0);
+
+    // test replace tree
+    TEST_EQUAL(interface->addTree("link-child", getTestTree(), error), false);
+    TEST_EQUAL(interface->addTree("link-child", getTestTree(), error, true), true);
+    TEST_EQUAL(interface->linkTrees(error), true);
+
+    // test replace tree, which is called as subtree
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    DataMap context;
+    DataMap result;
+    BlossomStatus status;
+    TEST_EQUAL(interface->triggerTree(result, "link-parent", context, inputValues, status, error),
+               true);
+    TEST_EQUAL(interface->addTree("link-child", getTestTree(), error, true), true);
+    TEST_EQUAL(interface->triggerTree(result, "link-parent", context, inputValues, status, error),
+               true);
+    if(result.contains("test_output")) {
+        TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+    }
+}
+
 /**
  * @brief runAndTriggerTree_test
  */
@@ -222,144 +337,1403 @@ Interface_Test::runAndTriggerTree_test()
             "+---------------------+-----------------------------------------+\n";
 
     TEST_EQUAL(error.toString(), expectedError);
+
+    //----------------------------------------------------------------------------------------------
+    // test cached tree
+    inputValues.insert("should_fail", new DataValue(false), true);
+    TEST_EQUAL(interface->addTree("test-tree-cached", getTestCachedTree(), error), true);
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-tree-cached",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-tree-cached",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    CacheStatistics statistics;
+    TEST_EQUAL(interface->getTreeCacheStatistics(statistics, "test-tree-cached"), true);
+    TEST_EQUAL(statistics.hits, 1);
+    TEST_EQUAL(statistics.misses, 1);
+    TEST_EQUAL(interface->getTreeCacheStatistics(statistics, "test-tree"), false);
+
+    //----------------------------------------------------------------------------------------------
+    // test cached subtree-calls
+    TEST_EQUAL(interface->addTree("count-child", getTestCountTree(), error), true);
+    TEST_EQUAL(interface->addTree("link-cached", getTestCachedSubtreeTree(), error), true);
+    TEST_EQUAL(interface->linkTrees(error), true);
+    DataMap subtreeValues;
+    subtreeValues.insert("input", new DataValue(42));
+    subtreeValues.insert("test_output", new DataValue(0));
+
+    // the second call within the run is cached, but the call with time-to-live not yet
+    result.clear();
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "link-cached",
+                                      context,
+                                      subtreeValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+    TEST_EQUAL(m_counter.calls, 2);
+
+    // the call with time-to-live is cached across runs with the same context
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "link-cached",
+                                      context,
+                                      subtreeValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+    TEST_EQUAL(m_counter.calls, 1);
+
+    // another context doesn't use the result of the call with time-to-live
+    DataMap otherContext;
+    otherContext.insert("test-key", new DataValue("other"));
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "link-cached",
+                                      otherContext,
+                                      subtreeValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+    TEST_EQUAL(m_counter.calls, 2);
+
+    //----------------------------------------------------------------------------------------------
+    // test incremental trigger
+    CountingBlossom* pureBlossom = new CountingBlossom(&m_counter, 0, false, 0, true);
+    TEST_EQUAL(interface->addBlossom("test1", "pure", pureBlossom), true);
+    TEST_EQUAL(interface->addTree("test-incremental", getTestIncrementalTree(), error), true);
+    IncrementalStatistics incrementalStatistics;
+    TEST_EQUAL(interface->getIncrementalStatistics(incrementalStatistics, "test-incremental"),
+               false);
+    DataMap incrementalValues;
+    incrementalValues.insert("input", new DataValue(42));
+    incrementalValues.insert("pure_output", new DataValue(0));
+    incrementalValues.insert("count_output", new DataValue(0));
+    TEST_EQUAL(interface->triggerTreeIncremental(result,
+                                                 "test-incremental",
+                                                 context,
+                                                 incrementalValues,
+                                                 status,
+                                                 error), true);
+
+    // only the pure blossom is reused, the other one can have side-effects
+    DataMap changedValues;
+    TEST_EQUAL(interface->triggerTreeIncremental(result,
+                                                 "test-incremental",
+                                                 context,
+                                                 changedValues,
+                                                 status,
+                                                 error), true);
+    TEST_EQUAL(result.get("pure_output")->toValue()->getInt(), 42);
+    TEST_EQUAL(result.get("count_output")->toValue()->getInt(), 42);
+    TEST_EQUAL(interface->getIncrementalStatistics(incrementalStatistics, "test-incremental"),
+               true);
+    TEST_EQUAL(incrementalStatistics.reusedBlossoms, 1);
+    TEST_EQUAL(incrementalStatistics.executedBlossoms, 1);
+
+    // value, which is not used by the blossoms
+    changedValues.insert("unused", new DataValue(1));
+    TEST_EQUAL(interface->triggerTreeIncremental(result,
+                                                 "test-incremental",
+                                                 context,
+                                                 changedValues,
+                                                 status,
+                                                 error), true);
+    TEST_EQUAL(interface->getIncrementalStatistics(incrementalStatistics, "test-incremental"),
+               true);
+    TEST_EQUAL(incrementalStatistics.reusedBlossoms, 1);
+    TEST_EQUAL(incrementalStatistics.executedBlossoms, 1);
+
+    // value, which is used by the pure blossom
+    changedValues.insert("offset", new DataValue(1));
+    TEST_EQUAL(interface->triggerTreeIncremental(result,
+                                                 "test-incremental",
+                                                 context,
+                                                 changedValues,
+                                                 status,
+                                                 error), true);
+    TEST_EQUAL(result.get("pure_output")->toValue()->getInt(), 43);
+    TEST_EQUAL(interface->getIncrementalStatistics(incrementalStatistics, "test-incremental"),
+               true);
+    TEST_EQUAL(incrementalStatistics.reusedBlossoms, 0);
+    TEST_EQUAL(incrementalStatistics.executedBlossoms, 2);
+
+    // removed value, so the default-value of the tree is used again
+    DataMap noValues;
+    TEST_EQUAL(interface->triggerTreeIncremental(result,
+                                                 "test-incremental",
+                                                 context,
+                                                 noValues,
+                                                 status,
+                                                 error,
+                                                 {"offset"}), true);
+    TEST_EQUAL(result.get("pure_output")->toValue()->getInt(), 42);
+
+    // changed context
+    DataMap changedContext;
+    changedContext.insert("test-key", new DataValue("asdf"));
+    changedContext.insert("other-key", new DataValue("poi"));
+    TEST_EQUAL(interface->triggerTreeIncremental(result,
+                                                 "test-incremental",
+                                                 changedContext,
+                                                 noValues,
+                                                 status,
+                                                 error), true);
+    TEST_EQUAL(interface->getIncrementalStatistics(incrementalStatistics, "test-incremental"),
+               true);
+    TEST_EQUAL(incrementalStatistics.reusedBlossoms, 0);
+    TEST_EQUAL(incrementalStatistics.executedBlossoms, 2);
 }
 
+/**
+ * @brief Interface_Test::specializeTree_test
+ */
 void
-Interface_Test::positive_BlossomTest()
+Interface_Test::specializeTree_test()
 {
     ErrorContainer error;
-    DataMap inputValues;
-    inputValues.insert("input", new DataValue(42));
     SakuraLangInterface* interface = SakuraLangInterface::getInstance();
     DataMap context;
     context.insert("test-key", new DataValue("asdf"));
-
     DataMap result;
     BlossomStatus status;
-    TEST_EQUAL(interface->triggerBlossom(result,
-                                         "standalone",
-                                         "-",
-                                         context,
-                                         inputValues,
-                                         status,
-                                         error), true);
-    TEST_EQUAL(status.statusCode, 0);
-    TEST_EQUAL(status.errorMessage, "");
-    TEST_EQUAL(result.get("output")->toValue()->getInt(), 42);
+
+    DataMap fixedValues;
+    fixedValues.insert("should_fail", new DataValue(false));
+
+    // test specializeTree
+    TEST_EQUAL(interface->specializeTree("test-tree-fixed", "test-tree", fixedValues, error), true);
+    TEST_EQUAL(interface->specializeTree("test-tree-fixed", "test-tree", fixedValues, error),
+               false);
+    TEST_EQUAL(interface->specializeTree("fail", "fail", fixedValues, error), false);
+
+    // values, which are written within the tree, can not be fixed
+    DataMap writtenValues;
+    writtenValues.insert("test_output", new DataValue(42));
+    TEST_EQUAL(interface->specializeTree("fail", "test-tree", writtenValues, error), false);
+
+    // test trigger of specialized tree
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-tree-fixed",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(result.size(), 1);
+
+    // fixed values can not be overridden
+    inputValues.insert("should_fail", new DataValue(true));
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-tree-fixed",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), false);
 }
 
+/**
+ * @brief Interface_Test::conditions_test
+ */
 void
-Interface_Test::nonExisting_BlossomTest()
+Interface_Test::conditions_test()
 {
     ErrorContainer error;
-    DataMap inputValues;
-    inputValues.insert("input", new DataValue(42));
     SakuraLangInterface* interface = SakuraLangInterface::getInstance();
     DataMap context;
     context.insert("test-key", new DataValue("asdf"));
-
     DataMap result;
     BlossomStatus status;
-    TEST_EQUAL(interface->triggerBlossom(result,
-                                         "fail",
-                                         "-",
-                                         context,
-                                         inputValues,
-                                         status,
-                                         error), false);
-    TEST_EQUAL(status.statusCode, 0);
-    TEST_EQUAL(status.errorMessage, "");
+
+    TEST_EQUAL(interface->addTree("test-condition", getTestConditionTree(), error), true);
+
+    // test if-branch
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-condition",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(result.size(), 1);
+    if(result.size() == 0) {
+        return;
+    }
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    // test else-branch
+    inputValues.insert("should_fail", new DataValue(true), true);
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-condition",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), false);
+    TEST_EQUAL(status.statusCode, 1337);
 }
 
+/**
+ * @brief Interface_Test::valueFunctions_test
+ */
 void
-Interface_Test::invalidInputValues_BlossomTest()
+Interface_Test::valueFunctions_test()
 {
     ErrorContainer error;
     SakuraLangInterface* interface = SakuraLangInterface::getInstance();
     DataMap context;
     context.insert("test-key", new DataValue("asdf"));
-    DataMap falseMap;
-
     DataMap result;
     BlossomStatus status;
-    TEST_EQUAL(interface->triggerBlossom(result,
-                                         "standalone",
-                                         "-",
-                                         context,
-                                         falseMap,
-                                         status,
-                                         error), false);
-    TEST_EQUAL(status.statusCode, 400);
-    TEST_EQUAL(status.errorMessage, "Validation failed, because variable 'input' "
-                                    "is required, but is not set.");
+
+    // test addValueFunction
+    TEST_EQUAL(interface->addValueFunction("increase", increaseValue, SAKURA_INT_TYPE), true);
+    TEST_EQUAL(interface->addValueFunction("increase", increaseValue, SAKURA_INT_TYPE), false);
+    TEST_EQUAL(interface->addValueFunction("size", increaseValue), false);
+
+    // unknown functions are already detected while loading
+    TEST_EQUAL(interface->addTree("fail", getTestFunctionTree("unknown"), error), false);
+    TEST_EQUAL(interface->addTree("test-function", getTestFunctionTree("increase"), error), true);
+
+    // test call of the function
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(41));
+    inputValues.insert("test_output", new DataValue(""));
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-function",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(result.size(), 1);
+
+    // test collection-functions with lambdas
+    TEST_EQUAL(interface->addTree("test-collection", getTestCollectionTree(), error), true);
+    DataArray* values = new DataArray();
+    const std::vector<int> numbers = {6, 1, 6, 5, 3, 2, 4, 1};
+    for(const int number : numbers) {
+        values->append(new DataValue(number));
+    }
+    DataMap collectionValues;
+    collectionValues.insert("values", values);
+    collectionValues.insert("test_output", new DataValue(""));
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-collection",
+                                      context,
+                                      collectionValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(result.size(), 1);
+
+    // test arithmetic expressions, which can not be calculated
+    DataMap numberValues;
+    numberValues.insert("number", new DataValue(42));
+    numberValues.insert("max", new DataValue(LONG_MAX));
+    numberValues.insert("min", new DataValue(LONG_MIN));
+    TEST_EQUAL(processExpressions(result, {{"[int]", "(number / 0)"}}, numberValues), false);
+    TEST_EQUAL(processExpressions(result, {{"[int]", "(number % 0)"}}, numberValues), false);
+    TEST_EQUAL(processExpressions(result, {{"[int]", "(max + 1)"}}, numberValues), false);
+    TEST_EQUAL(processExpressions(result, {{"[int]", "(min - 1)"}}, numberValues), false);
+    TEST_EQUAL(processExpressions(result, {{"[int]", "(max * 2)"}}, numberValues), false);
+    TEST_EQUAL(processExpressions(result, {{"[int]", "(min / -1)"}}, numberValues), false);
+    TEST_EQUAL(processExpressions(result,
+                                  {{"[int]", "(min % -1)"},
+                                   {"[int]", "(max - 1)"}},
+                                  numberValues), true);
+    if(result.size() == 2)
+    {
+        TEST_EQUAL(result.get("out_0")->toValue()->getLong(), 0);
+        TEST_EQUAL(result.get("out_1")->toValue()->getLong(), LONG_MAX - 1);
+    }
 }
 
+/**
+ * @brief Interface_Test::collectionFunctions_test
+ */
 void
-Interface_Test::invalidInputType_BlossomTest()
+Interface_Test::collectionFunctions_test()
 {
-    ErrorContainer error;
+    DataMap result;
     DataMap inputValues;
-    inputValues.insert("input", new DataValue(true));  // value should be int
-    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
-    DataMap context;
-    context.insert("test-key", new DataValue("asdf"));
+    DataArray* values = new DataArray();
+    values->append(new DataValue(3));
+    values->append(new DataValue(1));
+    values->append(new DataValue(2));
+    inputValues.insert("values", values);
+    DataArray* words = new DataArray();
+    words->append(new DataValue("b"));
+    words->append(new DataValue(""));
+    words->append(new DataValue("a"));
+    words->append(new DataValue(""));
+    inputValues.insert("words", words);
+    DataMap* object = new DataMap();
+    object->insert("a", new DataValue(1));
+    inputValues.insert("object", object);
 
-    DataMap result;
-    BlossomStatus status;
-    TEST_EQUAL(interface->triggerBlossom(result,
-                                         "standalone",
-                                         "-",
-                                         context,
-                                         inputValues,
-                                         status,
-                                         error), false);
-    TEST_EQUAL(status.statusCode, 400);
-    TEST_EQUAL(status.errorMessage, "Value-validation failed, because a item 'input'  "
-                                    "has the false type: Exprect int-type.");
+    // test chains of functions, which modify the value in-place
+    TEST_EQUAL(processExpressions(result,
+                                  {{"[array]", "values.append(4).append(5)"},
+                                   {"[map]", "object.insert(\"b\", 2)"},
+                                   {"[array]", "words.clear_empty()"},
+                                   {"[array]", "values.map(|x| x * 2)"},
+                                   {"[array]", "values.sort()"},
+                                   {"[array]", "words.clear_empty().sort()"},
+                                   {"[int]", "values.size()"},
+                                   {"[int]", "words.size()"},
+                                   {"[int]", "object.size()"}},
+                                  inputValues), true);
+    if(result.size() != 9) {
+        return;
+    }
+
+    DataArray* appended = result.get("out_0")->toArray();
+    TEST_EQUAL(appended->size(), 5);
+    TEST_EQUAL(appended->get(3)->toValue()->getInt(), 4);
+    TEST_EQUAL(appended->get(4)->toValue()->getInt(), 5);
+
+    DataMap* inserted = result.get("out_1")->toMap();
+    TEST_EQUAL(inserted->size(), 2);
+    TEST_EQUAL(inserted->get("b")->toValue()->getInt(), 2);
+
+    DataArray* cleared = result.get("out_2")->toArray();
+    TEST_EQUAL(cleared->size(), 2);
+    TEST_EQUAL(cleared->get(0)->toValue()->getString(), "b");
+    TEST_EQUAL(cleared->get(1)->toValue()->getString(), "a");
+
+    DataArray* mapped = result.get("out_3")->toArray();
+    TEST_EQUAL(mapped->size(), 3);
+    TEST_EQUAL(mapped->get(0)->toValue()->getInt(), 6);
+    TEST_EQUAL(mapped->get(1)->toValue()->getInt(), 2);
+    TEST_EQUAL(mapped->get(2)->toValue()->getInt(), 4);
+
+    DataArray* sorted = result.get("out_4")->toArray();
+    TEST_EQUAL(sorted->size(), 3);
+    TEST_EQUAL(sorted->get(0)->toValue()->getInt(), 1);
+    TEST_EQUAL(sorted->get(1)->toValue()->getInt(), 2);
+    TEST_EQUAL(sorted->get(2)->toValue()->getInt(), 3);
+
+    DataArray* sortedWords = result.get("out_5")->toArray();
+    TEST_EQUAL(sortedWords->size(), 2);
+    TEST_EQUAL(sortedWords->get(0)->toValue()->getString(), "a");
+    TEST_EQUAL(sortedWords->get(1)->toValue()->getString(), "b");
+
+    // the original values are not modified by the functions
+    TEST_EQUAL(result.get("out_6")->toValue()->getInt(), 3);
+    TEST_EQUAL(result.get("out_7")->toValue()->getInt(), 4);
+    TEST_EQUAL(result.get("out_8")->toValue()->getInt(), 1);
+
+    // test invalid input
+    TEST_EQUAL(processExpressions(result, {{"[array]", "object.append(1)"}}, inputValues), false);
+    TEST_EQUAL(processExpressions(result, {{"[array]", "values.clear_empty().insert(\"a\", 1)"}},
+                                  inputValues), false);
 }
 
+/**
+ * @brief Interface_Test::splitAndContains_test
+ */
 void
-Interface_Test::outofBorder_BlossomTest()
+Interface_Test::splitAndContains_test()
 {
-    ErrorContainer error;
+    DataMap result;
     DataMap inputValues;
-    inputValues.insert("input", new DataValue(142)); // value too high
-    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
-    DataMap context;
-    context.insert("test-key", new DataValue("asdf"));
+    inputValues.insert("text", new DataValue(",a,,b,"));
+    inputValues.insert("long_text", new DataValue("a::b::c::"));
+    inputValues.insert("empty", new DataValue(""));
+    DataArray* values = new DataArray();
+    values->append(new DataValue(1));
+    values->append(new DataValue(2));
+    values->append(new DataValue("poi"));
+    inputValues.insert("values", values);
+    DataMap* object = new DataMap();
+    object->insert("a", new DataValue(1));
+    inputValues.insert("object", object);
 
-    DataMap result;
-    BlossomStatus status;
-    TEST_EQUAL(interface->triggerBlossom(result,
-                                         "standalone",
-                                         "-",
-                                         context,
-                                         inputValues,
-                                         status,
-                                         error), false);
-    TEST_EQUAL(status.statusCode, 400);
-    TEST_EQUAL(status.errorMessage, "Given item 'input' is bigger than 100");
+    // test split with delimiters at the ends of the string
+    TEST_EQUAL(processExpressions(result,
+                                  {{"[array]", "text.split(\",\")"},
+                                   {"[array]", "long_text.split(\"::\")"},
+                                   {"[array]", "empty.split(\",\")"},
+                                   {"[array]", "text.split(\";\")"}},
+                                  inputValues), true);
+    if(result.size() == 4)
+    {
+        // a delimiter at the beginning creates an empty entry, but not a delimiter at the end
+        DataArray* parts = result.get("out_0")->toArray();
+        TEST_EQUAL(parts->size(), 4);
+        if(parts->size() == 4)
+        {
+            TEST_EQUAL(parts->get(0)->toValue()->getString(), "");
+            TEST_EQUAL(parts->get(1)->toValue()->getString(), "a");
+            TEST_EQUAL(parts->get(2)->toValue()->getString(), "");
+            TEST_EQUAL(parts->get(3)->toValue()->getString(), "b");
+        }
+
+        DataArray* longParts = result.get("out_1")->toArray();
+        TEST_EQUAL(longParts->size(), 3);
+        if(longParts->size() == 3) {
+            TEST_EQUAL(longParts->get(2)->toValue()->getString(), "c");
+        }
+
+        TEST_EQUAL(result.get("out_2")->toArray()->size(), 0);
+
+        DataArray* unsplitted = result.get("out_3")->toArray();
+        TEST_EQUAL(unsplitted->size(), 1);
+        if(unsplitted->size() == 1) {
+            TEST_EQUAL(unsplitted->get(0)->toValue()->getString(), ",a,,b,");
+        }
+    }
+
+    // test split with an empty delimiter
+    TEST_EQUAL(processExpressions(result, {{"[array]", "text.split(\"\")"}}, inputValues), false);
+
+    // test contains with existing and missing values
+    TEST_EQUAL(processExpressions(result,
+                                  {{"[bool]", "values.contains(2)"},
+                                   {"[bool]", "values.contains(\"poi\")"},
+                                   {"[bool]", "values.contains(3)"},
+                                   {"[bool]", "values.contains(\"\")"},
+                                   {"[bool]", "text.contains(\"a,,b\")"},
+                                   {"[bool]", "text.contains(\"c\")"},
+                                   {"[bool]", "object.contains(\"a\")"},
+                                   {"[bool]", "object.contains(\"b\")"}},
+                                  inputValues), true);
+    if(result.size() == 8)
+    {
+        TEST_EQUAL(result.get("out_0")->toValue()->getBool(), true);
+        TEST_EQUAL(result.get("out_1")->toValue()->getBool(), true);
+        TEST_EQUAL(result.get("out_2")->toValue()->getBool(), false);
+        TEST_EQUAL(result.get("out_3")->toValue()->getBool(), false);
+        TEST_EQUAL(result.get("out_4")->toValue()->getBool(), true);
+        TEST_EQUAL(result.get("out_5")->toValue()->getBool(), false);
+        TEST_EQUAL(result.get("out_6")->toValue()->getBool(), true);
+        TEST_EQUAL(result.get("out_7")->toValue()->getBool(), false);
+    }
 }
 
+/**
+ * @brief Interface_Test::containsIndex_test
+ */
 void
-Interface_Test::failWithin_BlossomTest()
+Interface_Test::containsIndex_test()
 {
     ErrorContainer error;
-    DataMap inputValues;
-    inputValues.insert("input", new DataValue(42));
     SakuraLangInterface* interface = SakuraLangInterface::getInstance();
     DataMap context;
-    context.insert("test-key", new DataValue("asdf"));
-
     DataMap result;
     BlossomStatus status;
 
-    // test fail within blossom
-    inputValues.insert("should_fail", new DataValue(true));
-    TEST_EQUAL(interface->triggerBlossom(result,
-                                         "standalone",
-                                         "-",
-                                         context,
+    TEST_EQUAL(interface->addTree("test-index", getTestIndexTree(), error), true);
+
+    DataArray* values = new DataArray();
+    values->append(new DataValue(1));
+    values->append(new DataValue(2.5));
+    values->append(new DataValue("3"));
+    values->append(new DataValue(9007199254740993l));
+    values->append(new DataValue(std::nan("")));
+
+    // keys with the expected result of the contains-function
+    DataArray* keys = new DataArray();
+    std::vector<bool> expected;
+    keys->append(new DataValue(1.0));
+    expected.push_back(true);
+    keys->append(new DataValue(2.5));
+    expected.push_back(true);
+    keys->append(new DataValue(3));
+    expected.push_back(true);
+    keys->append(new DataValue("1"));
+    expected.push_back(true);
+    keys->append(new DataValue(9007199254740992l));
+    expected.push_back(false);
+    keys->append(new DataValue(9007199254740992.0));
+    expected.push_back(true);
+    keys->append(new DataValue(std::nan("")));
+    expected.push_back(false);
+    keys->append(new DataValue(1e300));
+    expected.push_back(false);
+    keys->append(new DataValue(4));
+    expected.push_back(false);
+
+    // search all keys within a loop, which uses the index of the array
+    DataMap inputValues;
+    inputValues.insert("values", values);
+    inputValues.insert("keys", keys);
+    inputValues.insert("results", new DataArray());
+    TEST_EQUAL(interface->triggerTree(result, "test-index", context, inputValues, status, error),
+               true);
+    TEST_EQUAL(result.contains("results"), true);
+    if(result.contains("results") == false) {
+        return;
+    }
+    DataArray* indexedResults = result.get("results")->toArray();
+    TEST_EQUAL(indexedResults->size(), expected.size());
+    if(indexedResults->size() != expected.size()) {
+        return;
+    }
+
+    // the index gives the same result like the contains-function without index
+    for(uint32_t i = 0; i < expected.size(); i++)
+    {
+        DataMap searchValues;
+        searchValues.insert("values", values->copy());
+        searchValues.insert("key", keys->get(i)->copy());
+        TEST_EQUAL(processExpressions(result, {{"[bool]", "values.contains(key)"}}, searchValues),
+                   true);
+        if(result.contains("out_0")) {
+            TEST_EQUAL(result.get("out_0")->toValue()->getBool(), expected.at(i));
+        }
+        TEST_EQUAL(indexedResults->get(i)->toValue()->getBool(), expected.at(i));
+    }
+}
+
+/**
+ * @brief Interface_Test::typedArrayFunctions_test
+ */
+void
+Interface_Test::typedArrayFunctions_test()
+{
+    DataMap result;
+    DataMap inputValues;
+    DataArray* numbers = new DataArray();
+    numbers->append(new DataValue(9007199254740993l));
+    numbers->append(new DataValue(9007199254740992.0));
+    numbers->append(new DataValue(9007199254740992l));
+    numbers->append(new DataValue(1.5));
+    numbers->append(new DataValue(1));
+    inputValues.insert("numbers", numbers);
+    DataArray* ints = new DataArray();
+    ints->append(new DataValue(4));
+    ints->append(new DataValue(1));
+    ints->append(new DataValue(4));
+    ints->append(new DataValue(3));
+    inputValues.insert("ints", ints);
+    DataArray* floats = new DataArray();
+    floats->append(new DataValue(1));
+    floats->append(new DataValue(2.5));
+    inputValues.insert("floats", floats);
+    DataArray* words = new DataArray();
+    words->append(new DataValue("b"));
+    words->append(new DataValue("a"));
+    words->append(new DataValue("b"));
+    inputValues.insert("words", words);
+    DataArray* bools = new DataArray();
+    bools->append(new DataValue(true));
+    bools->append(new DataValue(false));
+    inputValues.insert("bools", bools);
+
+    TEST_EQUAL(processExpressions(result,
+                                  {{"[array]", "numbers.sort()"},
+                                   {"[array]", "ints.unique()"},
+                                   {"[array]", "words.unique().sort()"},
+                                   {"[array]", "bools.sort()"},
+                                   {"[int]", "ints.sum()"},
+                                   {"[float]", "floats.sum()"},
+                                   {"[int]", "ints.max()"},
+                                   {"[float]", "ints.avg()"},
+                                   {"[float]", "ints.percentile(50)"}},
+                                  inputValues), true);
+    if(result.size() != 9) {
+        return;
+    }
+
+    // int-values within mixed numbers are sorted without loss of precision and equal values
+    // keep their order
+    DataArray* sortedNumbers = result.get("out_0")->toArray();
+    TEST_EQUAL(sortedNumbers->size(), 5);
+    if(sortedNumbers->size() == 5)
+    {
+        TEST_EQUAL(sortedNumbers->get(0)->toValue()->getLong(), 1l);
+        TEST_EQUAL(sortedNumbers->get(1)->toValue()->getDouble(), 1.5);
+        TEST_EQUAL(sortedNumbers->get(2)->isFloatValue(), true);
+        TEST_EQUAL(sortedNumbers->get(3)->isIntValue(), true);
+        TEST_EQUAL(sortedNumbers->get(3)->toValue()->getLong(), 9007199254740992l);
+        TEST_EQUAL(sortedNumbers->get(4)->toValue()->getLong(), 9007199254740993l);
+    }
+
+    DataArray* uniqueInts = result.get("out_1")->toArray();
+    TEST_EQUAL(uniqueInts->size(), 3);
+    if(uniqueInts->size() == 3)
+    {
+        TEST_EQUAL(uniqueInts->get(0)->toValue()->getInt(), 4);
+        TEST_EQUAL(uniqueInts->get(1)->toValue()->getInt(), 1);
+        TEST_EQUAL(uniqueInts->get(2)->toValue()->getInt(), 3);
+    }
+
+    DataArray* uniqueWords = result.get("out_2")->toArray();
+    TEST_EQUAL(uniqueWords->size(), 2);
+    if(uniqueWords->size() == 2)
+    {
+        TEST_EQUAL(uniqueWords->get(0)->toValue()->getString(), "a");
+        TEST_EQUAL(uniqueWords->get(1)->toValue()->getString(), "b");
+    }
+
+    DataArray* sortedBools = result.get("out_3")->toArray();
+    TEST_EQUAL(sortedBools->size(), 2);
+    if(sortedBools->size() == 2) {
+        TEST_EQUAL(sortedBools->get(0)->toValue()->getBool(), false);
+    }
+
+    TEST_EQUAL(result.get("out_4")->toValue()->getInt(), 12);
+    TEST_EQUAL(result.get("out_5")->toValue()->getDouble(), 3.5);
+    TEST_EQUAL(result.get("out_6")->toValue()->getInt(), 4);
+    TEST_EQUAL(result.get("out_7")->toValue()->getDouble(), 3.0);
+    TEST_EQUAL(result.get("out_8")->toValue()->getDouble(), 3.5);
+
+    // test aggregation of values, which are not numbers
+    TEST_EQUAL(processExpressions(result, {{"[int]", "words.sum()"}}, inputValues), false);
+    TEST_EQUAL(processExpressions(result, {{"[array]", "words.zip(bools).sort()"}}, inputValues),
+               false);
+}
+
+/**
+ * @brief Interface_Test::fileFunctions_test
+ */
+void
+Interface_Test::fileFunctions_test()
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    DataMap result;
+    BlossomStatus status;
+
+    TEST_EQUAL(interface->addFile("test-lines", getTestTextFile("a\nbb\n\nccc\n")), true);
+    TEST_EQUAL(interface->addFile("test-chunks", getTestTextFile("abcdefghij")), true);
+
+    DataMap inputValues;
+    inputValues.insert("lines_file", new DataValue("test-lines"));
+    inputValues.insert("chunks_file", new DataValue("test-chunks"));
+    inputValues.insert("missing_file", new DataValue("missing"));
+    inputValues.insert("text", new DataValue(",a,,b,"));
+
+    // test the functions on files
+    TEST_EQUAL(processExpressions(result,
+                                  {{"[array]", "lines_file.file_lines()"},
+                                   {"[array]", "chunks_file.file_chunks(4)"},
+                                   {"[array]", "chunks_file.file_chunks(20)"}},
+                                  inputValues), true);
+    if(result.size() == 3)
+    {
+        DataArray* lines = result.get("out_0")->toArray();
+        TEST_EQUAL(lines->size(), 4);
+        if(lines->size() == 4)
+        {
+            TEST_EQUAL(lines->get(0)->toValue()->getString(), "a");
+            TEST_EQUAL(lines->get(1)->toValue()->getString(), "bb");
+            TEST_EQUAL(lines->get(2)->toValue()->getString(), "");
+            TEST_EQUAL(lines->get(3)->toValue()->getString(), "ccc");
+        }
+
+        DataArray* chunks = result.get("out_1")->toArray();
+        TEST_EQUAL(chunks->size(), 3);
+        if(chunks->size() == 3)
+        {
+            TEST_EQUAL(chunks->get(0)->toValue()->getString(), "abcd");
+            TEST_EQUAL(chunks->get(1)->toValue()->getString(), "efgh");
+            TEST_EQUAL(chunks->get(2)->toValue()->getString(), "ij");
+        }
+
+        TEST_EQUAL(result.get("out_2")->toArray()->size(), 1);
+    }
+
+    // test invalid files and chunk-sizes
+    TEST_EQUAL(processExpressions(result, {{"[array]", "missing_file.file_lines()"}}, inputValues),
+               false);
+    TEST_EQUAL(processExpressions(result, {{"[array]", "chunks_file.file_chunks(0)"}}, inputValues),
+               false);
+
+    // test the same functions as source of loops, which iterate without creating the array
+    TEST_EQUAL(interface->addTree("test-file-loop", getTestFileLoopTree(), error), true);
+    inputValues.insert("lines", new DataArray());
+    inputValues.insert("chunks", new DataArray());
+    inputValues.insert("parts", new DataArray());
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-file-loop",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), true);
+    if(result.size() != 3) {
+        return;
+    }
+
+    DataArray* lines = result.get("lines")->toArray();
+    TEST_EQUAL(lines->size(), 4);
+    if(lines->size() == 4)
+    {
+        TEST_EQUAL(lines->get(2)->toValue()->getString(), "");
+        TEST_EQUAL(lines->get(3)->toValue()->getString(), "ccc");
+    }
+
+    DataArray* chunks = result.get("chunks")->toArray();
+    TEST_EQUAL(chunks->size(), 3);
+    if(chunks->size() == 3) {
+        TEST_EQUAL(chunks->get(2)->toValue()->getString(), "ij");
+    }
+
+    DataArray* parts = result.get("parts")->toArray();
+    TEST_EQUAL(parts->size(), 4);
+    if(parts->size() == 4)
+    {
+        TEST_EQUAL(parts->get(0)->toValue()->getString(), "");
+        TEST_EQUAL(parts->get(1)->toValue()->getString(), "a");
+        TEST_EQUAL(parts->get(3)->toValue()->getString(), "b");
+    }
+
+    // test loop over a missing file
+    inputValues.insert("lines_file", new DataValue("missing"), true);
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-file-loop",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), false);
+}
+
+/**
+ * @brief Interface_Test::jsonFunctions_test
+ */
+void
+Interface_Test::jsonFunctions_test()
+{
+    DataMap result;
+    DataMap inputValues;
+    const std::string json = "{\"a\": 1, \"skip\": {\"x\": [\"}]\", {\"y\": 2}]},"
+                             " \"b\": [true, 2.5, \"c\"], \"big\": 12345678901234567890}";
+    const std::string escaped = "{\"text\": \"a\\\"b\\\\c\\n\\u00e9\\ud83d\\ude00\"}";
+    inputValues.insert("json", new DataValue(json));
+    inputValues.insert("escaped", new DataValue(escaped));
+    inputValues.insert("truncated_path", new DataValue("{\"a\": 1, \"b\": "));
+
+    // test valid documents with the complete parser and with paths
+    TEST_EQUAL(processExpressions(result,
+                                  {{"[map]", "json.parse_json()"},
+                                   {"[int]", "json.parse_json().get(\"a\")"},
+                                   {"[str]", "json.parse_json().get(\"b\").get(2)"},
+                                   {"[float]", "json.parse_json().get(\"big\")"},
+                                   {"[map]", "escaped.parse_json()"},
+                                   {"[str]", "escaped.parse_json().get(\"text\")"},
+                                   {"[int]", "truncated_path.parse_json().get(\"a\")"}},
+                                  inputValues), true);
+    if(result.size() == 7)
+    {
+        DataMap* parsed = result.get("out_0")->toMap();
+        TEST_EQUAL(parsed->size(), 4);
+        TEST_EQUAL(parsed->contains("skip"), true);
+        if(parsed->contains("b"))
+        {
+            DataArray* array = parsed->get("b")->toArray();
+            TEST_EQUAL(array->size(), 3);
+            if(array->size() == 3)
+            {
+                TEST_EQUAL(array->get(0)->toValue()->getBool(), true);
+                TEST_EQUAL(array->get(1)->toValue()->getDouble(), 2.5);
+            }
+        }
+
+        // values behind skipped nested content are found by the path
+        TEST_EQUAL(result.get("out_1")->toValue()->getInt(), 1);
+        TEST_EQUAL(result.get("out_2")->toValue()->getString(), "c");
+        TEST_EQUAL(result.get("out_3")->isFloatValue(), true);
+
+        // escape-sequences and unicode are converted in both ways of parsing
+        const std::string expectedText = "a\"b\\c\n\xc3\xa9\xf0\x9f\x98\x80";
+        DataMap* escapedMap = result.get("out_4")->toMap();
+        if(escapedMap->contains("text")) {
+            TEST_EQUAL(escapedMap->get("text")->toValue()->getString(), expectedText);
+        }
+        TEST_EQUAL(result.get("out_5")->toValue()->getString(), expectedText);
+
+        // the content behind the requested value of a path is not checked
+        TEST_EQUAL(result.get("out_6")->toValue()->getInt(), 1);
+    }
+
+    // test paths, which don't exist
+    TEST_EQUAL(processExpressions(result, {{"[int]", "json.parse_json().get(\"missing\")"}},
+                                  inputValues), false);
+    TEST_EQUAL(processExpressions(result, {{"[str]", "json.parse_json().get(\"b\").get(3)"}},
+                                  inputValues), false);
+    TEST_EQUAL(processExpressions(result, {{"[int]", "json.parse_json().get(\"a\").get(0)"}},
+                                  inputValues), false);
+
+    // test malformed and truncated documents
+    const std::vector<std::string> invalidDocuments = {"{\"a\": 1,}",
+                                                       "{\"a\" 1}",
+                                                       "[1, 2] x",
+                                                       "tru",
+                                                       "{\"a\": [1, 2",
+                                                       "\"abc",
+                                                       "\"a\\x\"",
+                                                       "\"\\u12\"",
+                                                       "\"\\ud83d\"",
+                                                       ""};
+    for(const std::string &document : invalidDocuments)
+    {
+        DataMap invalidValues;
+        invalidValues.insert("json", new DataValue(document));
+        TEST_EQUAL(processExpressions(result, {{"[map]", "json.parse_json()"}}, invalidValues),
+                   false);
+        TEST_EQUAL(processExpressions(result, {{"[int]", "json.parse_json().get(\"b\")"}},
+                                      invalidValues), false);
+    }
+}
+
+/**
+ * @brief Interface_Test::loops_test
+ */
+void
+Interface_Test::loops_test()
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+    DataMap result;
+    BlossomStatus status;
+
+    TEST_EQUAL(interface->addValueFunction("count_call", countCall), true);
+    TEST_EQUAL(interface->addTree("test-loop", getTestLoopTree(), error), true);
+
+    // loops, which don't run, don't evaluate their values
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("count", new DataValue(0));
+    inputValues.insert("values", new DataArray());
+    inputValues.insert("test_output", new DataValue(0));
+    numberOfCountedCalls = 0;
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result, "test-loop", context, inputValues, status, error),
+               true);
+    TEST_EQUAL(numberOfCountedCalls, 0);
+    TEST_EQUAL(m_counter.calls, 0);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 0);
+
+    // values of loops with a single iteration are not hoisted
+    inputValues.insert("count", new DataValue(1), true);
+    numberOfCountedCalls = 0;
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result, "test-loop", context, inputValues, status, error),
+               true);
+    TEST_EQUAL(numberOfCountedCalls, 1);
+    TEST_EQUAL(m_counter.calls, 1);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    // hoisted values are evaluated only once, but give the same result
+    DataArray* values = new DataArray();
+    values->append(new DataValue(1));
+    values->append(new DataValue(2));
+    values->append(new DataValue(3));
+    inputValues.insert("values", values, true);
+    inputValues.insert("count", new DataValue(3), true);
+    numberOfCountedCalls = 0;
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result, "test-loop", context, inputValues, status, error),
+               true);
+    TEST_EQUAL(numberOfCountedCalls, 2);
+    TEST_EQUAL(m_counter.calls, 6);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+}
+
+/**
+ * @brief Interface_Test::blossomOutputs_test
+ */
+void
+Interface_Test::blossomOutputs_test()
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    DataMap result;
+    BlossomStatus status;
+
+    // declared outputs, which are not provided by the blossom, are an error
+    TEST_EQUAL(interface->addTree("test-missing-output", getTestMissingOutputTree(), error), true);
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(0));
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-missing-output",
+                                      context,
+                                      inputValues,
+                                      status,
+                                      error), false);
+    const bool hasMessage = error.toString().find("blossom doesn't have all declared "
+                                                  "output-values") != std::string::npos;
+    TEST_EQUAL(hasMessage, true);
+
+    // the first loop is processed in batches and its outputs are written back in order, while
+    // the second loop reads a value, which is written within the loop
+    TEST_EQUAL(interface->addTree("test-batch", getTestBatchTree(), error), true);
+    DataArray* values = new DataArray();
+    for(long i = 1; i <= 10; i++) {
+        values->append(new DataValue(i));
+    }
+    DataMap batchValues;
+    batchValues.insert("values", values);
+    batchValues.insert("last", new DataValue(0));
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result, "test-batch", context, batchValues, status, error),
+               true);
+    TEST_EQUAL(m_counter.calls, 20);
+    TEST_EQUAL(m_counter.batches, 3);
+    TEST_EQUAL(m_counter.sum, 155);
+    if(result.contains("last")) {
+        TEST_EQUAL(result.get("last")->toValue()->getInt(), 10);
+    }
+}
+
+/**
+ * @brief Interface_Test::parallelTemplates_test
+ */
+void
+Interface_Test::parallelTemplates_test()
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+    DataMap result;
+    BlossomStatus status;
+
+    const uint32_t numberOfParts = 8;
+    TEST_EQUAL(interface->addTree("test-parallel-template",
+                                  getTestParallelTemplateTree(numberOfParts),
+                                  error), true);
+
+    DataMap inputValues;
+    inputValues.insert("name", new DataValue("poi"));
+    for(uint32_t i = 0; i < numberOfParts; i++) {
+        inputValues.insert("out_" + std::to_string(i), new DataValue(""));
+    }
+
+    // render the templates of all parts and iterations at the same time multiple times
+    for(uint32_t run = 0; run < 10; run++)
+    {
+        TEST_EQUAL(interface->triggerTree(result,
+                                          "test-parallel-template",
+                                          context,
+                                          inputValues,
+                                          status,
+                                          error), true);
+        for(uint32_t i = 0; i < numberOfParts; i++)
+        {
+            const std::string key = "out_" + std::to_string(i);
+            TEST_EQUAL(result.contains(key), true);
+            if(result.contains(key)) {
+                TEST_EQUAL(result.get(key)->toValue()->getString(), "poi-" + std::to_string(i));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Interface_Test::asyncBlossoms_test
+ */
+void
+Interface_Test::asyncBlossoms_test()
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+    DataMap result;
+    BlossomStatus status;
+
+    TEST_EQUAL(interface->addTree("test-async", getTestAsyncTree(), error), true);
+
+    DataArray* values = new DataArray();
+    for(long i = 1; i <= 16; i++) {
+        values->append(new DataValue(i));
+    }
+    DataMap inputValues;
+    inputValues.insert("values", values);
+    inputValues.insert("fail", new DataValue(false));
+
+    // the tasks of the loop run at the same time, while their plans are parked, so there are
+    // more running tasks than worker-threads, but no additional threads are created for this
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result, "test-async", context, inputValues, status, error),
+               true);
+    TEST_EQUAL(m_counter.asyncTasks, 16);
+    TEST_EQUAL(m_counter.calls, 16);
+    TEST_EQUAL(m_counter.sum, 136);
+    const bool moreTasksThanThreads = m_counter.maxActive > 2;
+    TEST_EQUAL(moreTasksThanThreads, true);
+    const bool onlyWorkerThreads = m_counter.taskThreads.size() <= 2;
+    TEST_EQUAL(onlyWorkerThreads, true);
+
+    // identical cached subtree-calls of the loop are coalesced into one call, also if the
+    // waiting plans are parked on the same worker-thread as the plan, which leads the call
+    TEST_EQUAL(interface->addTree("async-child", getTestAsyncChildTree(), error), true);
+    TEST_EQUAL(interface->addTree("test-async-cached",
+                                  getTestAsyncCachedTree("test-async-cached", "cached"),
+                                  error), true);
+    TEST_EQUAL(interface->linkTrees(error), true);
+
+    DataArray* sameValues = new DataArray();
+    for(uint32_t i = 0; i < 8; i++) {
+        sameValues->append(new DataValue(42));
+    }
+    DataMap cachedInputValues;
+    cachedInputValues.insert("values", sameValues);
+
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-async-cached",
+                                      context,
+                                      cachedInputValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(m_counter.asyncTasks, 1);
+    TEST_EQUAL(m_counter.calls, 1);
+
+    // the same for calls with time-to-live, where the result is also reused in the next run
+    // and the waiting plans don't need additional threads
+    TEST_EQUAL(interface->addTree("test-async-cached-ttl",
+                                  getTestAsyncCachedTree("test-async-cached-ttl", "cached(60)"),
+                                  error), true);
+    TEST_EQUAL(interface->linkTrees(error), true);
+
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-async-cached-ttl",
+                                      context,
+                                      cachedInputValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(m_counter.calls, 1);
+    const bool onlyWorkerThreadsForCalls = m_counter.taskThreads.size() <= 2;
+    TEST_EQUAL(onlyWorkerThreadsForCalls, true);
+
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result,
+                                      "test-async-cached-ttl",
+                                      context,
+                                      cachedInputValues,
+                                      status,
+                                      error), true);
+    TEST_EQUAL(m_counter.calls, 0);
+
+    // a task, which finishs with an error, let the tree fail
+    inputValues.insert("fail", new DataValue(true), true);
+    TEST_EQUAL(interface->triggerTree(result, "test-async", context, inputValues, status, error),
+               false);
+
+    // without worker-thread the caller waits for the task
+    DataMap blossomInput;
+    blossomInput.insert("input", new DataValue(42));
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerBlossom(result,
+                                         "async",
+                                         "test1",
+                                         context,
+                                         blossomInput,
+                                         status,
+                                         error), true);
+    TEST_EQUAL(m_counter.asyncTasks, 1);
+    TEST_EQUAL(result.get("output")->toValue()->getInt(), 42);
+}
+
+/**
+ * @brief Interface_Test::concurrencyLimits_test
+ */
+void
+Interface_Test::concurrencyLimits_test()
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+    DataMap result;
+    BlossomStatus status;
+
+    CountingBlossom* limitedBlossom = new CountingBlossom(&m_counter, 0, true);
+    TEST_EQUAL(interface->addBlossom("test1", "limited_count", limitedBlossom, 2), true);
+    TEST_EQUAL(interface->addTree("test-limit", getTestLimitTree(), error), true);
+    TEST_EQUAL(interface->addTree("test-window", getTestWindowTree(), error), true);
+
+    DataArray* values = new DataArray();
+    for(long i = 1; i <= 16; i++) {
+        values->append(new DataValue(i));
+    }
+    DataMap inputValues;
+    inputValues.insert("values", values);
+
+    // the loop is wider than the limit of the asynchronous blossom, so the limit has to hold
+    // back the tasks
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result, "test-limit", context, inputValues, status, error),
+               true);
+    TEST_EQUAL(m_counter.calls, 16);
+    TEST_EQUAL(m_counter.sum, 136);
+    const bool inLimit = m_counter.maxActive > 0 && m_counter.maxActive <= 2;
+    TEST_EQUAL(inLimit, true);
+
+    // the plans, which wait for a slot, are parked, so the worker-threads start the next
+    // iterations and no additional threads are created for the waiting plans
+    const bool onlyWorkerThreads = m_counter.taskThreads.size() <= 2;
+    TEST_EQUAL(onlyWorkerThreads, true);
+
+    // the width of the loop limits the number of iterations, which run at the same time
+    m_counter.reset();
+    TEST_EQUAL(interface->triggerTree(result, "test-window", context, inputValues, status, error),
+               true);
+    TEST_EQUAL(m_counter.calls, 16);
+    TEST_EQUAL(m_counter.sum, 136);
+    const bool inWidth = m_counter.maxActive > 0 && m_counter.maxActive <= 3;
+    TEST_EQUAL(inWidth, true);
+}
+
+/**
+ * @brief Interface_Test::resultCache_test
+ */
+void
+Interface_Test::resultCache_test()
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+    DataMap result;
+    BlossomStatus status;
+
+    CountingBlossom* cachedBlossom = new CountingBlossom(&m_counter, 0, false, 2, true);
+    TEST_EQUAL(interface->addBlossom("test1", "cached", cachedBlossom), true);
+
+    // a cache, which is smaller than the number of shards, holds not more than its size
+    m_counter.reset();
+    for(long i = 1; i <= 3; i++)
+    {
+        DataMap inputValues;
+        inputValues.insert("input", new DataValue(i));
+        TEST_EQUAL(interface->triggerBlossom(result,
+                                             "cached",
+                                             "test1",
+                                             context,
+                                             inputValues,
+                                             status,
+                                             error), true);
+    }
+
+    CacheStatistics statistics;
+    TEST_EQUAL(interface->getBlossomCacheStatistics(statistics, "test1", "cached"), true);
+    TEST_EQUAL(statistics.misses, 3);
+    const bool inCacheSize = statistics.numberOfEntries <= 2;
+    TEST_EQUAL(inCacheSize, true);
+    TEST_EQUAL(statistics.numberOfEntries + statistics.evictions, 3);
+    TEST_EQUAL(m_counter.calls, 3);
+
+    // the last input is still cached
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(3));
+    TEST_EQUAL(interface->triggerBlossom(result,
+                                         "cached",
+                                         "test1",
+                                         context,
+                                         inputValues,
+                                         status,
+                                         error), true);
+    TEST_EQUAL(interface->getBlossomCacheStatistics(statistics, "test1", "cached"), true);
+    TEST_EQUAL(statistics.hits, 1);
+    TEST_EQUAL(m_counter.calls, 3);
+    TEST_EQUAL(result.get("output")->toValue()->getInt(), 3);
+}
+
+/**
+ * @brief Interface_Test::workerBlossoms_test
+ */
+void
+Interface_Test::workerBlossoms_test()
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+    DataMap result;
+    BlossomStatus status;
+
+    BlossomFactory factory = [this]() { return new CountingBlossom(&m_workerCounter); };
+    TEST_EQUAL(interface->addBlossomFactory("test1", "worker", factory), true);
+    TEST_EQUAL(interface->addTree("test-worker", getTestWorkerTree(), error), true);
+
+    DataArray* values = new DataArray();
+    for(long i = 0; i < 16; i++) {
+        values->append(new DataValue(i));
+    }
+    DataMap inputValues;
+    inputValues.insert("values", values);
+
+    // each worker-thread creates its own instance at the first call and starts it only once
+    m_workerCounter.reset();
+    for(uint32_t run = 0; run < 4; run++)
+    {
+        TEST_EQUAL(interface->triggerTree(result,
+                                          "test-worker",
+                                          context,
+                                          inputValues,
+                                          status,
+                                          error), true);
+    }
+    TEST_EQUAL(m_workerCounter.calls, 64);
+    const bool hasWorkerInstances = m_workerCounter.instances > 0;
+    TEST_EQUAL(hasWorkerInstances, true);
+    TEST_EQUAL(m_workerCounter.workerStarts, m_workerCounter.instances);
+    TEST_EQUAL(m_workerCounter.workerStops, 0);
+
+    // stopping the worker-threads stops each instance of a worker once
+    delete interface;
+    TEST_EQUAL(m_workerCounter.workerStops, m_workerCounter.workerStarts);
+    TEST_EQUAL(m_workerCounter.invalidHooks, 0);
+}
+
+void
+Interface_Test::positive_BlossomTest()
+{
+    ErrorContainer error;
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+
+    DataMap result;
+    BlossomStatus status;
+    TEST_EQUAL(interface->triggerBlossom(result,
+                                         "standalone",
+                                         "-",
+                                         context,
+                                         inputValues,
+                                         status,
+                                         error), true);
+    TEST_EQUAL(status.statusCode, 0);
+    TEST_EQUAL(status.errorMessage, "");
+    TEST_EQUAL(result.get("output")->toValue()->getInt(), 42);
+}
+
+void
+Interface_Test::nonExisting_BlossomTest()
+{
+    ErrorContainer error;
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+
+    DataMap result;
+    BlossomStatus status;
+    TEST_EQUAL(interface->triggerBlossom(result,
+                                         "fail",
+                                         "-",
+                                         context,
+                                         inputValues,
+                                         status,
+                                         error), false);
+    TEST_EQUAL(status.statusCode, 0);
+    TEST_EQUAL(status.errorMessage, "");
+}
+
+void
+Interface_Test::invalidInputValues_BlossomTest()
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+    DataMap falseMap;
+
+    DataMap result;
+    BlossomStatus status;
+    TEST_EQUAL(interface->triggerBlossom(result,
+                                         "standalone",
+                                         "-",
+                                         context,
+                                         falseMap,
+                                         status,
+                                         error), false);
+    TEST_EQUAL(status.statusCode, 400);
+    TEST_EQUAL(status.errorMessage, "Validation failed, because variable 'input' "
+                                    "is required, but is not set.");
+}
+
+void
+Interface_Test::invalidInputType_BlossomTest()
+{
+    ErrorContainer error;
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(true));  // value should be int
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+
+    DataMap result;
+    BlossomStatus status;
+    TEST_EQUAL(interface->triggerBlossom(result,
+                                         "standalone",
+                                         "-",
+                                         context,
+                                         inputValues,
+                                         status,
+                                         error), false);
+    TEST_EQUAL(status.statusCode, 400);
+    TEST_EQUAL(status.errorMessage, "Value-validation failed, because a item 'input'  "
+                                    "has the false type: Exprect int-type.");
+}
+
+void
+Interface_Test::outofBorder_BlossomTest()
+{
+    ErrorContainer error;
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(142)); // value too high
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+
+    DataMap result;
+    BlossomStatus status;
+    TEST_EQUAL(interface->triggerBlossom(result,
+                                         "standalone",
+                                         "-",
+                                         context,
+                                         inputValues,
+                                         status,
+                                         error), false);
+    TEST_EQUAL(status.statusCode, 400);
+    TEST_EQUAL(status.errorMessage, "Given item 'input' is bigger than 100");
+}
+
+void
+Interface_Test::failWithin_BlossomTest()
+{
+    ErrorContainer error;
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    context.insert("test-key", new DataValue("asdf"));
+
+    DataMap result;
+    BlossomStatus status;
+
+    // test fail within blossom
+    inputValues.insert("should_fail", new DataValue(true));
+    TEST_EQUAL(interface->triggerBlossom(result,
+                                         "standalone",
+                                         "-",
+                                         context,
                                          inputValues,
                                          status,
                                          error), false);
@@ -370,65 +1744,624 @@ Interface_Test::failWithin_BlossomTest()
             "+---------------------+---------------------+\n";
     TEST_EQUAL(status.errorMessage, expectedStatus);
 
-    const std::string expectedError =
-            "+---------------------+------------------------------------------+\n"
-            "| Error-Message Nr. 2 | trigger blossom failed.                  |\n"
-            "+---------------------+------------------------------------------+\n"
-            "| Error-Message Nr. 1 | Error in location:                       |\n"
-            "|                     | +--------------------+-----------------+ |\n"
-            "|                     | | location           | blossom execute | |\n"
-            "|                     | +--------------------+-----------------+ |\n"
-            "|                     | | blossom-group-type | -               | |\n"
-            "|                     | +--------------------+-----------------+ |\n"
-            "|                     | | blossom-name       | standalone      | |\n"
-            "|                     | +--------------------+-----------------+ |\n"
-            "|                     | | blossom-file-path  | standalone      | |\n"
-            "|                     | +--------------------+-----------------+ |\n"
-            "+---------------------+------------------------------------------+\n"
-            "| Error-Message Nr. 0 | successfully failed                      |\n"
-            "+---------------------+------------------------------------------+\n";
-    TEST_EQUAL(error.toString(), expectedError);
+    const std::string expectedError =
+            "+---------------------+------------------------------------------+\n"
+            "| Error-Message Nr. 2 | trigger blossom failed.                  |\n"
+            "+---------------------+------------------------------------------+\n"
+            "| Error-Message Nr. 1 | Error in location:                       |\n"
+            "|                     | +--------------------+-----------------+ |\n"
+            "|                     | | location           | blossom execute | |\n"
+            "|                     | +--------------------+-----------------+ |\n"
+            "|                     | | blossom-group-type | -               | |\n"
+            "|                     | +--------------------+-----------------+ |\n"
+            "|                     | | blossom-name       | standalone      | |\n"
+            "|                     | +--------------------+-----------------+ |\n"
+            "|                     | | blossom-file-path  | standalone      | |\n"
+            "|                     | +--------------------+-----------------+ |\n"
+            "+---------------------+------------------------------------------+\n"
+            "| Error-Message Nr. 0 | successfully failed                      |\n"
+            "+---------------------+------------------------------------------+\n";
+    TEST_EQUAL(error.toString(), expectedError);
+}
+
+/**
+ * @brief runAndTriggerBlossom_test
+ */
+void
+Interface_Test::runAndTriggerBlossom_test()
+{
+    positive_BlossomTest();
+    nonExisting_BlossomTest();
+    outofBorder_BlossomTest();
+    invalidInputValues_BlossomTest();
+    invalidInputType_BlossomTest();
+    failWithin_BlossomTest();
+}
+
+/**
+ * @brief Session_Test::getTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestTree()
+{
+    const std::string tree = "[\"test\"]\n"
+                             "(\"tree-comment\")\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "  (\"test-comment1\")\n"
+                             "- should_fail = false\n"
+                             "  (\"test-comment2\")\n"
+                             "- test_output = >> [int]\n"
+                             "  (\"test-comment3\")\n"
+                             "\n"
+                             "test1(\"this is a test\")\n"
+                             "->test2:\n"
+                             "   - input = input\n"
+                             "   - should_fail = should_fail\n"
+                             "   - output >> test_output\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestCachedTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestCachedTree()
+{
+    const std::string tree = "[\"test-cached\"]<cache(10, \"test-key\")>\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "- should_fail = false\n"
+                             "- test_output = >> [int]\n"
+                             "\n"
+                             "test1(\"this is a test\")\n"
+                             "->test2:\n"
+                             "   - input = input\n"
+                             "   - should_fail = should_fail\n"
+                             "   - output >> test_output\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestParentTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestParentTree()
+{
+    const std::string tree = "[\"link-parent\"]\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "- test_output = >> [int]\n"
+                             "\n"
+                             "subtree(\"link-child\")\n"
+                             "- input = input\n"
+                             "- test_output = test_output\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestCachedSubtreeTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestCachedSubtreeTree()
+{
+    const std::string tree = "[\"link-cached\"]\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "- test_output = >> [int]\n"
+                             "\n"
+                             "subtree<cached>(\"count-child\")\n"
+                             "- input = input\n"
+                             "- test_output = test_output\n"
+                             "\n"
+                             "subtree<cached>(\"count-child\")\n"
+                             "- input = input\n"
+                             "- test_output = test_output\n"
+                             "\n"
+                             "subtree<cached(60)>(\"count-child\")\n"
+                             "- input = input\n"
+                             "- test_output = test_output\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestIncrementalTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestIncrementalTree()
+{
+    const std::string tree = "[\"test-incremental\"]\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "- offset = 0\n"
+                             "- pure_output = >> [int]\n"
+                             "- count_output = >> [int]\n"
+                             "\n"
+                             "test1(\"pure\")\n"
+                             "->pure:\n"
+                             "   - input = (input + offset)\n"
+                             "   - output >> pure_output\n"
+                             "\n"
+                             "test1(\"count\")\n"
+                             "->count:\n"
+                             "   - input = input\n"
+                             "   - output >> count_output\n";
+    return tree;
 }
 
 /**
- * @brief runAndTriggerBlossom_test
+ * @brief Interface_Test::getTestCountTree
+ * @return
  */
-void
-Interface_Test::runAndTriggerBlossom_test()
+const std::string
+Interface_Test::getTestCountTree()
 {
-    positive_BlossomTest();
-    nonExisting_BlossomTest();
-    outofBorder_BlossomTest();
-    invalidInputValues_BlossomTest();
-    invalidInputType_BlossomTest();
-    failWithin_BlossomTest();
+    const std::string tree = "[\"count-child\"]\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "- test_output = >> [int]\n"
+                             "\n"
+                             "test1(\"count\")\n"
+                             "->count:\n"
+                             "   - input = input\n"
+                             "   - output >> test_output\n";
+    return tree;
 }
 
 /**
- * @brief Session_Test::getTestTree
+ * @brief Interface_Test::getTestConditionTree
  * @return
  */
 const std::string
-Interface_Test::getTestTree()
+Interface_Test::getTestConditionTree()
 {
-    const std::string tree = "[\"test\"]\n"
-                             "(\"tree-comment\")\n"
+    const std::string tree = "[\"test-condition\"]\n"
                              "\n"
                              "- input = ?[int]\n"
-                             "  (\"test-comment1\")\n"
                              "- should_fail = false\n"
-                             "  (\"test-comment2\")\n"
                              "- test_output = >> [int]\n"
-                             "  (\"test-comment3\")\n"
+                             "\n"
+                             "if(input > 10 && (input <= 42 || should_fail) && !should_fail) {\n"
+                             "    test1(\"this is a test\")\n"
+                             "    ->test2:\n"
+                             "       - input = (input * 2 - 42)\n"
+                             "       - output >> test_output\n"
+                             "} else {\n"
+                             "    test1(\"this is a test\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - should_fail = true\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestFunctionTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestFunctionTree(const std::string &functionName)
+{
+    const std::string tree = "[\"test-function\"]\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "- test_output = >> [int]\n"
                              "\n"
                              "test1(\"this is a test\")\n"
                              "->test2:\n"
-                             "   - input = input\n"
-                             "   - should_fail = should_fail\n"
+                             "   - input = input." + functionName + "()\n"
                              "   - output >> test_output\n";
     return tree;
 }
 
+/**
+ * @brief Interface_Test::getTestCollectionTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestCollectionTree()
+{
+    const std::string tree = "[\"test-collection\"]\n"
+                             "\n"
+                             "- values = ?[array]\n"
+                             "- test_output = >> [int]\n"
+                             "\n"
+                             "test1(\"this is a test\")\n"
+                             "->test2:\n"
+                             "   - input = values.zip(values).flatten().unique().sort()"
+                             ".filter(|x| x % 2 == 0)"
+                             ".map(|x| x * 3 + 2)"
+                             ".reduce(|sum, x| sum + x, 0)\n"
+                             "   - output >> test_output\n"
+                             "\n"
+                             "test1(\"this is an aggregation\")\n"
+                             "->test2:\n"
+                             "   - input = (values.sum() + values.skip(2).take(2).max()"
+                             " + values.count_if(|x| x == 1) * 4)\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestLoopTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestLoopTree()
+{
+    const std::string tree = "[\"test-loop\"]\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "- count = ?[int]\n"
+                             "- values = ?[array]\n"
+                             "- test_output = >> [int]\n"
+                             "\n"
+                             "for(i = 0; i < count; i++) {\n"
+                             "    test1(\"for\")\n"
+                             "    ->count:\n"
+                             "       - input = input.count_call()\n"
+                             "       - output >> test_output\n"
+                             "}\n"
+                             "\n"
+                             "for(x : values) {\n"
+                             "    test1(\"for-each\")\n"
+                             "    ->count:\n"
+                             "       - input = input.count_call()\n"
+                             "       - output >> test_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestIndexTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestIndexTree()
+{
+    const std::string tree = "[\"test-index\"]\n"
+                             "\n"
+                             "- values = ?[array]\n"
+                             "- keys = ?[array]\n"
+                             "- found = false\n"
+                             "- results = >> [array]\n"
+                             "\n"
+                             "for(x : keys) {\n"
+                             "    test1(\"search\")\n"
+                             "    ->count:\n"
+                             "       - input = values.contains(x)\n"
+                             "       - output >> found\n"
+                             "\n"
+                             "    test1(\"collect\")\n"
+                             "    ->count:\n"
+                             "       - input = results.append(found)\n"
+                             "       - output >> results\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestFileLoopTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestFileLoopTree()
+{
+    const std::string tree = "[\"test-file-loop\"]\n"
+                             "\n"
+                             "- lines_file = ?[str]\n"
+                             "- chunks_file = ?[str]\n"
+                             "- text = ?[str]\n"
+                             "- lines = >> [array]\n"
+                             "- chunks = >> [array]\n"
+                             "- parts = >> [array]\n"
+                             "\n"
+                             "for(line : lines_file.file_lines()) {\n"
+                             "    test1(\"line\")\n"
+                             "    ->count:\n"
+                             "       - input = lines.append(line)\n"
+                             "       - output >> lines\n"
+                             "}\n"
+                             "\n"
+                             "for(chunk : chunks_file.file_chunks(4)) {\n"
+                             "    test1(\"chunk\")\n"
+                             "    ->count:\n"
+                             "       - input = chunks.append(chunk)\n"
+                             "       - output >> chunks\n"
+                             "}\n"
+                             "\n"
+                             "for(part : text.split(\",\")) {\n"
+                             "    test1(\"part\")\n"
+                             "    ->count:\n"
+                             "       - input = parts.append(part)\n"
+                             "       - output >> parts\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestMissingOutputTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestMissingOutputTree()
+{
+    const std::string tree = "[\"test-missing-output\"]\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "- test_output = >> [int]\n"
+                             "\n"
+                             "test1(\"missing\")\n"
+                             "->count:\n"
+                             "   - input = input\n"
+                             "   - missing >> test_output\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestBatchTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestBatchTree()
+{
+    const std::string tree = "[\"test-batch\"]\n"
+                             "\n"
+                             "- values = ?[array]\n"
+                             "- last = >> [int]\n"
+                             "\n"
+                             "for(x : values) {\n"
+                             "    test1(\"batch\")\n"
+                             "    ->batch:\n"
+                             "       - input = x\n"
+                             "       - output >> last\n"
+                             "}\n"
+                             "\n"
+                             "for(x : values) {\n"
+                             "    test1(\"no batch\")\n"
+                             "    ->batch:\n"
+                             "       - input = last\n"
+                             "       - output >> last\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestAsyncTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestAsyncTree()
+{
+    const std::string tree = "[\"test-async\"]\n"
+                             "\n"
+                             "- values = ?[array]\n"
+                             "- fail = ?[bool]\n"
+                             "\n"
+                             "parallel_for(x : values) {\n"
+                             "    test1(\"async\")\n"
+                             "    ->async:\n"
+                             "       - input = x\n"
+                             "       - sleep = 50\n"
+                             "       - fail = fail\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestAsyncChildTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestAsyncChildTree()
+{
+    const std::string tree = "[\"async-child\"]\n"
+                             "\n"
+                             "- input = ?[int]\n"
+                             "\n"
+                             "test1(\"async\")\n"
+                             "->async:\n"
+                             "   - input = input\n"
+                             "   - sleep = 50\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestAsyncCachedTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestAsyncCachedTree(const std::string &id,
+                                       const std::string &cacheOption)
+{
+    const std::string tree = "[\"" + id + "\"]\n"
+                             "\n"
+                             "- values = ?[array]\n"
+                             "\n"
+                             "parallel_for(x : values) {\n"
+                             "    subtree<" + cacheOption + ">(\"async-child\")\n"
+                             "    - input = x\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestLimitTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestLimitTree()
+{
+    const std::string tree = "[\"test-limit\"]\n"
+                             "\n"
+                             "- values = ?[array]\n"
+                             "\n"
+                             "parallel_for<8>(x : values) {\n"
+                             "    test1(\"limited\")\n"
+                             "    ->limited_count:\n"
+                             "       - input = x\n"
+                             "       - sleep = 20\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestWindowTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestWindowTree()
+{
+    const std::string tree = "[\"test-window\"]\n"
+                             "\n"
+                             "- values = ?[array]\n"
+                             "\n"
+                             "parallel_for<3>(x : values) {\n"
+                             "    test1(\"window\")\n"
+                             "    ->async:\n"
+                             "       - input = x\n"
+                             "       - sleep = 20\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestWorkerTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestWorkerTree()
+{
+    const std::string tree = "[\"test-worker\"]\n"
+                             "\n"
+                             "- values = ?[array]\n"
+                             "\n"
+                             "parallel_for(x : values) {\n"
+                             "    test1(\"worker\")\n"
+                             "    ->worker:\n"
+                             "       - input = x\n"
+                             "       - sleep = 10\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestParallelTemplateTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestParallelTemplateTree(const uint32_t numberOfParts)
+{
+    std::string tree = "[\"test-parallel-template\"]\n"
+                       "\n"
+                       "- name = ?[str]\n";
+    for(uint32_t i = 0; i < numberOfParts; i++) {
+        tree += "- out_" + std::to_string(i) + " = >> [str]\n";
+    }
+
+    tree += "\n"
+            "parallel() {\n";
+    for(uint32_t i = 0; i < numberOfParts; i++)
+    {
+        const std::string number = std::to_string(i);
+        tree += "    test1(\"{{ name }}-group-" + number + "\")\n"
+                "    ->count:\n"
+                "       - input = \"{{ name }}-" + number + "\"\n"
+                "       - output >> out_" + number + "\n";
+    }
+    tree += "}\n"
+            "\n"
+            "parallel_for(i = 0; i < 32; i++) {\n"
+            "    test1(\"{{ name }}-loop-{{ i }}\")\n"
+            "    ->count:\n"
+            "       - input = \"{{ name }}-{{ i }}\"\n"
+            "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getTestExpressionTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestExpressionTree(const std::string &id,
+                                      const ExpressionList &expressions,
+                                      const DataMap &inputValues)
+{
+    std::string tree = "[\"" + id + "\"]\n"
+                       "\n";
+
+    // declare the input-values with the type of the given values
+    const std::vector<std::string> keys = inputValues.getKeys();
+    for(const std::string &key : keys)
+    {
+        DataItem* value = inputValues.get(key);
+        std::string type = "[str]";
+        if(value->isArray()) {
+            type = "[array]";
+        } else if(value->isMap()) {
+            type = "[map]";
+        } else if(value->isIntValue()) {
+            type = "[int]";
+        } else if(value->isFloatValue()) {
+            type = "[float]";
+        } else if(value->isBoolValue()) {
+            type = "[bool]";
+        }
+        tree += "- " + key + " = ?" + type + "\n";
+    }
+    for(uint32_t i = 0; i < expressions.size(); i++) {
+        tree += "- out_" + std::to_string(i) + " = >> " + expressions.at(i).first + "\n";
+    }
+
+    // write the result of each expression into its own output
+    for(uint32_t i = 0; i < expressions.size(); i++)
+    {
+        const std::string number = std::to_string(i);
+        tree += "\n"
+                "test1(\"expression " + number + "\")\n"
+                "->count:\n"
+                "   - input = " + expressions.at(i).second + "\n"
+                "   - output >> out_" + number + "\n";
+    }
+
+    return tree;
+}
+
+/**
+ * @brief process expressions within a new tree and get their results
+ *
+ * @param result reference for the results of the expressions, which are named out_<position>
+ * @param expressions list of expressions together with the type of their results
+ * @param inputValues values, which can be used within the expressions
+ *
+ * @return false, if the tree is invalid or failed, else true
+ */
+bool
+Interface_Test::processExpressions(DataMap &result,
+                                   const ExpressionList &expressions,
+                                   const DataMap &inputValues)
+{
+    ErrorContainer error;
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    DataMap context;
+    BlossomStatus status;
+    result.clear();
+
+    const std::string id = "test-expression-" + std::to_string(m_numberOfExpressionTrees);
+    m_numberOfExpressionTrees++;
+    const std::string tree = getTestExpressionTree(id, expressions, inputValues);
+    if(interface->addTree(id, tree, error) == false) {
+        return false;
+    }
+
+    return interface->triggerTree(result, id, context, inputValues, status, error);
+}
+
 /**
  * @brief Interface_Test::getTestTemplate
  * @return
@@ -455,5 +2388,21 @@ Interface_Test::getTestFile()
     return buffer;
 }
 
+/**
+ * @brief Interface_Test::getTestTextFile
+ * @return
+ */
+DataBuffer*
+Interface_Test::getTestTextFile(const std::string &text)
+{
+    DataBuffer* buffer = new DataBuffer();
+
+    for(char character : text) {
+        addObject_DataBuffer(*buffer, &character);
+    }
+
+    return buffer;
+}
+
 } // namespace Sakura
 } // namespace Kitsunemimi
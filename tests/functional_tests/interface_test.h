@@ -24,9 +24,11 @@
 #define SESSION_TEST_H
 
 #include <iostream>
-
+#include <vector>
 
 #include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+#include <libKitsunemimiCommon/items/data_items.h>
+#include <counting_blossom.h>
 
 namespace Kitsunemimi
 {
@@ -38,10 +40,30 @@ class Interface_Test
         : public Kitsunemimi::CompareTestHelper
 {
 public:
+    // pairs of the type of the result and the expression itself
+    typedef std::vector<std::pair<std::string, std::string>> ExpressionList;
+
     Interface_Test();
 
     void blossomMethods_test();
     void addAndGet_test();
+    void linkTrees_test();
+    void specializeTree_test();
+    void conditions_test();
+    void valueFunctions_test();
+    void collectionFunctions_test();
+    void splitAndContains_test();
+    void containsIndex_test();
+    void typedArrayFunctions_test();
+    void fileFunctions_test();
+    void jsonFunctions_test();
+    void loops_test();
+    void blossomOutputs_test();
+    void parallelTemplates_test();
+    void asyncBlossoms_test();
+    void concurrencyLimits_test();
+    void resultCache_test();
+    void workerBlossoms_test();
     void runAndTriggerTree_test();
     void runAndTriggerBlossom_test();
 
@@ -53,9 +75,38 @@ public:
 
 private:
     const std::string getTestTree();
+    const std::string getTestCachedTree();
+    const std::string getTestParentTree();
+    const std::string getTestCachedSubtreeTree();
+    const std::string getTestCountTree();
+    const std::string getTestIncrementalTree();
+    const std::string getTestConditionTree();
+    const std::string getTestFunctionTree(const std::string &functionName);
+    const std::string getTestCollectionTree();
     const std::string getTestTemplate();
+    const std::string getTestLoopTree();
+    const std::string getTestMissingOutputTree();
+    const std::string getTestBatchTree();
+    const std::string getTestAsyncTree();
+    const std::string getTestAsyncChildTree();
+    const std::string getTestAsyncCachedTree(const std::string &id,
+                                             const std::string &cacheOption);
+    const std::string getTestLimitTree();
+    const std::string getTestWindowTree();
+    const std::string getTestWorkerTree();
+    const std::string getTestParallelTemplateTree(const uint32_t numberOfParts);
+    const std::string getTestIndexTree();
+    const std::string getTestFileLoopTree();
+    const std::string getTestExpressionTree(const std::string &id,
+                                            const ExpressionList &expressions,
+                                            const DataMap &inputValues);
+
+    bool processExpressions(DataMap &result,
+                            const ExpressionList &expressions,
+                            const DataMap &inputValues);
 
     DataBuffer* getTestFile();
+    DataBuffer* getTestTextFile(const std::string &text);
     const std::string getExpectedError();
 
     void positive_BlossomTest();
@@ -64,6 +115,10 @@ private:
     void invalidInputType_BlossomTest();
     void failWithin_BlossomTest();
     void outofBorder_BlossomTest();
+
+    BlossomCounter m_counter;
+    BlossomCounter m_workerCounter;
+    uint32_t m_numberOfExpressionTrees = 0;
 };
 
 } // namespace Sakura